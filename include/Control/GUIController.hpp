@@ -168,6 +168,10 @@ namespace OMVIS
             double getVisTime();
             /*! \brief Returns the real time factor for the current visualization. */
             double getRealTimeFactor();
+            /*! \brief Returns the lag of the simulation behind the target real time factor in seconds. */
+            double getLag();
+            /*! \brief Returns the number of frames that have been dropped, because the simulation could not keep up. */
+            size_t getNumDroppedFrames();
             /*! \brief Returns the simulation start time of the loaded model. */
             double getSimulationStartTime() const;
             /*! \brief Returns the visualization step size in milliseconds. */
@@ -179,6 +183,7 @@ namespace OMVIS
             bool visTypeIsFMURemote() const;
             bool visTypeIsMAT() const;
             bool visTypeIsMATRemote() const;
+            bool visTypeIsCSV() const;
 
             /*! \brief Returns name of the model. */
             std::string getModelFile() const;
@@ -213,6 +218,21 @@ namespace OMVIS
 
             Model::UserSimSettingsFMU getCurrentSimSettings() const;
 
+            Model::UserSimSettingsMAT getCurrentSimSettingsMAT() const;
+
+            /*! \brief Starts to record the FMU simulation to a MAT result file.
+             *
+             * \param fileName        Name of the result file including path. It has to end with _res.mat.
+             * \param withOutputs     True, if the real outputs of the FMU are recorded as well.
+             */
+            void startRecording(const std::string& fileName, const bool withOutputs);
+
+            /*! \brief Stops the recording and closes the result file. */
+            void stopRecording();
+
+            /*! \brief Returns true, if the FMU simulation is recorded to a MAT result file. */
+            bool isRecording() const;
+
          private:
             /*! \brief This is a helper method for the two \ref loadModel() methods. */
             void loadModelHelper(const Initialization::VisualizationConstructionPlan* cP, const int timeSliderStart,
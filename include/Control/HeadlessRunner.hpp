@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Control
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_HEADLESSRUNNER_HPP_
+#define INCLUDE_HEADLESSRUNNER_HPP_
+
+#include "Initialization/CommandLineArgs.hpp"
+#include "Model/VisualizerAbstract.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /*! \brief Runs a visualization without window and rendering and reports its throughput.
+         *
+         * The visualizer is created from the command line arguments like in the GUI. The scene graph is built and
+         * updated, but never rendered. The scene updates are performed back to back, FMUs are simulated without pacing.
+         * Thus, the throughput of the model and of the update pipeline can be measured on systems without display.
+         * The report lists the wall clock time per phase of the scene updates, see \ref Model::FrameTimings.
+         */
+        class HeadlessRunner
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            HeadlessRunner() = delete;
+
+            explicit HeadlessRunner(const Initialization::CommandLineArgs& clArgs);
+
+            ~HeadlessRunner() = default;
+
+            HeadlessRunner(const HeadlessRunner& rhs) = delete;
+
+            HeadlessRunner& operator=(const HeadlessRunner& rhs) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Loads the model, updates the scene for the given number of frames or up to the end time and
+             *         prints the report.
+             *
+             * \throws std::runtime_error If the model cannot be loaded or the visualization stalls.
+             */
+            void run();
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Creates and initializes the visualizer for the local or remote model. */
+            void loadModel();
+
+            /*! \brief Prints the throughput of the run. The solver steps are only reported for FMUs. */
+            void printReport(const double loadTime, const double runTime, const size_t numFrames,
+                             const size_t numSolverSteps, const double startTime) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            const Initialization::CommandLineArgs _clArgs;
+            std::shared_ptr<Model::VisualizerAbstract> _visualizer;
+        };
+
+    }  // namespace Control
+}  // namespace OMVIS
+
+#endif /* INCLUDE_HEADLESSRUNNER_HPP_ */
+/**
+ * \}
+ */
@@ -32,6 +32,8 @@
 #include <SDL_events.h>
 #include <SDL_joystick.h>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 
@@ -42,6 +44,8 @@ namespace OMVIS
 
         /*! \brief Class that serves as controller for input from joystick.
          *
+         * The SDL events are handled by the \ref JoystickInputThread, which publishes the latest axis and button values
+         * of the joystick via atomics. The simulation loop only reads a snapshot of these values.
          */
         class JoystickDevice
         {
@@ -69,7 +73,24 @@ namespace OMVIS
              * SIMULATION METHODS
              *---------------------------------------*/
 
-            void detectContinuousInputEvents(std::shared_ptr<Model::InputData>& inputInfo);
+            /*! \brief Stores the axis or button value of the given event, if it belongs to this joystick.
+             *
+             * \remark Called by the input thread.
+             * \return True, if the event has been consumed.
+             */
+            bool handleEvent(const SDL_Event& event);
+
+            /*! \brief Writes the current axis values to the given input data, if they changed since the last call.
+             *
+             * \remark Called by the simulation thread.
+             */
+            void applyInputs(std::shared_ptr<Model::InputData>& inputInfo);
+
+            /*! \brief Forgets the axis values written to the input data, e.g., because the input data has been reset.
+             *
+             * The next call of \ref applyInputs writes the current axis values.
+             */
+            void invalidateAppliedInputs();
 
             /*-----------------------------------------
              * GETTERS AND SETTERS
@@ -78,12 +99,21 @@ namespace OMVIS
             int getXDir() const;
             int getYDir() const;
 
+            /// Returns true, if the button with the given index is currently pressed.
+            bool isButtonPressed(const int button) const;
+
          private:
             /// Memory is allocated and freed within SDL library. Just call the appropriate methods.
             SDL_Joystick* _joystick;
-            SDL_Event _inputEvent;
-            int _xDir;
-            int _yDir;
+            /// SDL instance ID of the opened joystick, which identifies it in the events.
+            SDL_JoystickID _instanceId;
+            std::atomic<int> _xDir;
+            std::atomic<int> _yDir;
+            /// Bit i is set, if button i is pressed.
+            std::atomic<std::uint32_t> _buttons;
+            /// Axis values last written to the input data. Only accessed by the simulation thread.
+            int _appliedXDir;
+            int _appliedYDir;
             int _joystickId;
         };
 
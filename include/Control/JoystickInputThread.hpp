@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Control
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_JOYSTICKINPUTTHREAD_HPP_
+#define INCLUDE_JOYSTICKINPUTTHREAD_HPP_
+
+#include "Control/JoystickDevice.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /*! \brief Thread that drains the SDL event queue and dispatches the joystick events.
+         *
+         * Each event is passed to the joystick it belongs to, which publishes the new axis or button value. Thus, the
+         * simulation loop does not poll SDL itself and no event of one joystick is lost while another is polled.
+         */
+        class JoystickInputThread
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            JoystickInputThread();
+
+            /// Destructor stops the thread.
+            ~JoystickInputThread();
+
+            /// The copy constructor is forbidden.
+            JoystickInputThread(const JoystickInputThread& jit) = delete;
+
+            /// The assignment operator is forbidden.
+            JoystickInputThread& operator=(const JoystickInputThread& jit) = delete;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Starts the thread for the given joysticks. A running thread is stopped before.
+             *
+             * \remark The joysticks have to outlive the thread. SDL has to be initialized before.
+             */
+            void start(const std::vector<JoystickDevice*>& joysticks);
+
+            /*! \brief Stops the thread and waits for it. */
+            void stop();
+
+            /*-----------------------------------------
+             * GETTERS AND SETTERS
+             *---------------------------------------*/
+
+            bool isRunning() const;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Main loop of the input thread. */
+            void run();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::vector<JoystickDevice*> _joysticks;
+            std::thread _inputThread;
+            std::atomic<bool> _isRunning;
+        };
+
+    }  // namespace Control
+}  // namespace OMVIS
+
+#endif /* INCLUDE_JOYSTICKINPUTTHREAD_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Control
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_PACINGGOVERNOR_HPP_
+#define INCLUDE_PACINGGOVERNOR_HPP_
+
+#include <cstddef>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /*! \brief Locks the simulation time of an interactive simulation to the wall clock time.
+         *
+         * Since the governor has been anchored, the simulation time advances by the elapsed wall clock time multiplied
+         * with the target real-time factor. Thus, a real-time factor less than one is a slow motion and a real-time
+         * factor greater than one is a fast-forward.
+         *
+         * The next frame is due as soon as the wall clock reaches the simulation time of the previous frame. It is
+         * planned up to the simulation time the wall clock reaches one frame interval later. Hence, the number of
+         * solver steps per frame follows from the real-time factor. Moreover, the frame is limited to the simulation
+         * time the solver managed within one frame interval in the previous frames. If the simulation cannot keep up,
+         * it lags behind the wall clock. As soon as the lag exceeds the maximum lag, the governor stops catching up:
+         * It is anchored at the current simulation time again and the skipped frames are counted as dropped.
+         *
+         * All times are given in seconds. The wall clock times are passed in, thus, any monotonic clock can be used.
+         */
+        class PacingGovernor
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Constructs a governor for real-time, i.e., a target real-time factor of 1. */
+            PacingGovernor();
+
+            ~PacingGovernor() = default;
+
+            PacingGovernor(const PacingGovernor& rhs) = delete;
+
+            PacingGovernor& operator=(const PacingGovernor& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Anchors the given simulation time at the given wall clock time.
+             *
+             * The lag is cleared, the estimated costs of the solver and the number of dropped frames are kept.
+             */
+            void reset(const double simTime, const double wallTime);
+
+            /*-----------------------------------------
+             * GETTERS and SETTERS
+             *---------------------------------------*/
+
+            double getTargetRealTimeFactor() const;
+
+            /*! \brief Sets the target real-time factor. It has to be greater than zero.
+             *
+             * \remark The governor has to be anchored again by \ref reset.
+             */
+            void setTargetRealTimeFactor(const double rtf);
+
+            /*! \brief Returns the wall clock time the simulation may lag behind before frames are dropped. */
+            double getMaxLag() const;
+
+            void setMaxLag(const double maxLag);
+
+            /*! \brief Returns the wall clock time the simulation lagged behind when the last frame was planned. */
+            double getLag() const;
+
+            /*! \brief Returns the number of frames that have been dropped, because the simulation could not keep up. */
+            size_t getNumDroppedFrames() const;
+
+            /*! \brief Returns the estimated wall clock time per simulated second or 0, if no frame has been finished. */
+            double getCost() const;
+
+            /*! \brief Returns the simulation time that corresponds to the given wall clock time. */
+            double getDueSimTime(const double wallTime) const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Plans the next frame.
+             *
+             * \param simTime         The simulation time of the previous frame.
+             * \param wallTime        The current wall clock time.
+             * \param frameInterval   The wall clock time between two frames.
+             * \return The simulation time the next frame has to reach. If the previous frame is not yet due, simTime
+             *         is returned.
+             */
+            double planFrame(const double simTime, const double wallTime, const double frameInterval);
+
+            /*! \brief Updates the estimated costs of the solver by the given frame.
+             *
+             * \param simSpan     The simulated time of the frame.
+             * \param duration    The wall clock time the simulation of the frame took.
+             */
+            void finishFrame(const double simSpan, const double duration);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            double _targetRealTimeFactor;
+            double _maxLag;
+            /// The simulation time that has been anchored at the wall clock time.
+            double _anchorSimTime;
+            double _anchorWallTime;
+            double _lag;
+            /// Exponential moving average of the wall clock time per simulated second.
+            double _cost;
+            size_t _numDroppedFrames;
+        };
+
+    }  // namespace Control
+}  // namespace OMVIS
+
+#endif /* INCLUDE_PACINGGOVERNOR_HPP_ */
+/**
+ * \}
+ */
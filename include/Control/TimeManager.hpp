@@ -29,6 +29,8 @@
 
 #include <osg/Timer>
 
+#include <cstddef>
+
 namespace OMVIS
 {
     namespace Control
@@ -130,6 +132,16 @@ namespace OMVIS
             /*! \brief Sets the real time factor to the given value. */
             void setRealTimeFactor(const double rtf);
 
+            /*! \brief Returns the wall clock time in seconds the simulation lags behind the target real time factor. */
+            double getLag() const;
+
+            void setLag(const double lag);
+
+            /*! \brief Returns the number of frames that have been dropped, because the simulation could not keep up. */
+            size_t getNumDroppedFrames() const;
+
+            void setNumDroppedFrames(const size_t numDroppedFrames);
+
             /*! \brief Returns true, if the visualization is currently paused and false otherwise. */
             bool isPaused() const;
             /*! \brief Sets pause status to new value. */
@@ -146,6 +158,10 @@ namespace OMVIS
             double _realTime;
             //! Real time factor.
             double _realTimeFactor;
+            //! Lag of the simulation behind the target real time factor in seconds.
+            double _lag;
+            //! Number of frames that have been dropped.
+            size_t _numDroppedFrames;
             //! Time of current scene update.
             double _visTime;
             //! Step size for the scene updates in milliseconds.
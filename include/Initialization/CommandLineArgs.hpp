@@ -112,6 +112,12 @@ namespace OMVIS
             std::string modelFile;
             std::string modelPath;
             std::string wDir;
+            /// Number of FMU instances simulated as an ensemble.
+            int ensembleSize;
+            /// Run the visualization without window and rendering and report its throughput.
+            bool headless;
+            /// Number of frames of a headless run. Zero runs up to the end time.
+            int numFrames;
             Util::LogSettings logSet;
         };
 
@@ -121,6 +127,9 @@ namespace OMVIS
          *      --help                          Prints help message.
          *      --model=/PATH/TO/MODELNAME      Path (absolute or relative) to the model which should be visualized.
          *      --useFMU                        OMVIS uses a FMU if specified for visualization.
+         *      --ensemble=N                    Simulates N instances of the FMU with perturbed initial states.
+         *      --headless                      Runs the visualization without rendering and reports timings.
+         *      --frames=N                      Number of frames of a headless run.
          *      --loggersettings="loader=warning"
          *
          * \param argc
@@ -85,6 +85,8 @@ namespace OMVIS
             std::string modelFile;
             /*! Path to the model file, e.g., /home/user/models/ . */
             std::string path;
+            /*! Number of FMU instances simulated as an ensemble. Only used for FMU visualization. */
+            size_t ensembleSize;
         };
 
         /*! \brief This class represents a construction plan for a remote visualization of a simulation.
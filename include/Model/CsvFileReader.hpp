@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+
+#ifndef INCLUDE_CSVFILEREADER_HPP_
+#define INCLUDE_CSVFILEREADER_HPP_
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Reader for result files in CSV format.
+         *
+         * The first line contains the variable names, each following line the values at one time point. The names
+         * may be quoted. The delimiter is detected from the first line, it is either a comma, a semicolon or a tab.
+         *
+         * The file is memory mapped and never copied. On open, the data lines are split into one chunk per thread and
+         * the rows of the chunks are counted in parallel. Afterwards, only the requested columns are parsed directly
+         * from the mapping into the output buffers, again one chunk per thread.
+         *
+         * \remark Values must not be quoted and must use a point as decimal separator.
+         */
+        class CsvFileReader
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            CsvFileReader();
+
+            ~CsvFileReader() = default;
+
+            CsvFileReader(const CsvFileReader& rhs) = delete;
+
+            CsvFileReader& operator=(const CsvFileReader& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the given CSV file, parses the header line and counts the rows.
+             *
+             * \param fileName  Path to the CSV file.
+             * \throws std::runtime_error If the file cannot be mapped or has no header line or no data.
+             */
+            void open(const std::string& fileName);
+
+            /*! \brief Unmaps the file. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const;
+
+            /*! \brief Returns the index of the column with the given name or -1, if there is no such column. */
+            int findColumn(const std::string& name) const;
+
+            size_t getNumColumns() const;
+
+            /*! \brief Returns the number of data lines, i.e., the number of time points. */
+            size_t getNumRows() const;
+
+            /*! \brief Returns the index of the column named "time" or 0, if there is no such column. */
+            size_t getTimeColumn() const;
+
+            /*! \brief Parses the time column and the given columns of all rows.
+             *
+             * This method does not change the state of the reader. The chunks are parsed in parallel.
+             *
+             * \param columns   Zero based indices of the columns to read.
+             * \param times     Output buffer for the time column of size \ref getNumRows.
+             * \param out       One output buffer of size \ref getNumRows per requested column.
+             * \throws std::runtime_error If a row is too short or contains an invalid number.
+             */
+            void readColumns(const std::vector<size_t>& columns, double* times, const std::vector<float*>& out) const;
+
+            /*! \brief Parses a floating point number starting at p and moves p behind the number.
+             *
+             * Numbers with up to 19 significant digits and a decimal exponent of magnitude up to 22 are converted
+             * exactly with a single multiplication or division. All other numbers, e.g., nan and inf, are converted
+             * by std::strtod.
+             *
+             * \param p     Start of the number. Leading blanks and quotes are skipped.
+             * \param end   End of the line.
+             * \param value The parsed number.
+             * \return False, if there is no number at p.
+             */
+            static bool parseNumber(const char*& p, const char* end, double& value);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief A range of complete lines of the file. */
+            struct Chunk
+            {
+                size_t begin;     ///< Offset of the first line.
+                size_t end;       ///< Offset behind the last line.
+                size_t firstRow;  ///< Row index of the first line.
+                size_t numRows;   ///< Number of non-empty lines.
+            };
+
+            /*! \brief A column to parse and its output buffer. */
+            struct ColumnTarget
+            {
+                size_t column;
+                double* times;  ///< Output buffer, if the column is the time column.
+                float* values;  ///< Output buffer otherwise.
+            };
+
+            /*! \brief Parses the header line and returns the offset of the first data line. */
+            size_t parseHeader();
+
+            /*! \brief Splits the data lines into chunks and counts their rows in parallel. */
+            void splitChunks(const size_t dataOffset);
+
+            /*! \brief Parses the targets of all rows of the chunk. The targets are sorted by column. */
+            void parseChunk(const Chunk& chunk, const std::vector<ColumnTarget>& targets) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The memory mapped file.
+            boost::iostreams::mapped_file_source _file;
+            /// The column delimiter.
+            char _delimiter;
+            /// Names of all columns.
+            std::vector<std::string> _columnNames;
+            /// Maps the column names to their index.
+            std::unordered_map<std::string, size_t> _columnIndices;
+            /// The data lines, split into one chunk per thread.
+            std::vector<Chunk> _chunks;
+            size_t _numRows;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_CSVFILEREADER_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_FMUCACHE_HPP_
+#define INCLUDE_FMUCACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief The parts of the model description of a cached FMU that are needed before it is parsed. */
+        struct FMUManifest
+        {
+            uint32_t fmiVersion;           ///< Value of fmi_version_enu_t.
+            std::string guid;              ///< GUID of the model description. Checked after parsing.
+            std::string modelIdentifier;   ///< Model identifier, i.e., the name of the shared object.
+        };
+
+        /*! \brief Cache of extracted FMUs, which are addressed by the content of the FMU file.
+         *
+         * Each entry is a directory named after the key of the FMU file, see \ref computeKey. It contains the extracted
+         * FMU and a binary manifest, which is written last. Thus, an entry without manifest is incomplete and is
+         * extracted again. Since an entry is never overwritten while it is complete, the shared object of a loaded FMU
+         * is never replaced. The least recently used entries are removed if there are more than the maximum number of
+         * entries.
+         */
+        class FMUCache
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            /*! \brief Constructs a cache in the directory returned by \ref getDefaultDirectory. */
+            FMUCache();
+
+            /*! \brief Constructs a cache in the given directory, which is created if necessary.
+             *
+             * \param directory       The cache directory.
+             * \param maxNumEntries   Maximum number of extracted FMUs that are kept.
+             */
+            FMUCache(const std::string& directory, const size_t maxNumEntries);
+
+            ~FMUCache() = default;
+
+            FMUCache(const FMUCache& rhs) = delete;
+
+            FMUCache& operator=(const FMUCache& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Returns the cache directory in the temporary directory of the system. */
+            static std::string getDefaultDirectory();
+
+            /*! \brief Computes the key of the given FMU file.
+             *
+             * FMUs are ZIP archives. The central directory at the end of the archive contains the CRC-32 and the size
+             * of each file. Thus, it identifies the content and only the central directory is hashed, whereas the
+             * compressed files are not read. If there is no central directory, the whole file is hashed.
+             *
+             * \throws std::runtime_error If the file cannot be read.
+             */
+            static uint64_t computeKey(const std::string& fmuFileName);
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            const std::string& getDirectory() const;
+
+            /*! \brief Returns the directory of the entry including a trailing separator. */
+            std::string getEntryPath(const uint64_t key) const;
+
+            /*! \brief Returns the number of complete entries. */
+            size_t getNumEntries() const;
+
+            /*-----------------------------------------
+             * ENTRIES
+             *---------------------------------------*/
+
+            /*! \brief Reads the manifest of the entry and marks the entry as recently used.
+             *
+             * \return False, if there is no complete entry for the key.
+             */
+            bool lookup(const uint64_t key, FMUManifest& manifest) const;
+
+            /*! \brief Removes an incomplete entry and creates an empty one, which the FMU is extracted to.
+             *
+             * \return The directory of the entry.
+             */
+            std::string beginEntry(const uint64_t key) const;
+
+            /*! \brief Writes the manifest of the extracted FMU and removes the least recently used entries.
+             *
+             * \throws std::runtime_error If the manifest cannot be written.
+             */
+            void commitEntry(const uint64_t key, const FMUManifest& manifest) const;
+
+            /*! \brief Removes the entry, e.g., if it turns out to be corrupt. */
+            void removeEntry(const uint64_t key) const;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            std::string getManifestFileName(const uint64_t key) const;
+
+            /*! \brief Removes the least recently used entries except for the given one. */
+            void evict(const uint64_t key) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::string _directory;
+            size_t _maxNumEntries;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_FMUCACHE_HPP_ */
+/**
+ * \}
+ */
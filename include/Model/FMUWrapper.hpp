@@ -32,6 +32,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 
 /// \todo Can we find a better place for this structs and functions?
@@ -57,8 +58,20 @@ namespace OMVIS
             fmi1_event_info_t _eventInfo;
             fmi1_real_t _tcur;
             fmi1_real_t _hcur;
+            fmi1_real_t _hnext;  ///< Step size proposed by the adaptive solver for the next step.
         } FMUData;
 
+        /*! \brief Checkpoint of a FMU to resume the simulation from.
+         *
+         * FMI 1.0 does not provide access to the complete state of a FMU. Thus, a checkpoint consists of the time and
+         * the continuous states only. Discrete states and internal variables of the FMU are not restored.
+         */
+        struct FMUCheckpoint
+        {
+            fmi1_real_t time;
+            std::vector<fmi1_real_t> states;
+        };
+
         /// MF: \todo Complete this class and remove the structs and free functions.
         /*! \brief This class represents a FMU that can be loaded into OMVIS for visualization.
          *
@@ -89,9 +102,19 @@ namespace OMVIS
              * INITIALIZATION METHODS
              *---------------------------------------*/
 
-            /*! \brief Loads the FMU given by name and path into memory. */
+            /*! \brief Loads the FMU given by name and path into memory.
+             *
+             * The FMU is extracted to the \ref FMUCache. If it has already been extracted, the unzip is skipped.
+             */
             void load(const std::string& modelFile, const std::string& path);
 
+            /*! \brief Loads a further instance of a FMU that has already been extracted to the given path.
+             *
+             * The FMU is not unzipped again, because overwriting the shared object of a loaded FMU may cause a
+             * segmentation fault. Thus, several instances of the same FMU can be loaded side by side.
+             */
+            void loadExtracted(const std::string& path);
+
             /*! \brief Initializes the FMU with the given simulation settings. */
             void initialize(const std::shared_ptr<Model::SimSettingsFMU> simSettings);
 
@@ -108,14 +131,37 @@ namespace OMVIS
             /*! \brief Returns the current simulation time. */
             double getTcur() const;
 
+            /*! \brief Returns the directory the FMU has been extracted to. */
+            const std::string& getExtractionPath() const;
+
             /*! \brief Wraps fmi1_import_set_continuous_states. */
             void setContinuousStates();
 
+            /*! \brief Shifts each continuous state x by offset * max(|x|, 1) and sets the states in the FMU.
+             *
+             * The event indicators are updated to the shifted states. Thus, the shift does not trigger an event.
+             *
+             * \remark The FMU needs to be initialized.
+             */
+            void perturbContinuousStates(const fmi1_real_t offset);
+
+            /*! \brief Stores the current time and continuous states in the checkpoint. */
+            void saveCheckpoint(FMUCheckpoint& checkpoint) const;
+
+            /*! \brief Sets the time and the continuous states of the checkpoint in the FMU.
+             *
+             * The event indicators are updated to the restored states. Thus, the restoration does not trigger an event.
+             */
+            void restoreCheckpoint(const FMUCheckpoint& checkpoint);
+
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
 
             /*! \brief Checks if an event indicator has triggered.
+             *
+             * The event indicators at the current time are compared to the ones at the beginning of the previous step,
+             * which have been stored by \ref locateStateEvent or \ref handleEvents.
              *
              * \return True, if an event indicator has triggered. Otherwise, return false.
              */
@@ -156,10 +202,123 @@ namespace OMVIS
             /*! \brief Performs a step of the Forward Euler algorithm to determine the state values. */
             void doEulerStep();
 
+            /*! \brief Performs a step of the classical Runge-Kutta algorithm of order 4 to determine the state values.
+             *
+             * The step starts at _tcur - _hcur with the derivatives computed by \ref solveSystem. The three further
+             * stages are evaluated by the FMU.
+             */
+            void doRungeKuttaStep();
+
+            /*! \brief Performs a step of the adaptive Dormand-Prince algorithm of order 5(4).
+             *
+             * The step starts at _tcur - _hcur with the derivatives computed by \ref solveSystem. The local error is
+             * estimated by the embedded solution of order 4. If it exceeds the tolerance, the step is repeated with a
+             * smaller step size, thus, _tcur and _hcur are reduced accordingly. Afterwards, the step size for the next
+             * step is proposed in _hnext.
+             *
+             * \param tolerance   Relative and absolute tolerance of the local error.
+             * \throw std::runtime_error, if the tolerance cannot be met with the minimal step size.
+             */
+            void doDormandPrinceStep(const fmi1_real_t tolerance);
+
+            /*! \brief Performs a step of the implicit (backward) Euler algorithm to determine the state values.
+             *
+             * The nonlinear system y - y0 - h * f(t, y) = 0 is solved by a simplified Newton iteration starting at the
+             * Forward Euler solution. The iteration matrix I - h * J is factorized once and reused as long as the step
+             * size does not change and the iteration converges. Only if the iteration does not converge, the Jacobian
+             * J is approximated again, see \ref updateJacobian. If it still does not converge, the step is retried with
+             * half the step size, which shortens the step.
+             *
+             * \param tolerance   Relative and absolute tolerance of the Newton iteration.
+             * \throw std::runtime_error, if the iteration does not converge for the minimal step size.
+             */
+            void doBackwardEulerStep(const fmi1_real_t tolerance);
+
+            /*! \brief Solves the implicit Euler equation for the step from the start states to t1 with step size h.
+             *
+             * The old factorization of the iteration matrix is used first. If the iteration does not converge, the
+             * Jacobian is approximated again with the known sparsity pattern. If it still does not converge, the
+             * pattern is sampled again.
+             *
+             * \return True, if the Newton iteration converged.
+             */
+            bool doBackwardEulerIteration(const fmi1_real_t t1, const fmi1_real_t h, const fmi1_real_t tolerance);
+
+            /*! \brief Locates the first zero crossing of the event indicators inside the last step.
+             *
+             * The event indicators at the end of the step are compared to the ones at its beginning, which have been
+             * gathered by \ref prepareSimulationStep or \ref handleEvents. If an indicator changed its sign, the time
+             * of the crossing is searched by the Illinois algorithm. Thereby, the states are interpolated by a cubic
+             * Hermite polynomial between the beginning and the end of the step. Afterwards, the step ends right behind
+             * the crossing, i.e., _tcur, _hcur and the states are reduced accordingly. Thus, the event is detected and
+             * handled at the beginning of the next step instead of at the overshot time.
+             *
+             * \remark Must be called after one of the integration steps, because they store the states at the beginning
+             *         of the step.
+             * \return True, if the step has been shortened to an event.
+             */
+            bool locateStateEvent();
+
             /*! \brief Wraps fmi1_import_completed_integrator_step. */
             void completedIntegratorStep(fmi1_boolean_t* callEventUpdate);
 
          private:
+            /*! \brief Defines the callbacks and sets up the context of the FMI library. */
+            void initContext();
+
+            /*! \brief Parses the model description and loads the shared object of the FMU extracted to the path. */
+            void importExtracted(const std::string& path);
+
+            /*! \brief Evaluates a stage of an explicit Runge-Kutta method.
+             *
+             * The states are set to _statesStart + h * sum_j coeffs[j] * k_j, where k_j are the derivatives of the
+             * previous stages, and the derivatives at the given time are stored in stage numStages.
+             *
+             * \param time        The time of the stage.
+             * \param h           The step size.
+             * \param coeffs      The coefficients of the previous stages.
+             * \param numStages   The number of previous stages.
+             */
+            void evaluateStage(const fmi1_real_t time, const fmi1_real_t h, const fmi1_real_t* coeffs,
+                               const size_t numStages);
+
+            /*! \brief Returns the derivatives of the given stage. */
+            fmi1_real_t* getStage(const size_t stage);
+
+            /*! \brief Interpolates the states of the last step by a cubic Hermite polynomial.
+             *
+             * The polynomial matches the states and derivatives at both ends of the step. The derivatives at the end
+             * are expected in the second stage.
+             *
+             * \param theta   Position in the last step from 0 (beginning) to 1 (end).
+             */
+            void interpolateStates(const fmi1_real_t theta, fmi1_real_t* states);
+
+            /*! \brief Sets time and states of the FMU and gets the event indicators. */
+            void evaluateEventIndicators(const fmi1_real_t time, const fmi1_real_t* states, fmi1_real_t* indicators);
+
+            /*! \brief Sets time and states of the FMU and gets the derivatives. */
+            void evaluateDerivatives(const fmi1_real_t time, const fmi1_real_t* states, fmi1_real_t* der);
+
+            /*! \brief Approximates the Jacobian of the derivatives at the given time and the current states.
+             *
+             * The Jacobian is approximated by forward differences, see \ref Util::approximateJacobian. If no sparsity
+             * pattern is known, each state is perturbed on its own and the nonzero entries are taken as pattern.
+             * Otherwise, states that do not influence a common derivative are perturbed at once, see
+             * \ref Util::colorColumns. Thus, the number of evaluations is the number of colors instead of the number
+             * of states.
+             *
+             * \remark Entries that vanish when the pattern is sampled are assumed to be zero until the pattern is
+             *         cleared, see \ref doBackwardEulerIteration.
+             */
+            void updateJacobian(const fmi1_real_t time);
+
+            /*! \brief Factorizes the iteration matrix I - h * J of the implicit Euler method.
+             *
+             * \return False, if the iteration matrix is singular.
+             */
+            bool factorizeIterationMatrix(const fmi1_real_t h);
+
             /*-----------------------------------------
              * MEMBERS
              *---------------------------------------*/
@@ -171,6 +330,32 @@ namespace OMVIS
 
             /*! The encapsulated FMU data. */
             FMUData _fmuData;
+
+            /*! The states at the beginning of a Runge-Kutta step. */
+            std::vector<fmi1_real_t> _statesStart;
+            /*! The derivatives of all stages of a Runge-Kutta step. Stage i starts at index i * _nStates. */
+            std::vector<fmi1_real_t> _stages;
+            /*! Newton corrections of the implicit Euler method and interpolated states of the event localization. */
+            std::vector<fmi1_real_t> _statesTmp;
+            /*! Event indicators at the bounds of the bracket of the event localization. */
+            std::vector<fmi1_real_t> _indicatorsLow;
+            std::vector<fmi1_real_t> _indicatorsHigh;
+            std::vector<fmi1_real_t> _indicatorsMid;
+
+            /*! Row-major Jacobian of the derivatives with respect to the states. */
+            std::vector<double> _jacobian;
+            /*! Sparsity pattern of the Jacobian. Empty until the Jacobian has been approximated once. */
+            std::vector<bool> _jacobianPattern;
+            /*! Color of each state for the approximation of the Jacobian. */
+            std::vector<size_t> _jacobianColors;
+            size_t _numJacobianColors;
+            /*! LU factors of the iteration matrix I - h * J and the corresponding pivots. */
+            std::vector<double> _iterationMatrix;
+            std::vector<size_t> _iterationPivots;
+            /*! Step size the iteration matrix has been factorized for. Zero, if there is no valid factorization. */
+            fmi1_real_t _iterationStepSize;
+            /*! Directory the FMU has been extracted to. */
+            std::string _extractionPath;
         };
 
         /*-----------------------------------------
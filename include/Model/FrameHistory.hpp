@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_FRAMEHISTORY_HPP_
+#define INCLUDE_FRAMEHISTORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Bounded history of the rendered frames of an interactive simulation.
+         *
+         * A frame is a time point and the values of the visualization variables at it. The values are stored with the
+         * precision of the shape attributes, i.e., as float. Each frame is encoded by the bitwise XOR of its values
+         * with the values of the previous frame, written as variable length integers. Thus, a value that does not
+         * change takes one byte. Every key frame interval frames, a key frame is encoded without reference. A frame is
+         * decoded starting from the preceding key frame.
+         *
+         * As soon as the encoded frames exceed the maximum size, the oldest frames are removed.
+         */
+        class FrameHistory
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            FrameHistory() = delete;
+
+            /*! \brief Constructs an empty history.
+             *
+             * \param maxNumBytes       Maximum size of the encoded frames in bytes. The latest frame is always kept.
+             * \param keyFrameInterval  Number of frames from one key frame to the next one.
+             */
+            FrameHistory(const size_t maxNumBytes, const size_t keyFrameInterval);
+
+            ~FrameHistory() = default;
+
+            FrameHistory(const FrameHistory& rhs) = delete;
+
+            FrameHistory& operator=(const FrameHistory& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool empty() const;
+
+            size_t getNumFrames() const;
+
+            /*! \brief Returns the size of the encoded frames in bytes. */
+            size_t getNumBytes() const;
+
+            double getFirstTime() const;
+
+            double getLastTime() const;
+
+            /*-----------------------------------------
+             * HISTORY METHODS
+             *---------------------------------------*/
+
+            /*! \brief Removes all frames. */
+            void clear();
+
+            /*! \brief Appends a frame.
+             *
+             * Frames with a time point less than or equal to the one of the latest frame are removed first. If the
+             * number of values changes, the history is cleared.
+             */
+            void push(const double time, const std::vector<double>& values);
+
+            /*! \brief Decodes the last frame with a time point less than or equal to the given time.
+             *
+             * If the time is before the first frame, the first frame is decoded.
+             *
+             * \remark The history must not be empty.
+             * \return The time point of the decoded frame.
+             */
+            double read(const double time, std::vector<double>& values) const;
+
+            /*! \brief Removes all frames after the given time. */
+            void truncate(const double time);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            struct Frame
+            {
+                double time;
+                bool isKeyFrame;
+                std::vector<uint8_t> data;
+            };
+
+            /*! \brief Encodes the values by the XOR with the reference values. The reference is zero, if nullptr. */
+            static void encode(const float* values, const float* reference, const size_t numValues,
+                               std::vector<uint8_t>& data);
+
+            /*! \brief Decodes the values by the XOR with the reference values. The reference is zero, if nullptr. */
+            static void decode(const std::vector<uint8_t>& data, const float* reference, const size_t numValues,
+                               float* values);
+
+            /*! \brief Decodes the frame with the given index starting from the preceding key frame. */
+            void decodeFrame(const size_t idx, std::vector<float>& values, std::vector<float>& tmp) const;
+
+            /*! \brief Removes the oldest frame. The following frame becomes a key frame. */
+            void removeFirstFrame();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            size_t _maxNumBytes;
+            size_t _keyFrameInterval;
+            std::deque<Frame> _frames;
+            size_t _numBytes;
+            size_t _numValues;
+            /// Number of frames since the latest key frame including the latest key frame.
+            size_t _numFramesSinceKeyFrame;
+            /// Decoded values of the latest frame, the reference of the next frame.
+            std::vector<float> _lastValues;
+            /// Buffer to convert the values to float.
+            std::vector<float> _values;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_FRAMEHISTORY_HPP_ */
+/**
+ * \}
+ */
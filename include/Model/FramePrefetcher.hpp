@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_FRAMEPREFETCHER_HPP_
+#define INCLUDE_FRAMEPREFETCHER_HPP_
+
+#include "Model/ResultTimeline.hpp"
+#include "Util/RingBuffer.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief A frame in the ring buffer of the \ref FramePrefetcher. */
+        struct PrefetchedFrame
+        {
+            TimelineFrame frame;
+            unsigned int generation;  ///< Frames of an outdated generation are discarded.
+        };
+
+        /*! \brief Interpolates the upcoming frames of a \ref ResultTimeline in a background thread.
+         *
+         * Starting at a given time, the worker interpolates the frames time, time + step, time + 2 * step, ... into a
+         * lock-free ring buffer until the buffer is full. The visualization pops the frames in the same order. If the
+         * requested frame is not available, e.g., because the user moved the time slider or changed the step size,
+         * the visualization interpolates the frame itself and restarts the prefetcher.
+         *
+         * \remark The timeline must not be modified while the worker is running.
+         */
+        class FramePrefetcher
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            FramePrefetcher() = delete;
+
+            /*! \brief Constructs a prefetcher that buffers up to numFrames frames of the given timeline. */
+            FramePrefetcher(const ResultTimeline& timeline, const size_t numFrames);
+
+            /*! \brief Stops the worker thread. */
+            ~FramePrefetcher();
+
+            FramePrefetcher(const FramePrefetcher& rhs) = delete;
+
+            FramePrefetcher& operator=(const FramePrefetcher& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Stops the worker and prepares the frame buffers for the current layout of the timeline. */
+            void initialize();
+
+            /*! \brief Stops the worker thread. Already prefetched frames are kept. */
+            void stop();
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Discards all prefetched frames and prefetches the frames time, time + step, ...
+             *
+             * The worker thread is started, if it is not running.
+             */
+            void restart(const double time, const double step);
+
+            /*! \brief Takes the prefetched frame for the given time.
+             *
+             * Outdated frames, i.e., frames of a previous restart or for earlier time points, are discarded. If the
+             * requested time does not continue the sequence of the previous requests, e.g., because the user moved the
+             * time slider or changed the step size, the prefetcher is restarted at time + step.
+             *
+             * \param time    The time of the requested frame.
+             * \param step    The step size to the next requested frame.
+             * \param frame   The frame to store the values in.
+             * \return True, if the frame was available.
+             */
+            bool popFrame(const double time, const double step, TimelineFrame& frame);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Main loop of the worker thread. */
+            void run();
+
+            /*! \brief Wakes the worker thread up, if it waits for a free slot, a restart or the stop. */
+            void wakeWorker();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            const ResultTimeline& _timeline;
+            /// Prefetched frames. The worker is the producer, the visualization is the consumer.
+            Util::RingBuffer<PrefetchedFrame> _frames;
+            std::thread _worker;
+            std::atomic<bool> _running;
+            /// The idle worker waits on this condition instead of polling the ring buffer.
+            std::mutex _wakeMutex;
+            std::condition_variable _wakeCondition;
+            /// Incremented by every restart.
+            std::atomic<unsigned int> _generation;
+            /// Time of the first frame and step size of the current generation.
+            std::atomic<double> _startTime;
+            std::atomic<double> _step;
+            /// The time and step size the consumer expects to request next. Only used by the consumer.
+            double _nextTime;
+            double _nextStep;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_FRAMEPREFETCHER_HPP_ */
+/**
+ * \}
+ */
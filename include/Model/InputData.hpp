@@ -34,6 +34,7 @@
 #include <VariableList.hpp>
 
 #include <map>
+#include <mutex>
 
 enum inputKey
 {
@@ -79,8 +80,8 @@ namespace OMVIS
             /*! \brief Let the compiler create the destructor. */
             ~InputData() = default;
 
-            /*! \brief Copy constructor. */
-            InputData(const InputData& ipd) = default;
+            /*! The copy constructor is forbidden. */
+            InputData(const InputData& ipd) = delete;
 
             /*! The assignment operator is forbidden. */
             InputData& operator=(const InputData& ipd) = delete;
@@ -128,9 +129,24 @@ namespace OMVIS
              * GETTERS and SETTERS
              *---------------------------------------*/
 
-            /*! \brief Sets the input variables in the FMU. */
+            /*! \brief Sets the input variables in the FMU.
+             *
+             * Only the values that changed since the last call are written, with one call per type.
+             */
             void setInputsInFMU(fmi1_import_t* fmu);
 
+            /*! \brief Forces the next call of \ref setInputsInFMU to write all values.
+             *
+             * Has to be called if the FMU has been (re)initialized and, thus, lost the written values.
+             */
+            void invalidateInputsInFMU();
+
+            /*! \brief Setters for single input values. The type is marked as changed, if the value differs. */
+            void setRealValue(const size_t idx, const fmi1_real_t value);
+            void setIntegerValue(const size_t idx, const fmi1_integer_t value);
+            void setBooleanValue(const size_t idx, const fmi1_boolean_t value);
+            void setStringValue(const size_t idx, fmi1_string_t value);
+
             /*! \brief Gets the names of the variables and stores them in the given vector varNames.
              *
              * \remark The variable names are added via push_back method at the end of the given vector.
@@ -154,6 +170,13 @@ namespace OMVIS
 
             bool setRealInputValueForInputKey(const inputKey key, const double value);
 
+            /*! \brief Returns the mutex that guards the input values.
+             *
+             * The input values are written by the event handlers on the GUI thread and read by the simulation thread
+             * of \ref VisualizerFMU. Both have to lock this mutex while accessing the values.
+             */
+            std::mutex& getMutex();
+
             /*-----------------------------------------
              * PRINTERS
              *---------------------------------------*/
@@ -172,6 +195,13 @@ namespace OMVIS
             InputValues _inputVals;
             keyMap _keyToInputMap;
             keyboardMap _keyboardToKeyMap;
+            std::mutex _mutex;
+            /// Value references and values of the changed inputs of one type. Reused in every \ref setInputsInFMU.
+            std::vector<fmi1_value_reference_t> _changedVrs;
+            std::vector<fmi1_real_t> _changedReals;
+            std::vector<fmi1_integer_t> _changedIntegers;
+            std::vector<fmi1_boolean_t> _changedBooleans;
+            std::vector<fmi1_string_t> _changedStrings;
         };
 
         /*-----------------------------------------
@@ -74,7 +74,15 @@ namespace OMVIS
                       _numInteger(0),
                       _numBoolean(0),
                       _numString(0),
-                      _attrReal(nullptr)
+                      _attrReal(nullptr),
+                      _isDirtyReal(true),
+                      _isDirtyInteger(true),
+                      _isDirtyBoolean(true),
+                      _isDirtyString(true),
+                      _fmuValuesReal(),
+                      _fmuValuesInteger(),
+                      _fmuValuesBoolean(),
+                      _fmuValuesString()
             {
             }
 
@@ -149,6 +157,17 @@ namespace OMVIS
 
          public:
             AttributesReal* _attrReal;
+
+            /// True, if a value of the type may have changed since the values have been written to the FMU.
+            bool _isDirtyReal;
+            bool _isDirtyInteger;
+            bool _isDirtyBoolean;
+            bool _isDirtyString;
+            /// Values last written to the FMU. Empty, if the FMU has to receive all values.
+            std::vector<fmi1_real_t> _fmuValuesReal;
+            std::vector<fmi1_integer_t> _fmuValuesInteger;
+            std::vector<fmi1_boolean_t> _fmuValuesBoolean;
+            std::vector<std::string> _fmuValuesString;
         };
 
     }  // namespace Model
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATFILEREADER_HPP_
+#define INCLUDE_MATFILEREADER_HPP_
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief A variable of a MAT result file as described by the name and dataInfo matrices. */
+        struct MatVariable
+        {
+            std::string name;
+            bool isParam;  ///< True, if the values are stored in data_1, otherwise they are stored in data_2.
+            int index;     ///< One based index into data_1 or data_2. Negative for negated aliases.
+        };
+
+        /*! \brief Reader for MAT v4 result files as written by OpenModelica.
+         *
+         * The file is memory mapped. On open, only the Aclass, name, dataInfo and data_1 matrices are parsed. The
+         * values of data_2 are decoded on demand, thus, only the pages of the file that belong to the variables that
+         * are actually requested become resident.
+         *
+         * \remark Only little-endian files are supported.
+         */
+        class MatFileReader
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatFileReader();
+
+            ~MatFileReader() = default;
+
+            MatFileReader(const MatFileReader& rhs) = delete;
+
+            MatFileReader& operator=(const MatFileReader& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Maps the given MAT file and parses its header matrices.
+             *
+             * \param fileName  Path to the MAT file.
+             * \throws std::runtime_error If the file cannot be mapped or is not a valid result file.
+             */
+            void open(const std::string& fileName);
+
+            /*! \brief Unmaps the file and releases all decoded columns. */
+            void close();
+
+            /*! \brief Maps the file again in order to pick up time points that have been appended since it was opened.
+             *
+             * The header matrices are not parsed again. Decoded columns are released.
+             *
+             * \return The number of time points that are available now.
+             * \throws std::runtime_error If the file cannot be mapped anymore or the number of variables changed.
+             */
+            size_t refresh();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const;
+
+            /*! \brief Returns the variable with the given name or nullptr, if the file does not contain the variable. */
+            const MatVariable* findVariable(const std::string& name) const;
+
+            /*! \brief Returns all variables of the file. */
+            const std::vector<MatVariable>& getVariables() const;
+
+            /*! \brief Returns the number of variables stored in data_2, i.e., the number of columns. */
+            size_t getNumVariables() const;
+
+            /*! \brief Returns the number of time points stored in data_2. */
+            size_t getNumRows() const;
+
+            /*! \brief Returns false, if the file is still being written, i.e., the size of data_2 is not yet final. */
+            bool isComplete() const;
+
+            /*! \brief Returns the values of the parameters (data_1) at start time. */
+            const std::vector<double>& getParameters() const;
+
+            /*! \brief Returns the first time point stored in data_2. */
+            double getStartTime() const;
+
+            /*! \brief Returns the last time point stored in data_2. */
+            double getStopTime() const;
+
+            /*! \brief Returns the values of the given data_2 column.
+             *
+             * The column is decoded on the first request and cached afterwards.
+             *
+             * \param column    Zero based column index, i.e., the absolute dataInfo index minus one.
+             */
+            const std::vector<double>& getColumn(const size_t column);
+
+            /*! \brief Reads a range of rows of the given data_2 column without caching it.
+             *
+             * This method does not change the state of the reader. Thus, it can be called concurrently for different
+             * columns.
+             *
+             * \param column    Zero based column index.
+             * \param firstRow  First row to read.
+             * \param numRows   Number of rows to read.
+             * \param out       Output buffer of size numRows.
+             */
+            void readColumn(const size_t column, const size_t firstRow, const size_t numRows, double* out) const;
+
+            void readColumn(const size_t column, const size_t firstRow, const size_t numRows, float* out) const;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Header of a matrix in a MAT v4 file. */
+            struct MatrixHeader
+            {
+                int32_t type;
+                int32_t mrows;
+                int32_t ncols;
+                int32_t imagf;
+                int32_t namelen;
+            };
+
+            /*! \brief Reads the matrix header at the given offset and returns its name. The offset is moved to the data. */
+            std::string readMatrixHeader(size_t& offset, MatrixHeader& hdr) const;
+
+            /*! \brief Returns the size of one element of a matrix of the given type in bytes. */
+            size_t getElementSize(const int32_t type) const;
+
+            /*! \brief Reads the element with the given index from a numeric matrix starting at the given offset. */
+            double readElement(const size_t offset, const int32_t type, const size_t index) const;
+
+            void parseNames(const size_t offset, const MatrixHeader& hdr, const bool binTrans);
+
+            void parseDataInfo(const size_t offset, const MatrixHeader& hdr, const bool binTrans);
+
+            void parseData1(const size_t offset, const MatrixHeader& hdr, const bool binTrans);
+
+            void parseData2(const size_t offset, const MatrixHeader& hdr, const bool binTrans);
+
+            template <typename T>
+            void readColumnImpl(const size_t column, const size_t firstRow, const size_t numRows, T* out) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The memory mapped file and its name.
+            boost::iostreams::mapped_file_source _file;
+            std::string _fileName;
+            /// All variables of the file.
+            std::vector<MatVariable> _variables;
+            /// Maps the variable names to their position in \ref _variables.
+            std::unordered_map<std::string, size_t> _variableIndices;
+            /// Values of the parameters at start time.
+            std::vector<double> _params;
+            /// Offset of the header and of the first element of data_2.
+            size_t _data2HeaderOffset;
+            size_t _data2Offset;
+            /// Type of data_2.
+            int32_t _data2Type;
+            /// True, if data_2 is stored time-major (binTrans).
+            bool _data2Transposed;
+            /// Number of columns and rows of data_2.
+            size_t _numVariables;
+            size_t _numRows;
+            /// Number of rows of data_2 according to its header. It is zero while the file is written.
+            size_t _numDeclaredRows;
+            /// Cached columns of data_2. A column is empty until it is requested.
+            std::vector<std::vector<double>> _columns;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATFILEREADER_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATFILESERVER_HPP_
+#define INCLUDE_MATFILESERVER_HPP_
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        class MatFileReader;
+
+        /*! \brief Serves the columns of MAT result files to remote visualizations.
+         *
+         * This is a stand-in for a server on the compute cluster: The result files stay where they have been written
+         * and a \ref RemoteMatFile requests only the columns and time points it visualizes. The protocol is described
+         * at \ref MatStreamRequest. The clients are served one after another.
+         */
+        class MatFileServer
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatFileServer() = delete;
+
+            /*! \brief Constructs a server that listens on the given port.
+             *
+             * \param rootDir   Only files in this directory and its subdirectories are served.
+             * \param port      The port to listen on. If it is 0, a free port is chosen.
+             * \throws std::runtime_error If the port cannot be bound.
+             */
+            MatFileServer(const std::string& rootDir, const unsigned short port);
+
+            ~MatFileServer() = default;
+
+            MatFileServer(const MatFileServer& rhs) = delete;
+
+            MatFileServer& operator=(const MatFileServer& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            /*! \brief Returns the port the server listens on. */
+            unsigned short getPort() const;
+
+            /*-----------------------------------------
+             * SERVER METHODS
+             *---------------------------------------*/
+
+            /*! \brief Accepts and serves clients until \ref stop is called. */
+            void run();
+
+            /*! \brief Stops \ref run after the current client disconnected. Can be called from any thread. */
+            void stop();
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Handles the requests of a connected client until it closes the connection. */
+            void serveClient(boost::asio::ip::tcp::socket& socket);
+
+            /*! \brief Opens the requested file and sends its variables, parameters and time points. */
+            void handleOpen(boost::asio::ip::tcp::socket& socket, MatFileReader& reader);
+
+            /*! \brief Sends the requested range of time points of the requested columns. */
+            void handleRead(boost::asio::ip::tcp::socket& socket, MatFileReader& reader);
+
+            /*! \brief Returns the canonical path of the requested file.
+             *
+             * \throws std::runtime_error If the file does not exist or is not located in the root directory.
+             */
+            std::string resolveFileName(const std::string& fileName) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// Canonical path of the directory that contains the served files.
+            std::string _rootDir;
+            boost::asio::io_service _ioService;
+            boost::asio::ip::tcp::acceptor _acceptor;
+            /// False, as soon as the server has to stop.
+            std::atomic<bool> _isRunning;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATFILESERVER_HPP_ */
+/**
+ * \}
+ */
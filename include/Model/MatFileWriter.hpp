@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATFILEWRITER_HPP_
+#define INCLUDE_MATFILEWRITER_HPP_
+
+#include "Util/RingBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Streaming writer for MAT v4 result files in the layout written by OpenModelica.
+         *
+         * The header matrices are written on open. The rows of data_2 are appended by a writer thread. The producer
+         * copies each row into a block of a lock-free ring buffer, whose blocks are allocated on open. Thus,
+         * \ref writeRow neither allocates nor touches the file. If all blocks are pending, the row is dropped.
+         *
+         * While the file is written, the number of rows in the header of data_2 is zero. \ref MatFileReader takes the
+         * complete rows of such a file, thus, it can follow the file. On close, the final number of rows is set.
+         */
+        class MatFileWriter
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            MatFileWriter();
+
+            /*! \brief Closes the file. */
+            ~MatFileWriter();
+
+            MatFileWriter(const MatFileWriter& rhs) = delete;
+
+            MatFileWriter& operator=(const MatFileWriter& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Creates the file, writes the header matrices and starts the writer thread.
+             *
+             * \param fileName      Path to the MAT file.
+             * \param names         Names of the variables. The first variable has to be the time.
+             * \param rowsPerBlock  Number of rows the writer thread writes at once.
+             * \param numBlocks     Number of blocks that can be pending.
+             * \throws std::runtime_error If the file cannot be created.
+             */
+            void open(const std::string& fileName, const std::vector<std::string>& names,
+                      const size_t rowsPerBlock = 32, const size_t numBlocks = 64);
+
+            /*! \brief Writes the pending rows, sets the final number of rows and closes the file.
+             *
+             * \remark Must not be called concurrently with \ref writeRow.
+             */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const;
+
+            const std::string& getFileName() const;
+
+            size_t getNumVariables() const;
+
+            /*! \brief Returns the number of rows passed to \ref writeRow that have not been dropped. */
+            size_t getNumRows() const;
+
+            size_t getNumDroppedRows() const;
+
+            /*-----------------------------------------
+             * WRITE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Appends a row of values, one per variable.
+             *
+             * \remark Only one thread may write rows.
+             * \return False, if the row has been dropped because the writer thread lags behind.
+             */
+            bool writeRow(const double* values);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            struct Block
+            {
+                size_t numRows;
+                std::vector<double> values;
+            };
+
+            /*! \brief Writes the header of a matrix. */
+            void writeMatrixHeader(const std::string& name, const int32_t type, const int32_t mrows,
+                                   const int32_t ncols);
+
+            /*! \brief Writes the strings as char matrix, one string per column (binTrans) or one string per row. */
+            void writeStrings(const std::string& name, const std::vector<std::string>& strings, const bool binTrans);
+
+            /*! \brief Main loop of the writer thread. */
+            void run();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::string _fileName;
+            std::ofstream _stream;
+            /// Offset of the header of data_2 in the file.
+            std::streamoff _data2HeaderOffset;
+            size_t _numVariables;
+            size_t _rowsPerBlock;
+            size_t _numRows;
+            size_t _numDroppedRows;
+            /// Pending blocks. The producer fills the write slot row by row.
+            std::unique_ptr<Util::RingBuffer<Block>> _blocks;
+            /// The block that is currently filled by the producer or nullptr.
+            Block* _block;
+            std::thread _writerThread;
+            std::atomic<bool> _isWriting;
+            /// Set by the writer thread, if writing to the file failed.
+            std::atomic<bool> _hasFailed;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATFILEWRITER_HPP_ */
+/**
+ * \}
+ */
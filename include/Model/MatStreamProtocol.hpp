@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MATSTREAMPROTOCOL_HPP_
+#define INCLUDE_MATSTREAMPROTOCOL_HPP_
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Requests of the protocol to stream columns of a MAT result file from a \ref MatFileServer.
+         *
+         * Each request starts with its int32 code. Each response starts with an int32 status, which is followed by a
+         * string with the error message if the status is not \ref MatStreamStatus::OK.
+         *
+         * - OPEN [string fileName] -> [uint64 numRows] [uint64 numVariables] numVariables x ([string name]
+         *   [uint8 isParam] [int32 index]) [uint64 numParams] [double params...] [double times...]
+         * - READ [uint64 firstRow] [uint64 numRows] [uint64 numColumns] [uint64 columns...] -> numColumns x
+         *   [float values...]
+         * - CLOSE -> no response, the server closes the connection.
+         *
+         * Strings are sent as uint64 length followed by the characters. All values are sent in the byte order of the
+         * host, thus, only little-endian hosts are supported, which is the same restriction as for \ref MatFileReader.
+         */
+        enum class MatStreamRequest : int32_t
+        {
+            OPEN = 1,
+            READ = 2,
+            CLOSE = 3
+        };
+
+        enum class MatStreamStatus : int32_t
+        {
+            OK = 0,
+            ERROR = 1
+        };
+
+        /*! \brief Blocking read and write operations for the messages of the MAT streaming protocol.
+         *
+         * All methods throw a std::runtime_error (boost::system::system_error) if the connection fails.
+         */
+        namespace MatStream
+        {
+
+            void writeBytes(boost::asio::ip::tcp::socket& socket, const void* data, const size_t size);
+
+            void readBytes(boost::asio::ip::tcp::socket& socket, void* data, const size_t size);
+
+            template <typename T>
+            void write(boost::asio::ip::tcp::socket& socket, const T& value)
+            {
+                writeBytes(socket, &value, sizeof(T));
+            }
+
+            template <typename T>
+            T read(boost::asio::ip::tcp::socket& socket)
+            {
+                T value;
+                readBytes(socket, &value, sizeof(T));
+                return value;
+            }
+
+            void writeString(boost::asio::ip::tcp::socket& socket, const std::string& str);
+
+            /*! \brief Reads a string.
+             *
+             * \throws std::runtime_error If the announced length exceeds the limit for a single string.
+             */
+            std::string readString(boost::asio::ip::tcp::socket& socket);
+
+            /*! \brief Reads the status of a response and throws the error message of the server, if there is one. */
+            void readStatus(boost::asio::ip::tcp::socket& socket);
+
+        }  // namespace MatStream
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MATSTREAMPROTOCOL_HPP_ */
+/**
+ * \}
+ */
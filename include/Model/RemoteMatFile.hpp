@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_REMOTEMATFILE_HPP_
+#define INCLUDE_REMOTEMATFILE_HPP_
+
+#include "Model/MatFileReader.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Client for a MAT result file that is served by a \ref MatFileServer.
+         *
+         * On open, the variables, the parameters and the time points are transferred. The values of the time
+         * dependent variables are requested on demand for a range of time points, thus, only the data that is actually
+         * visualized is transferred.
+         *
+         * \remark The methods must not be called concurrently.
+         */
+        class RemoteMatFile
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            RemoteMatFile();
+
+            /*! \brief Closes the connection. */
+            ~RemoteMatFile();
+
+            RemoteMatFile(const RemoteMatFile& rhs) = delete;
+
+            RemoteMatFile& operator=(const RemoteMatFile& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Connects to the server and opens the given file.
+             *
+             * \param hostAddress   Address of the server.
+             * \param port          Port of the server.
+             * \param fileName      Path to the MAT file on the server.
+             * \throws std::runtime_error If the server cannot be reached or cannot open the file.
+             */
+            void open(const std::string& hostAddress, const int port, const std::string& fileName);
+
+            /*! \brief Closes the file and the connection to the server. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const;
+
+            /*! \brief Returns the variable with the given name or nullptr, if the file does not contain the variable. */
+            const MatVariable* findVariable(const std::string& name) const;
+
+            /*! \brief Returns the number of time points. */
+            size_t getNumRows() const;
+
+            /*! \brief Returns the values of the parameters at start time. */
+            const std::vector<double>& getParameters() const;
+
+            /*! \brief Returns all time points. */
+            const std::vector<double>& getTimes() const;
+
+            /*! \brief Returns the last time point that is less than or equal to the given time. */
+            size_t findRow(const double time) const;
+
+            /*! \brief Reads a range of time points of the given columns from the server.
+             *
+             * \param columns   Zero based data_2 column indices.
+             * \param firstRow  First time point to read.
+             * \param numRows   Number of time points to read.
+             * \param out       Output buffer of size numRows for each column.
+             * \throws std::runtime_error If the server refuses the request or the connection fails.
+             */
+            void readRows(const std::vector<size_t>& columns, const size_t firstRow, const size_t numRows,
+                          const std::vector<float*>& out);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            boost::asio::io_service _ioService;
+            boost::asio::ip::tcp::socket _socket;
+            /// All variables of the file.
+            std::vector<MatVariable> _variables;
+            /// Maps the variable names to their position in \ref _variables.
+            std::unordered_map<std::string, size_t> _variableIndices;
+            /// Values of the parameters at start time.
+            std::vector<double> _params;
+            /// All time points.
+            std::vector<double> _times;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_REMOTEMATFILE_HPP_ */
+/**
+ * \}
+ */
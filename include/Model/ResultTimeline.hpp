@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_RESULTTIMELINE_HPP_
+#define INCLUDE_RESULTTIMELINE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Interpolated values of all columns of a \ref ResultTimeline at one point in time. */
+        struct TimelineFrame
+        {
+            double time;
+            std::vector<double> values;  ///< One value per column.
+            std::vector<double> low;     ///< Scratch buffer for the values at the lower bound of the time bracket.
+            std::vector<double> high;    ///< Scratch buffer for the values at the upper bound of the time bracket.
+        };
+
+        /*! \brief Remembers the time bracket of the last interpolation on a \ref ResultTimeline.
+         *
+         * During playback, the time advances by small steps. Thus, the next bracket is found by walking a few rows
+         * from the last one instead of searching the whole time vector.
+         */
+        struct TimelineCursor
+        {
+            TimelineCursor()
+                    : row(0),
+                      isValid(false)
+            {
+            }
+
+            /*! \brief Forces a binary search on the next interpolation, e.g., after a jump in time. */
+            void reset()
+            {
+                isValid = false;
+            }
+
+            size_t row;    ///< Lower bound of the last time bracket.
+            bool isValid;  ///< False, if the last time bracket is unknown.
+        };
+
+        /*! \brief Column store for the results of the visualization variables.
+         *
+         * The values are stored as structure of arrays in single precision, i.e., all time points of a column are
+         * contiguous in memory. Columns that do not change over time, e.g., parameters, are stored as a single value.
+         * The time points are stored in double precision.
+         */
+        class ResultTimeline
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            ResultTimeline();
+
+            ~ResultTimeline() = default;
+
+            ResultTimeline(const ResultTimeline& rhs) = delete;
+
+            ResultTimeline& operator=(const ResultTimeline& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Allocates the memory for the given number of time points and columns.
+             *
+             * \param numRows       Number of time points.
+             * \param constColumns  For each column, true if the column is constant over time.
+             */
+            void allocate(const size_t numRows, const std::vector<bool>& constColumns);
+
+            /*! \brief Changes the number of time points while keeping the values of the remaining time points.
+             *
+             * The memory of the time dependent columns grows geometrically, thus, appending time points one by one
+             * has amortized constant costs. The values of new time points are undefined.
+             */
+            void resize(const size_t numRows);
+
+            /*! \brief Releases all time points and columns. */
+            void clear();
+
+            /*! \brief Exchanges the time points and columns with the given timeline. */
+            void swap(ResultTimeline& other);
+
+            /*! \brief Removes all time points that can be reproduced by linear interpolation within the tolerance.
+             *
+             * The time points to keep are selected in a single pass by a swing door algorithm: Starting from the last
+             * kept time point, the range of slopes that passes all following time points within the tolerance is
+             * narrowed for each time dependent column. As soon as a time point cannot be reached by a slope in the
+             * range of every column, the previous time point is kept and becomes the new start. Thus, the kept time
+             * points are shared by all columns. The first and last time point as well as both time points of an event
+             * are always kept.
+             *
+             * \param tolerance   Maximum absolute deviation of the interpolated values from the removed values.
+             * \return The number of time points that are kept.
+             */
+            size_t decimate(const double tolerance);
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            size_t getNumColumns() const;
+
+            size_t getNumRows() const;
+
+            double getStartTime() const;
+
+            double getStopTime() const;
+
+            /*! \brief Returns the time points. */
+            double* getTimes();
+
+            const double* getTimes() const;
+
+            /*! \brief Returns the values of the given column. Constant columns have exactly one value. */
+            float* getColumn(const size_t column);
+
+            const float* getColumn(const size_t column) const;
+
+            bool isConstColumn(const size_t column) const;
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Prepares the buffers of the given frame for this timeline. */
+            void initFrame(TimelineFrame& frame) const;
+
+            /*! \brief Interpolates all columns linearly at the given time.
+             *
+             * The time bracket is searched once. If the cursor is valid, the search walks from the bracket of the
+             * previous interpolation. Only if the cursor is invalid or the time moved too far, a binary search is used.
+             * Afterwards, the values at the bracket bounds are gathered into the scratch buffers of the frame and all
+             * columns are interpolated in a single loop, which is vectorized by the compiler.
+             *
+             * \param time    The time to get the values for. It is clamped to the time range of the timeline.
+             * \param frame   The frame to store the values in. It has to be initialized by \ref initFrame.
+             * \param cursor  The cursor of the previous interpolation. It is updated to the new time bracket.
+             */
+            void interpolate(const double time, TimelineFrame& frame, TimelineCursor& cursor) const;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Finds the rows i1 <= i2 enclosing the given time and the interpolation weight of row i2. */
+            void findBracket(const double time, TimelineCursor& cursor, size_t& i1, size_t& i2, double& w) const;
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The time points.
+            std::vector<double> _times;
+            /// The values of all columns.
+            std::vector<float> _values;
+            /// Number of time points the time dependent columns can hold without reallocation.
+            size_t _capacity;
+            /// Offset of the first value of each column in \ref _values.
+            std::vector<size_t> _columnOffsets;
+            /// Row stride per column: 1 for time dependent columns, 0 for constant columns.
+            std::vector<size_t> _columnStrides;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_RESULTTIMELINE_HPP_ */
+/**
+ * \}
+ */
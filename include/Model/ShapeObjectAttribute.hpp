@@ -61,8 +61,9 @@ namespace OMVIS
             //if true, check the exp, if wrong check the cref
             bool isConst;
             float exp;
-            std::string cref; 			///< Only for MAT and CSV (future)
+            std::string cref; 			///< Only for MAT and CSV
             fmi1_value_reference_t fmuValueRef; ///< For (all) FMI versions
+            unsigned int varIdx;        ///< Index into the visualization variable table of \ref VisualBase.
         };
 
     }  // namespace Util
@@ -34,18 +34,25 @@ namespace OMVIS
 
         /*! \brief All available numerical integration algorithms (aka solvers).
          *
+         * The fixed step solvers use the simulation step size for each step. The adaptive solver controls its step
+         * size by an embedded error estimate and uses the simulation step size as maximum step size. The implicit
+         * solver stays stable for large step sizes, thus, it is suited for stiff models.
          */
         enum class Solver
         {
             NONE = 0,
-            EULER_FORWARD = 1
+            EULER_FORWARD = 1,
+            RUNGE_KUTTA_4 = 2,   ///< Classical Runge-Kutta method of order 4.
+            DORMAND_PRINCE = 3,  ///< Adaptive Dormand-Prince method of order 5(4).
+            BACKWARD_EULER = 4   ///< Implicit Euler method for stiff models.
         };
 
         /*! \brief This struct holds the simulation settings the user can chose via the GUI for a FMU.
          *
          * The user can specify the settings of a FMU based simulation via the \ref OMVIS::View::SimSettingDialog. The
          * user can specify the solver that should be used for integration, the simulation step size the simulation end time
-         * and the visualization step size. The later determines the interval to call the sceneUpdate() method.
+         * and the visualization step size. The later determines the interval to call the sceneUpdate() method. The
+         * simulation time is locked to the wall clock time multiplied with the real time factor.
          */
         struct UserSimSettingsFMU
         {
@@ -53,17 +60,24 @@ namespace OMVIS
             double simStepSize;
             double visStepSize;
             double simEndTime;
+            double realTimeFactor;
         };
 
         /*! \brief This struct holds the simulation settings the user can chose via the GUI for a MAT file.
          *
          * The user can specify the settings of a MAT result file based simulation via the \ref OMVIS::View::SimSettingDialog.
          * The user can specifically specify the speedup of the simulation, i.e., a speedup less than one will slow
-         * down the simulation, a speed up greater than one, will speed it up.
+         * down the simulation, a speed up greater than one, will speed it up. Furthermore, the user can request to
+         * bake the shapes into a cache file, which speeds up the replay in this and in later sessions. A decimation
+         * tolerance greater than zero removes all time points that can be interpolated within this tolerance. If the
+         * result file is followed, time points appended by a running simulation are visualized as they arrive.
          */
         struct UserSimSettingsMAT
         {
             double speedup;
+            bool bakeTransforms;
+            double decimationTolerance;
+            bool followFile;
         };
 
     }  // namespace Model
@@ -115,7 +115,7 @@ namespace OMVIS
             fmi1_real_t _tend;
             fmi1_real_t _relativeTolerance;
 
-            /// \todo Implement me. Currently, only the Euler Forward algorithm is implemented.
+            /// The numerical integration algorithm used for FMU based visualization.
             Solver _solver;
         };
 
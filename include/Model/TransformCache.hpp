@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+
+#ifndef INCLUDE_TRANSFORMCACHE_HPP_
+#define INCLUDE_TRANSFORMCACHE_HPP_
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief The baked state of one shape at one time point.
+         *
+         * It contains everything the node updater needs, i.e., the final transformation matrix and the attributes that
+         * change the geometry or the material of the shape.
+         */
+        struct BakedShape
+        {
+            double mat[16];  ///< Row major 4x4 transformation matrix as used by osg::Matrixd.
+            float length;
+            float width;
+            float height;
+            float extra;
+            float color[3];
+            float specCoeff;
+        };
+
+        /*! \brief Binary cache file of the baked shapes of a MAT result file for all of its time points.
+         *
+         * The file consists of a header, the time points and, for each time point, one \ref BakedShape per shape. It is
+         * identified by a key that is computed from the MAT file and the visual XML file. Thus, a cache file becomes
+         * stale as soon as the result or the visualization description changes.
+         *
+         * A cache file is written frame by frame by \ref beginWrite, \ref writeFrame and \ref endWrite. It is read by
+         * memory mapping it, thus, a frame can be copied directly from the mapping into the shapes.
+         */
+        class TransformCache
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            TransformCache();
+
+            ~TransformCache() = default;
+
+            TransformCache(const TransformCache& rhs) = delete;
+
+            TransformCache& operator=(const TransformCache& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Returns the name of the cache file for the given MAT file. */
+            static std::string getCacheFileName(const std::string& matFileName);
+
+            /*! \brief Computes the key of the cache file for the given MAT and visual XML file.
+             *
+             * The XML file is hashed completely. For the potentially huge MAT file, only its size, its modification
+             * time and the first and last MiB are hashed.
+             *
+             * \throws std::runtime_error If one of the files cannot be read.
+             */
+            static uint64_t computeKey(const std::string& matFileName, const std::string& xmlFileName);
+
+            /*! \brief Maps the given cache file.
+             *
+             * \param fileName   Path to the cache file.
+             * \param key        The expected key, see \ref computeKey.
+             * \param numShapes  The expected number of shapes.
+             * \return False, if the file does not exist, is corrupt or does not match the key or the number of shapes.
+             */
+            bool open(const std::string& fileName, const uint64_t key, const size_t numShapes);
+
+            /*! \brief Unmaps the cache file. */
+            void close();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isOpen() const;
+
+            size_t getNumFrames() const;
+
+            size_t getNumShapes() const;
+
+            double getStartTime() const;
+
+            double getStopTime() const;
+
+            /*! \brief Returns the last frame with a time point less than or equal to the given time.
+             *
+             * For events, the time point is stored twice, thus, the frame after the event is selected.
+             */
+            size_t findFrame(const double time) const;
+
+            /*! \brief Returns the baked shapes of the given frame. */
+            const BakedShape* getFrame(const size_t frame) const;
+
+            /*-----------------------------------------
+             * WRITE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Starts writing a new cache file.
+             *
+             * The data is written to a temporary file, which replaces the cache file in \ref endWrite. Thus, an
+             * incomplete cache file is never picked up.
+             *
+             * \throws std::runtime_error If the file cannot be created.
+             */
+            void beginWrite(const std::string& fileName, const uint64_t key, const size_t numShapes,
+                            const std::vector<double>& times);
+
+            /*! \brief Appends the baked shapes of the next frame. */
+            void writeFrame(const BakedShape* shapes);
+
+            /*! \brief Finishes the cache file.
+             *
+             * \throws std::runtime_error If not all frames have been written or writing failed.
+             */
+            void endWrite();
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Header of a cache file. */
+            struct CacheHeader
+            {
+                char magic[8];
+                uint32_t version;
+                uint32_t shapeSize;  ///< sizeof(BakedShape) of the writer.
+                uint64_t numShapes;
+                uint64_t numFrames;
+                uint64_t key;
+            };
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The memory mapped cache file.
+            boost::iostreams::mapped_file_source _file;
+            size_t _numShapes;
+            size_t _numFrames;
+            /// Time points in the mapping.
+            const double* _times;
+            /// Baked shapes in the mapping, frame by frame.
+            const BakedShape* _frames;
+
+            /// The cache file that is currently written and its temporary file.
+            std::string _writeFileName;
+            std::ofstream _writeStream;
+            size_t _numFramesToWrite;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_TRANSFORMCACHE_HPP_ */
+/**
+ * \}
+ */
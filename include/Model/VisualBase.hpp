@@ -33,6 +33,8 @@
 #include <rapidxml.hpp>
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace OMVIS
 {
@@ -81,18 +83,35 @@ namespace OMVIS
             /*! \brief Clears the visual XML file. */
             void clearXMLDoc();
 
-            /*! \brief Gets all visual objects from the visual XML file and fills the vector of ShapeObject. */
+            /*! \brief Gets all visual objects from the visual XML file and fills the vector of ShapeObject.
+             *
+             * The crefs of all non-constant attributes are interned into the visualization variable table. Thus, a
+             * cref that is referenced by several attributes is stored once and each attribute holds the index of its
+             * variable in ShapeObjectAttribute::varIdx.
+             */
             void initVisObjects();
 
+            /*! \brief Removes the variables that cannot be resolved by a visualizer from the variable table.
+             *
+             * The attributes that reference a removed variable are set to a constant value of 0.0. The indices of the
+             * remaining variables are renumbered, but their order is kept.
+             *
+             * \param isMissing   For each variable of the table, true if it has to be removed.
+             */
+            void removeVisVariables(const std::vector<bool>& isMissing);
+
             /*-----------------------------------------
              * GETTERS and SETTERS
              *---------------------------------------*/
 
             /*! \brief Gets all variable names which are needed for the visualization.
+             *
+             * Each name is contained once. The position of a name is the index that is stored in
+             * ShapeObjectAttribute::varIdx of all attributes referencing it.
              *
              * \return Vector of strings containing the variable names.
              */
-            std::vector<std::string> getVisualizationVariables() const;
+            const std::vector<std::string>& getVisualizationVariables() const;
 
             /*! \brief Returns name of the model. */
             const std::string getModelFile() const;
@@ -107,7 +126,11 @@ namespace OMVIS
             const std::string getXMLFileName() const;
 
          private:
-            void appendVisVariable(const rapidxml::xml_node<>* node, std::vector<std::string>& visVariables) const;
+            /*! \brief Adds the cref of the attribute to the variable table, if it is not contained yet, and stores its
+             *         index in the attribute.
+             */
+            void internVisVariable(ShapeObjectAttribute& attr,
+                                   std::unordered_map<std::string, unsigned int>& crefIndices);
 
             /*-----------------------------------------
              * MEMBERS
@@ -119,6 +142,8 @@ namespace OMVIS
             std::string _path;
             /*! The XML file containing the information about the visualization. */
             rapidxml::xml_document<> _xmlDoc;
+            /*! Names of the variables that are referenced by the visualization attributes, each contained once. */
+            std::vector<std::string> _visVariables;
 
          public:
             /// Stores all visualization objects.
@@ -43,6 +43,15 @@ namespace OMVIS
     namespace Model
     {
 
+        /*! \brief Accumulated wall clock times of the phases of the scene updates in seconds. */
+        struct FrameTimings
+        {
+            size_t numUpdates;    ///< Number of scene updates.
+            double fetch;         ///< Getting the values of the frame, e.g., simulating or reading the result file.
+            double transform;     ///< Computing the transformations of the shapes.
+            double sceneUpdate;   ///< Updating the nodes of the scene graph.
+        };
+
         /*! \brief This class serves as abstract basis for data encapsulation of the visualization model.
          *
          * It provides basic methods for visualization.
@@ -112,6 +121,12 @@ namespace OMVIS
 
             std::string getModelFile() const;
 
+            /*! \brief Enables or disables measuring the phases of the scene updates and resets the timings. */
+            void setProfiling(const bool isProfiling);
+
+            /*! \brief Returns the timings measured since profiling has been enabled. */
+            const FrameTimings& getFrameTimings() const;
+
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -139,6 +154,20 @@ namespace OMVIS
             /*! \brief Calls for a scene update. */
             void sceneUpdate();
 
+            /*! \brief Sets the visualization time, e.g., if the user moves the time slider.
+             *
+             * Derived classes can override this method in order to react to jumps in time.
+             *
+             * \param visTime   The new visualization time.
+             */
+            virtual void setVisTime(const double visTime);
+
+            /*! \brief Returns true, if the visualization waits at the end time for further results instead of pausing.
+             *
+             * This is the case if the results are still being computed by another process.
+             */
+            virtual bool waitsAtEndTime() const;
+
          protected:
             /*-----------------------------------------
              * MEMBERS
@@ -150,6 +179,9 @@ namespace OMVIS
             std::shared_ptr<OMVISScene> _viewerStuff;
             std::shared_ptr<UpdateVisitor> _nodeUpdater;
             std::shared_ptr<Control::TimeManager> _timeManager;
+            /// True, if the phases of the scene updates are measured.
+            bool _isProfiling;
+            FrameTimings _frameTimings;
 
             /*-----------------------------------------
              * PROTECTED METHODS
@@ -173,6 +205,12 @@ namespace OMVIS
             /*! \brief Sets up the scene. */
             void setUpScene();
 
+            /*! \brief Returns the wall clock time in seconds, if profiling is enabled, and 0 otherwise.
+             *
+             * Thus, derived classes add the difference of two ticks to \ref _frameTimings without further checks.
+             */
+            double profilingTick() const;
+
             /*! \brief Initializes the scene.
              *
              * This method is implemented either by using FMU or MAT file.
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+
+#ifndef INCLUDE_VISUALIZERCSV_HPP_
+#define INCLUDE_VISUALIZERCSV_HPP_
+
+#include "Model/VisualizerMAT.hpp"
+#include "Model/CsvFileReader.hpp"
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Class that reads results in CSV file format.
+         *
+         * Except for reading the result file, the visualization is the same as for MAT files. Only the columns that
+         * are referenced by the visual XML file are parsed.
+         */
+        class VisualizerCSV : public VisualizerMAT
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            VisualizerCSV() = delete;
+
+            /*! \brief Constructs a VisualizerCSV object from the given arguments.
+             *
+             * Essentially a CSV file and its path need to be specified.
+             *
+             * \param modelFile  Model file name without path.
+             * \param path       Path to the model file.
+             */
+            VisualizerCSV(const std::string& modelFile, const std::string& path);
+
+            virtual ~VisualizerCSV() = default;
+
+            VisualizerCSV(const VisualizerCSV& rhs) = delete;
+
+            VisualizerCSV& operator=(const VisualizerCSV& rhs) = delete;
+
+         protected:
+            /*-----------------------------------------
+             * RESULT FILE METHODS
+             *---------------------------------------*/
+
+            void openResultFile() override;
+
+            void closeResultFile() override;
+
+            /*! \brief CSV files are read completely, thus, the number of time points does not change. */
+            size_t refreshResultFile() override;
+
+            bool isResultFileComplete() const override;
+
+            bool findResultVariable(const std::string& name, MatVariableRef& ref) const override;
+
+            size_t getNumResultRows() const override;
+
+            /*! \brief Parses the time column and the referenced columns directly into \ref _timeline.
+             *
+             * \throws std::logic_error If not all time points are requested, since CSV files are parsed completely.
+             */
+            void readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow) override;
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            CsvFileReader _csvReader;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_VISUALIZERCSV_HPP_ */
+/**
+ * \}
+ */
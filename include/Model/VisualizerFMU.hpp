@@ -30,23 +30,76 @@
 #include "Model/SimSettings.hpp"
 #include "Model/SimSettingsFMU.hpp"
 #include "Model/FMUWrapper.hpp"
+#include "Model/FrameHistory.hpp"
+#include "Model/MatFileWriter.hpp"
 #include "Model/VisualizerAbstract.hpp"
 #include "Model/InputData.hpp"
 #include "Control/JoystickDevice.hpp"
+#include "Control/JoystickInputThread.hpp"
 #include "Control/KeyboardEventHandler.hpp"
+#include "Control/PacingGovernor.hpp"
+#include "Util/RingBuffer.hpp"
+#include "Util/ThreadPool.hpp"
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        /*! \brief Checkpoints of all members of an ensemble at a visualization time. */
+        struct EnsembleCheckpoint
+        {
+            double visTime;                        ///< The visualization time of the frame the checkpoints belong to.
+            std::vector<FMUCheckpoint> members;    ///< Checkpoint of each member.
+        };
+
+        /*! \brief A frame simulated by the simulation thread of \ref VisualizerFMU. */
+        struct FMUFrame
+        {
+            double visTime;                    ///< The visualization time the values belong to.
+            double simTime;                    ///< The simulation time reached by the last solver step.
+            double realTimeFactor;             ///< Simulated time per elapsed wall clock time since the last frame.
+            double lag;                        ///< Wall clock time the simulation lags behind the pacing.
+            size_t numDroppedFrames;           ///< Number of frames dropped by the pacing so far.
+            std::vector<fmi1_real_t> values;   ///< Values of the visualization variables of all members.
+            bool hasCheckpoint;                ///< True, if the frame carries a checkpoint.
+            EnsembleCheckpoint checkpoint;     ///< Checkpoint of the members at the end of the frame.
+        };
+
         /*! \brief This class handles the visualization of FMUs.
          *
          * In contrast to \ref VisualizerMAT, this class provides user interaction via joystick devices to enable
          * steering the model.
          *
+         * The FMU is integrated by a simulation thread, which publishes the values of the visualization variables per
+         * frame through a lock-free ring buffer. The scene update on the GUI thread only consumes these frames. Thus,
+         * slow solver steps do not block the GUI. The simulation thread runs at most \ref s_numFrames frames ahead of
+         * the visualization in order to keep the latency of user inputs low. It owns the FMU while it is running.
+         * Therefore, all methods that access the FMU from the GUI thread stop it first. The frames are paced by a
+         * \ref Control::PacingGovernor, which locks the simulation time to the wall clock time multiplied with the
+         * real time factor chosen by the user.
+         *
+         * The rendered frames are recorded in a bounded \ref FrameHistory. Every \ref s_checkpointInterval seconds, the
+         * simulation thread attaches a checkpoint of the FMU to a frame. Thus, the time slider rewinds to a recorded
+         * frame by reading the history. As soon as the visualization runs again, the FMU is restored from the latest
+         * checkpoint before the frame and simulated up to it, the frames after it are discarded. FMI 1.0 only allows to
+         * restore the continuous states, see \ref FMUCheckpoint.
+         *
+         * Optionally, an ensemble of several instances of the FMU is simulated. The states of member m are shifted by
+         * m times a small perturbation after the initialization. The members are stepped in parallel by a thread pool
+         * and rendered into the same scene, member m is translated by m meters along the x axis and tinted by a color
+         * of its own. Only the first member is steered by the user inputs.
+         *
+         * The simulated frames of the first member can be recorded to a MAT result file, see \ref startRecording. The
+         * simulation thread passes the rows to a \ref MatFileWriter, which writes them to the file in the background.
+         *
          * The end time for FMU visualization is 100. This is set while allocation of the \ref Control::TimeManager object.
          */
         class VisualizerFMU : public VisualizerAbstract
@@ -64,10 +117,12 @@ namespace OMVIS
              *
              * \param modelFile  Model file name without path.
              * \param path       Path to the model file.
+             * \param numMembers Number of FMU instances of the ensemble.
              */
-            VisualizerFMU(const std::string& modelFile, const std::string& path);
+            VisualizerFMU(const std::string& modelFile, const std::string& path, const size_t numMembers = 1);
 
-            virtual ~VisualizerFMU() = default;
+            /*! \brief Stops the simulation thread. */
+            virtual ~VisualizerFMU();
 
             VisualizerFMU(const VisualizerFMU& rhs) = delete;
 
@@ -84,8 +139,43 @@ namespace OMVIS
              */
             void loadFMU(const std::string& modelFile, const std::string& path);
 
+            /*! \brief Sets the simulation settings.
+             *
+             * The simulation thread is stopped and continues with the new settings on the next scene update. Frames that
+             * have already been simulated are still shown. The visualization step size in milliseconds is the frame
+             * interval of the pacing.
+             */
             void setSimulationSettings(const UserSimSettingsFMU& simSetFMU);
 
+            /*! \brief Pauses the visualization and stops the simulation thread.
+             *
+             * The wall clock time keeps running while the visualization is paused. Thus, the pacing is anchored again
+             * when the simulation thread is started by the next scene update.
+             */
+            void pauseVisualization() override;
+
+            /*! \brief Shows the recorded frame at the given visualization time.
+             *
+             * The simulation thread is stopped. The simulation resumes from the shown frame on the next scene update.
+             * Times outside of the frame history are clamped to it.
+             */
+            void setVisTime(const double visTime) override;
+
+            /*! \brief Starts to record the simulated frames of the first member to a MAT result file.
+             *
+             * The variables are the time and the visualization variables. Optionally, the real outputs of the FMU are
+             * recorded as well. The visual XML file is copied next to the result file. Thus, the file can be loaded
+             * by \ref VisualizerMAT. The recording stops, if the visualization is rewound or initialized again.
+             *
+             * \param fileName        Name of the result file including path, e.g., /home/user/modelFoo_rec_res.mat.
+             * \param withOutputs     True, if the real outputs are recorded as well.
+             * \throws std::runtime_error If the result file or the visual XML file cannot be written.
+             */
+            void startRecording(const std::string& fileName, const bool withOutputs = false);
+
+            /*! \brief Writes the pending frames and closes the result file. */
+            void stopRecording();
+
             /*-----------------------------------------
              * GETTERS and SETTERS
              *---------------------------------------*/
@@ -93,10 +183,26 @@ namespace OMVIS
             /*! Returns const. pointer to \ref FMU member. */
             const FMUWrapper* getFMU() const;
 
+            /*! Returns the number of FMU instances of the ensemble. */
+            size_t getNumMembers() const;
+
             std::shared_ptr<InputData> getInputData() const;
 
             UserSimSettingsFMU getCurrentSimSettings() const;
 
+            /*! Returns true, if the simulated frames are recorded to a result file. */
+            bool isRecording() const;
+
+            /*! \brief Enables or disables the pacing by the wall clock time.
+             *
+             * Without pacing, every frame advances the simulation by one visualization step as fast as possible, e.g.,
+             * to measure the throughput of the model.
+             */
+            void setPaced(const bool isPaced);
+
+            /*! Returns the number of solver steps of the first member since the model has been loaded. */
+            size_t getNumSolverSteps() const;
+
          private:
             /*-----------------------------------------
              * MEMBERS
@@ -104,16 +210,69 @@ namespace OMVIS
 
             /*! The encapsulated FMU data. */
             std::shared_ptr<FMUWrapper> _fmu;
+            /// The FMU instances of the ensemble. The first one is \ref _fmu.
+            std::vector<std::shared_ptr<FMUWrapper>> _members;
+            /// Steps the members in parallel. Only allocated for an ensemble of more than one member.
+            std::unique_ptr<Util::ThreadPool> _memberPool;
+            /// Number of shapes of a single member. The shapes of member m follow the ones of member m - 1.
+            size_t _numShapes;
             /*! Simulation settings, e.g., start and end time. */
             std::shared_ptr<SimSettingsFMU> _simSettings;
 
             std::shared_ptr<InputData> _inputData;
 
+            /// Value references of the variables of the visualization variable table.
+            std::vector<fmi1_value_reference_t> _valueRefs;
+            /// Values of the referenced variables of the current frame. Entry m * n + i belongs to entry i of
+            /// \ref _valueRefs for member m, where n is the number of value references.
+            std::vector<fmi1_real_t> _values;
+
+            /// Number of frames the simulation thread may simulate ahead of the visualization.
+            static const size_t s_numFrames = 2;
+            /// Simulated frames. The simulation thread is the producer, the scene update is the consumer.
+            Util::RingBuffer<FMUFrame> _frames;
+            std::thread _simulationThread;
+            std::atomic<bool> _isSimulating;
+            /// Visualization time of the last simulated frame. Only written by the simulation thread while it runs.
+            double _simVisTime;
+            /// Visualization step size and end time of the simulation thread. Only set while it is stopped.
+            double _simHVisual;
+            double _simEndTime;
+            /// Paces the frames of the simulation thread. Only used by the simulation thread while it runs.
+            Control::PacingGovernor _pacing;
+            /// True, if the frames are paced by \ref _pacing. Only set while the simulation thread is stopped.
+            bool _isPaced;
+            /// Solver steps of the first member. Written by the simulation thread, read by the headless report.
+            std::atomic<size_t> _numSolverSteps;
+            /// Visualization time of the next checkpoint. Only used by the simulation thread while it runs.
+            double _simNextCheckpointTime;
+
+            /// Simulated visualization time between two checkpoints.
+            static const double s_checkpointInterval;
+            /// Rendered frames. Only used by the GUI thread.
+            FrameHistory _history;
+            /// Checkpoints of the rendered frames in ascending order. Only used by the GUI thread.
+            std::deque<EnsembleCheckpoint> _checkpoints;
+            /// True, if the shown frame has been read from the history and the simulation has to be resumed from it.
+            bool _isRewound;
+
+            /// Writes the recorded frames. Only used by the simulation thread while it runs.
+            MatFileWriter _recorder;
+            /// True, if the frames are recorded. Only set while the simulation thread is stopped.
+            bool _isRecording;
+            /// Value references of the recorded outputs, which are not visualization variables.
+            std::vector<fmi1_value_reference_t> _recordOutputRefs;
+            /// Row of the recorded frame: time, visualization variables and outputs.
+            std::vector<double> _recordRow;
+
          public:
             /// \todo Remove, we do not need it because we have inputData.
             std::vector<Control::JoystickDevice*> _joysticks;
 
          private:
+            /// Publishes the joystick values, so that the simulation step only reads them.
+            Control::JoystickInputThread _joystickInput;
+
             /*-----------------------------------------
              * PRIVATE METHODS
              *---------------------------------------*/
@@ -124,26 +283,95 @@ namespace OMVIS
 
             void simulate(Control::TimeManager& omvm) override;
 
-            double simulateStep(const double time);
+            /*! \brief Performs a solver step of the given member. Only the first member gets the user inputs. */
+            double simulateStep(FMUWrapper& fmu, const double time);
+
+            /*! \brief Simulates all members from their current time up to the next time and fetches their values.
+             *
+             * \return The simulation time reached by the first member.
+             */
+            double simulateMembers(const double nextTime, std::vector<fmi1_real_t>& values);
 
             /*! \brief This method updates the visualization attributes after a time step has been performed.
              *
-             * The method updates the actual data for the visualization bodies by using variables from the FMU.
+             * The method updates the actual data for the visualization bodies by using the values of the current frame.
              *
              * \param time  The visualization time.
              */
             void updateVisAttributes(const double time) override;
 
-            /*! \brief This method does a scene update, i.e., the FMU is integrated/simulated up to the given time.
+            /*! \brief This method does a scene update, i.e., the next frame simulated by the simulation thread is shown.
              *
-             * For FMU-based visualization, we have to simulate until the next visualization time step. This method is
-             * called by the method \ref VisualizerAbstract::sceneUpdate, which does the time handling (visTime,
-             * simTime) around.
+             * The simulation thread is started, if it is not running. If no frame is available yet, the scene and the
+             * visualization time are kept. This method is called by the method \ref VisualizerAbstract::sceneUpdate,
+             * which does the time handling (visTime, simTime) around.
              *
-             * \remark Parameter time is not used, just inherited from \ref VisualizerAbstract::updateScene(const double).
+             * \param time  The current visualization time.
              */
             void updateScene(const double time = 0.0) override;
 
+            /*! \brief Starts the simulation thread at the visualization time of the last simulated frame. */
+            void startSimulationThread();
+
+            /*! \brief Stops the simulation thread. Frames that have already been simulated are kept. */
+            void stopSimulationThread();
+
+            /*! \brief Discards all simulated frames and prepares the frame buffers for the current variables.
+             *
+             * \remark The simulation thread must be stopped.
+             * \param visTime   The visualization time the FMU is at.
+             */
+            void resetFrames(const double visTime);
+
+            /*! \brief Clears the history and records the current frame and a checkpoint of the members.
+             *
+             * \remark The simulation thread must be stopped.
+             * \param visTime   The visualization time the FMU is at.
+             */
+            void resetHistory(const double visTime);
+
+            /*! \brief Appends the current frame to the history and removes the checkpoints that are no longer needed. */
+            void recordFrame(const double visTime);
+
+            /*! \brief Stores a checkpoint of all members. */
+            void saveCheckpoints(const double visTime, EnsembleCheckpoint& checkpoint) const;
+
+            /*! \brief Resumes the simulation from the frame of the history shown at the current visualization time.
+             *
+             * The members are restored from the latest checkpoint before the frame and simulated up to it. The frames
+             * and checkpoints after it are discarded.
+             *
+             * \remark The simulation thread must be stopped.
+             */
+            void resumeFromHistory();
+
+            /*! \brief Main loop of the simulation thread.
+             *
+             * As soon as the pacing decides that the next frame is due, the FMU is simulated up to the simulation time
+             * planned by the pacing and the values of the visualization variables are published to the ring buffer.
+             * The thread waits while the next frame is not due, the buffer is full or the end time is reached.
+             */
+            void runSimulation();
+
+            /*! \brief Passes the time, the values of the visualization variables of the first member and the recorded
+             *         outputs to the recorder.
+             *
+             * \param simTime   Time point of the FMU the values belong to, which may be after the visualization time.
+             */
+            void recordRow(const double simTime, const std::vector<fmi1_real_t>& values);
+
+            /*! \brief Fetches the values of the visualization variables from all members. */
+            void fetchVisVariables(std::vector<fmi1_real_t>& values);
+
+            /*! \brief Fetches the values of the visualization variables from the given member. */
+            void fetchVisVariables(const size_t member, std::vector<fmi1_real_t>& values);
+
+            /*! \brief Initializes all members and shifts the states of member m by m times the perturbation. */
+            void initializeMembers();
+
+            /*! \brief Appends a copy of the shapes for each further member, tinted by the color of the member. */
+            void replicateShapes();
+
             /*! \todo Quick and dirty hack, move initialization of _simSettings to a more appropriate place! */
             void initData() override;
 
@@ -160,17 +388,23 @@ namespace OMVIS
              */
             void initializeVisAttributes(const double time = 0.0) override;
 
-            /*! \brief Helper function setVarReferencesInVisAttributes. */
-            fmi1_value_reference_t getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr);
-
             /*! \brief Sets the variable references in the visualization attributes.
+             *
+             * The value reference of each variable of the visualization variable table is stored in \ref _valueRefs at
+             * its index in the table. Thus, the values of all shapes are fetched by a single call to the FMU per frame
+             * and each variable is fetched only once. Variables that are not contained in the FMU are removed from the
+             * table and the attributes referencing them are set to a constant value of 0.0.
              *
              * \remark The vis. attributes are encapsulated in the inherited member _baseData of class type VisualBase.
              */
             int setVarReferencesInVisAttributes();
 
-            /*! \brief Update the attributes of a shape. */
-            void updateObjectAttributeFMU(ShapeObjectAttribute* attr, fmi1_import_t* fmu);
+            /*! \brief Update the attribute of a shape from the values of the current frame.
+             *
+             * \param attr          The attribute to update.
+             * \param valueOffset   Offset of the values of the member the shape belongs to.
+             */
+            void updateObjectAttributeFMU(ShapeObjectAttribute* attr, const size_t valueOffset);
         };
 
     }  // namespace Model
@@ -33,6 +33,7 @@
 #include "Initialization/VisualizationConstructionPlans.hpp"
 #include "Model/InputData.hpp"
 #include "Control/JoystickDevice.hpp"
+#include "Control/JoystickInputThread.hpp"
 #include "Control/KeyboardEventHandler.hpp"
 
 // NetOff
@@ -40,6 +41,7 @@
 #include <SimulationClient.hpp>
 
 #include <string>
+#include <vector>
 
 namespace OMVIS
 {
@@ -114,6 +116,12 @@ namespace OMVIS
             /*! Names of all output variables. */
             NetOff::VariableList _outputVars;
 
+            /*! Index of each variable of the visualization variable table in the output value container. */
+            std::vector<size_t> _outputIndices;
+
+            /*! Values of the visualization variable table of the current frame. */
+            std::vector<double> _values;
+
             std::shared_ptr<InputData> _inputData;
 
          public:
@@ -121,6 +129,9 @@ namespace OMVIS
             std::vector<Control::JoystickDevice*> _joysticks;
 
          private:
+            /// Publishes the joystick values, so that the simulation step only reads them.
+            Control::JoystickInputThread _joystickInput;
+
             std::string _remotePathToModelFile;
 
             /*-----------------------------------------
@@ -189,11 +200,9 @@ namespace OMVIS
              */
             NetOff::VariableList getInputVariables();
 
+            /*! \brief Resolves the position of each variable of the visualization variable table in the outputs. */
             int setVarReferencesInVisAttributes();
 
-            // Todo pass by const ref
-            fmi1_value_reference_t getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr);
-
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -28,16 +28,37 @@
 #define INCLUDE_VISUALIZERMAT_HPP_
 
 #include "Model/VisualizerAbstract.hpp"
-#include <read_matlab4.h>
+#include "Model/MatFileReader.hpp"
+#include "Model/FramePrefetcher.hpp"
+#include "Model/ResultTimeline.hpp"
+#include "Model/TransformCache.hpp"
+#include "Util/FileWatcher.hpp"
+
+#include <chrono>
+#include <vector>
 
 namespace OMVIS
 {
     namespace Model
     {
 
-        /*! \brief Class that reads results in MAT file format.
+        /*! \brief Resolved reference of a visualization variable to its position in the MAT file.
          *
+         * The reference is resolved once after the MAT file has been read. Negative aliases, i.e., variables that are
+         * stored as negated copy of another variable, are mapped to the column of the aliased variable and the sign is
+         * kept separately.
+         */
+        struct MatVariableRef
+        {
+            bool isParam;  ///< True, if the variable is stored in data_1.
+            size_t index;  ///< Zero based index into data_1 (param) or data_2.
+            double sign;   ///< -1.0 for negative aliases, 1.0 otherwise.
+        };
+
+        /*! \brief Class that reads results in MAT file format.
          *
+         * The referenced variables are copied from the result file into a \ref ResultTimeline once. Derived classes can
+         * visualize other result file formats by overriding the methods that access the result file.
          */
         class VisualizerMAT : public VisualizerAbstract
         {
@@ -67,26 +88,169 @@ namespace OMVIS
              * INITIALIZATION METHODS
              *---------------------------------------*/
 
+            /*! \brief Applies the speedup, the decimation tolerance, the follow mode and, if requested, bakes the shapes.
+             *
+             * If the decimation tolerance changed, the variables are extracted again from the MAT file.
+             */
             void setSimulationSettings(const UserSimSettingsMAT& simSetMAT);
 
-         private:
+            /*! \brief Returns the current settings. The speedup is relative to the current speed, thus, it is 1.0. */
+            UserSimSettingsMAT getCurrentSimSettings() const;
+
+            /*! \brief Bakes the transformation matrices, sizes and colors of all shapes into a cache file.
+             *
+             * The shapes are evaluated at every time point of the MAT file. The cache file is written next to the MAT
+             * file and is used for the rest of this session. Later sessions load it instead of the MAT file as long as
+             * neither the MAT file nor the visual XML file change.
+             *
+             * \remark The shapes are baked at the time points of the timeline. Thus, baking is refused if the
+             *         timeline has been decimated.
+             */
+            void bakeTransforms();
+
+            /*! \brief Enables or disables following a result file that is still being written.
+             *
+             * While the file is followed, it stays open and is watched for changes. Time points appended to the file
+             * are appended to the timeline and the end time of the visualization is extended accordingly.
+             *
+             * \remark A baked result cannot be followed.
+             */
+            void setFollowFile(const bool followFile);
+
+            /*-----------------------------------------
+             * SIMULATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Sets the visualization time and forces a binary search for the next time bracket. */
+            void setVisTime(const double visTime) override;
+
+            /*! \brief Returns true while the result file is followed, since further time points may be appended. */
+            bool waitsAtEndTime() const override;
+
+         protected:
+            /*! \brief Constructs a visualizer of the given type for result files of another format. */
+            VisualizerMAT(const std::string& modelFile, const std::string& path, const VisType visType);
+
             /*-----------------------------------------
              * MEMBERS
              *---------------------------------------*/
 
-            ModelicaMatReader _matReader;
+            /// Resolved references of the variables of the visualization variable table.
+            std::vector<MatVariableRef> _matVarRefs;
+            /// Values of the referenced variables. Column i belongs to entry i of \ref _matVarRefs.
+            ResultTimeline _timeline;
 
             /*-----------------------------------------
-             * PRIVATE METHODS
+             * INITIALIZATION METHODS
              *---------------------------------------*/
 
             void initData() override;
 
+            /*! \brief Replaces the values of the referenced variables, e.g., by another window of the result file.
+             *
+             * The given timeline has to contain the same columns as \ref _timeline. It receives the previous values.
+             */
+            void swapTimeline(ResultTimeline& timeline);
+
+            /*-----------------------------------------
+             * RESULT FILE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Opens the result file.
+             *
+             * \throws std::runtime_error If the file does not exist or cannot be read.
+             */
+            virtual void openResultFile();
+
+            /*! \brief Closes the result file after all referenced variables have been copied into \ref _timeline. */
+            virtual void closeResultFile();
+
+            /*! \brief Picks up the time points that have been appended to the result file since it was opened.
+             *
+             * \return The number of time points in the result file.
+             * \throws std::runtime_error If the result file cannot be read anymore.
+             */
+            virtual size_t refreshResultFile();
+
+            /*! \brief Returns false, if the result file is still being written. */
+            virtual bool isResultFileComplete() const;
+
+            /*! \brief Resolves the variable with the given name in the result file.
+             *
+             * \return False, if the result file does not contain the variable.
+             */
+            virtual bool findResultVariable(const std::string& name, MatVariableRef& ref) const;
+
+            /*! \brief Returns the number of time points in the result file. */
+            virtual size_t getNumResultRows() const;
+
+            /*! \brief Copies a range of time points and the referenced variables into the allocated \ref _timeline.
+             *
+             * Constant columns are only copied if the range starts at the first time point.
+             *
+             * \param firstRow      First time point of the result file to copy.
+             * \param numRows       Number of time points to copy.
+             * \param timelineRow   Row of the timeline the first time point is copied to.
+             */
+            virtual void readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow);
+
+            /*! \brief Makes sure that \ref _timeline contains the given time before a frame is fetched.
+             *
+             * Derived classes that keep only a window of the result file in \ref _timeline move the window here. The
+             * timeline of a local result file contains all time points, thus, nothing has to be done.
+             */
+            virtual void updateTimelineWindow(const double time);
+
+         private:
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            MatFileReader _matReader;
+            /// Interpolated values of all referenced variables for the current frame.
+            TimelineFrame _frame;
+            /// Time bracket of the last frame that has been interpolated directly.
+            TimelineCursor _cursor;
+            /// Interpolates the upcoming frames in the background.
+            FramePrefetcher _prefetcher;
+            /// Tolerance for the decimation of the timeline. No time points are removed, if it is zero.
+            double _decimationTolerance;
+            /// Baked shapes of all time points. If the cache is open, the shapes are taken from it.
+            TransformCache _transformCache;
+            /// True, if the result file is still being written and new time points are appended to the timeline.
+            bool _followFile;
+            /// Watches the followed result file for changes.
+            Util::FileWatcher _fileWatcher;
+            /// True, if the result file changed since the last refresh.
+            bool _hasPendingChanges;
+            /// Point in time of the last refresh of the followed result file.
+            std::chrono::steady_clock::time_point _lastRefresh;
+            /// Number of time points of the result file that have been copied into the timeline.
+            size_t _numResultRows;
+
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
             /*! \brief Initializes the visualization attributes in order to set the scene to the initial position. */
             void initializeVisAttributes(const double time = -1.0) override;
 
             void readMat(const std::string& modelFile, const std::string& path);
 
+            /*! \brief Opens the baked cache file of the MAT file, if there is a valid one.
+             *
+             * \return True, if the cache file has been opened.
+             */
+            bool openTransformCache();
+
+            /*! \brief Resolves the variables of the visualization variable table in the MAT file.
+             *
+             * Each variable is looked up once and stored in \ref _matVarRefs at its index in the table, thus, no name
+             * lookup is necessary during the visualization. Variables that are not contained in the MAT file are
+             * removed from the table and the attributes referencing them are set to a constant value of 0.0.
+             */
+            void setVarReferencesInVisAttributes();
+
             /*-----------------------------------------
              * SIMULATION METHODS
              *---------------------------------------*/
@@ -106,20 +270,40 @@ namespace OMVIS
             /*! \brief For MAT file based visualization, nothing has to be done. Just get the visualizationAttributes. */
             void updateScene(const double time) override;
 
-            /*! \brief Update the attribute of the Object using a MAT result file. */
-            void updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr, double time, ModelicaMatReader* reader);
+            /*! \brief Copies the referenced variables from the result file into \ref _timeline.
+             *
+             * If a decimation tolerance is set, the timeline is decimated afterwards. Finally, the result file is
+             * closed since all further accesses are served by the timeline, unless the result file is followed.
+             */
+            void extractTimeline();
+
+            /*! \brief Appends the time points that have been written to the followed result file to \ref _timeline.
+             *
+             * The refreshes are throttled, thus, a simulation that writes many small chunks does not stall the
+             * visualization. If the visualization time is at the end of the timeline, it moves to the new end.
+             */
+            void followResultFile();
 
-            /*! \brief Fetches the value of a variable at a certain time.
+            /*! \brief Fetches the values of all referenced variables at a certain time into \ref _frame.
              *
-             * \todo The method omc_matlab4_val which is called inside this method returns 0 on success. Thus, we
-             *       should test the return value.
+             * If the frame has been prefetched, it is taken from \ref _prefetcher. Otherwise, it is interpolated
+             * directly and the prefetcher continues with the following frames.
              *
-             * \param reader    The ModelicaMatReader object to use for reading the MAT file.
-             * \param varName   The name of the variable to fetch the value for.
-             * \param time      The time to get the value for.
-             * \return Value of the variable at the specified time.
+             * \param time    The time to get the values for. It is clamped to the time range of the MAT file.
              */
-            double omcGetVarValue(ModelicaMatReader* reader, const char* varName, double time);
+            void fetchFrame(const double time);
+
+            /*! \brief Update the attribute of the Object from the current frame. */
+            void updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr);
+
+            /*! \brief Updates all attributes of the shape from the current frame and computes its transformation. */
+            void updateShapeFromFrame(ShapeObject& shape);
+
+            /*! \brief Stores the transformation and the dynamic attributes of the shape. */
+            void bakeShape(const ShapeObject& shape, BakedShape& baked) const;
+
+            /*! \brief Restores the transformation and the dynamic attributes of the shape from the cache. */
+            void restoreShape(const BakedShape& baked, ShapeObject& shape) const;
         };
 
     }  // namespace Model
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Model
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_MODEL_VISUALIZERMATCLIENT_HPP_
+#define INCLUDE_MODEL_VISUALIZERMATCLIENT_HPP_
+
+#include "Model/VisualizerMAT.hpp"
+#include "Model/RemoteMatFile.hpp"
+#include "Initialization/VisualizationConstructionPlans.hpp"
+
+#include <future>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*! \brief Class that visualizes a MAT result file that is located on a server.
+         *
+         * Instead of copying the whole result file, only the columns of the visualization variables are requested from
+         * a \ref MatFileServer for a window of time points. As soon as the playback passed the middle of the window,
+         * the following window is requested in the background. If the user jumps out of the window, e.g., by the time
+         * slider, the window at the new time is requested immediately.
+         *
+         * The visual XML file is expected in the local working directory.
+         *
+         * \remark The decimation tolerance is only applied to the window that is loaded when the setting changes.
+         */
+        class VisualizerMATClient : public VisualizerMAT
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            VisualizerMATClient() = delete;
+
+            /*! \brief Constructs a VisualizerMATClient object from the given construction plan.
+             *
+             * \param cP    The construction plan which holds the server and port, the path to the result file on the
+             *              server and the local working directory.
+             */
+            VisualizerMATClient(const Initialization::RemoteVisualizationConstructionPlan* cP);
+
+            /*! \brief Waits for a pending window request. */
+            virtual ~VisualizerMATClient();
+
+            VisualizerMATClient(const VisualizerMATClient& rhs) = delete;
+
+            VisualizerMATClient& operator=(const VisualizerMATClient& rhs) = delete;
+
+         protected:
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Initializes the visualization and sets its time range to the one of the whole result file. */
+            void initData() override;
+
+            /*-----------------------------------------
+             * RESULT FILE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Connects to the server and opens the result file, if this has not been done before.
+             *
+             * \throws std::runtime_error If the server cannot be reached or cannot open the result file.
+             */
+            void openResultFile() override;
+
+            /*! \brief The connection is kept open since the windows are requested during the visualization. */
+            void closeResultFile() override;
+
+            /*! \brief The remote result file is complete, thus, the number of time points of the window is returned. */
+            size_t refreshResultFile() override;
+
+            bool isResultFileComplete() const override;
+
+            bool findResultVariable(const std::string& name, MatVariableRef& ref) const override;
+
+            /*! \brief Returns the number of time points of the current window. */
+            size_t getNumResultRows() const override;
+
+            /*! \brief Requests the given range of time points of the current window from the server. */
+            void readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow) override;
+
+            /*! \brief Moves the window to the given time and requests the following window in advance. */
+            void updateTimelineWindow(const double time) override;
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Returns true, if the window contains the given time point and its successor. */
+            bool isInWindow(const size_t row, const size_t firstRow, const size_t numRows) const;
+
+            /*! \brief Returns the number of time points of a window that starts at the given time point. */
+            size_t getWindowSize(const size_t firstRow) const;
+
+            /*! \brief Allocates the given timeline for a window with the given number of time points. */
+            void allocateWindow(ResultTimeline& timeline, const size_t numRows) const;
+
+            /*! \brief Requests the window that starts at the given time point in the background. */
+            void requestNextWindow(const size_t firstRow);
+
+            /*! \brief Waits for the requested window and discards it. */
+            void discardNextWindow();
+
+            /*! \brief Requests the given time points of the referenced variables into the given timeline.
+             *
+             * Constant columns are only set if the time points are copied to the first row of the timeline.
+             */
+            void fetchRows(const size_t firstRow, const size_t numRows, ResultTimeline& timeline,
+                           const size_t timelineRow);
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            RemoteMatFile _remoteFile;
+            std::string _hostAddress;
+            int _port;
+            /// Path to the result file on the server.
+            std::string _remotePathToModelFile;
+            /// First time point and number of time points of the window in \ref _timeline.
+            size_t _windowFirstRow;
+            size_t _windowNumRows;
+            /// The window that is requested in the background.
+            ResultTimeline _nextWindow;
+            size_t _nextWindowFirstRow;
+            size_t _nextWindowNumRows;
+            /// Valid while the next window is requested.
+            std::future<void> _pendingWindow;
+        };
+
+    }  // namespace Model
+}  // namespace OMVIS
+
+#endif /* INCLUDE_MODEL_VISUALIZERMATCLIENT_HPP_ */
+/**
+ * \}
+ */
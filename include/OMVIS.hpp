@@ -39,6 +39,7 @@
 #include "Model/InfoVisitor.hpp"
 #include "Model/UpdateVisitor.hpp"
 #include "Control/TimeManager.hpp"
+#include "Control/HeadlessRunner.hpp"
 #include "Initialization/CommandLineArgs.hpp"
 #include "Initialization/Factory.hpp"
 #include "Util/Visualize.hpp"
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+
+#ifndef INCLUDE_FILEWATCHER_HPP_
+#define INCLUDE_FILEWATCHER_HPP_
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Detects modifications of a file without blocking.
+         *
+         * On Linux, the file is watched by inotify, thus, a query is a single non-blocking read. On other platforms or
+         * if inotify is not available, the size and the modification time of the file are compared instead.
+         */
+        class FileWatcher
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            FileWatcher();
+
+            /*! \brief Stops watching the file. */
+            ~FileWatcher();
+
+            FileWatcher(const FileWatcher& rhs) = delete;
+
+            FileWatcher& operator=(const FileWatcher& rhs) = delete;
+
+            /*-----------------------------------------
+             * INITIALIZATION METHODS
+             *---------------------------------------*/
+
+            /*! \brief Starts watching the given file. A previously watched file is released. */
+            void watch(const std::string& fileName);
+
+            /*! \brief Stops watching the file. */
+            void stop();
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            bool isWatching() const;
+
+            /*! \brief Returns true, if the file has been modified since the last call or since \ref watch. */
+            bool hasChanged();
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Compares the size and the modification time of the file to the last known ones. */
+            bool hasChangedStat();
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::string _fileName;
+            /// File descriptors of the inotify instance and of the watch. Negative, if inotify is not used.
+            int _inotifyFd;
+            int _watchFd;
+            /// Last known size and modification time of the file.
+            uintmax_t _size;
+            std::time_t _modTime;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_FILEWATCHER_HPP_ */
+/**
+ * \}
+ */
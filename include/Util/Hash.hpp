@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+
+#ifndef INCLUDE_HASH_HPP_
+#define INCLUDE_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /// Offset basis of the 64 bit FNV-1a hash.
+        const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+        /*! \brief Computes the 64 bit FNV-1a hash of the given bytes.
+         *
+         * The hash is not cryptographically secure. It is used to detect whether input files have changed.
+         *
+         * \param data  The bytes to hash.
+         * \param size  Number of bytes.
+         * \param seed  Hash of the preceding data, which allows to hash data in several chunks.
+         */
+        inline uint64_t hashBytes(const void* data, const size_t size, const uint64_t seed = FNV_OFFSET_BASIS)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            uint64_t hash = seed;
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        inline uint64_t hashString(const std::string& str, const uint64_t seed = FNV_OFFSET_BASIS)
+        {
+            return hashBytes(str.data(), str.size(), seed);
+        }
+
+        /*! \brief Hashes a trivially copyable value, e.g., a file size, into the given hash. */
+        template <typename T>
+        inline uint64_t hashValue(const T& value, const uint64_t seed = FNV_OFFSET_BASIS)
+        {
+            return hashBytes(&value, sizeof(T), seed);
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_HASH_HPP_ */
+/**
+ * \}
+ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_LINEARSOLVER_HPP_
+#define INCLUDE_LINEARSOLVER_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Computes the LU decomposition with partial pivoting of a dense matrix in place.
+         *
+         * \param a       Row-major n x n matrix. It is overwritten by the factors L (without the unit diagonal) and U.
+         * \param n       Dimension of the matrix.
+         * \param pivots  Output: The row that has been swapped with row i in step i.
+         * \return False, if the matrix is singular.
+         */
+        bool luFactorize(std::vector<double>& a, const size_t n, std::vector<size_t>& pivots);
+
+        /*! \brief Solves the linear system for a matrix that has been factorized by \ref luFactorize.
+         *
+         * \param lu      The factors returned by \ref luFactorize.
+         * \param n       Dimension of the matrix.
+         * \param pivots  The pivots returned by \ref luFactorize.
+         * \param b       The right hand side of size n. It is overwritten by the solution.
+         */
+        void luSolve(const std::vector<double>& lu, const size_t n, const std::vector<size_t>& pivots, double* b);
+
+        /*! \brief Groups the columns of a sparse matrix such that no two columns of a group have a nonzero entry in
+         *         the same row.
+         *
+         * The columns of a group can be perturbed at once when a Jacobian is approximated by finite differences, since
+         * each row of the difference belongs to exactly one column of the group. The groups are found by a greedy
+         * coloring in the order of the columns.
+         *
+         * \param pattern   Row-major n x n sparsity pattern. True for structural nonzero entries.
+         * \param n         Dimension of the matrix.
+         * \return The group (color) of each column. The colors are numbered consecutively from zero.
+         */
+        std::vector<size_t> colorColumns(const std::vector<bool>& pattern, const size_t n);
+
+        /*! \brief Approximates the Jacobian of a function by forward differences.
+         *
+         * Without a pattern, each column is perturbed on its own. With a pattern, all columns of a color are perturbed
+         * at once and only the entries of the pattern are set, see \ref colorColumns.
+         *
+         * \param f         Evaluates the function: f(x, fx) stores the n values at x in fx.
+         * \param x         The n values at which the Jacobian is approximated.
+         * \param fx        The n function values at x.
+         * \param n         Dimension of the Jacobian.
+         * \param pattern   Row-major n x n sparsity pattern or empty.
+         * \param colors    Color of each column, if a pattern is given.
+         * \param jacobian  Output: Row-major n x n Jacobian. Entries outside of the pattern are zero.
+         * \return The number of evaluations of f.
+         */
+        size_t approximateJacobian(const std::function<void(const double*, double*)>& f, const double* x,
+                                   const double* fx, const size_t n, const std::vector<bool>& pattern,
+                                   const std::vector<size_t>& colors, std::vector<double>& jacobian);
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_LINEARSOLVER_HPP_ */
+/**
+ * \}
+ */
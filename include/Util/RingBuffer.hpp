@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_RINGBUFFER_HPP_
+#define INCLUDE_RINGBUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief Lock-free ring buffer for exactly one producer thread and one consumer thread.
+         *
+         * The slots are allocated once and reused. Thus, the producer writes into a slot in place and publishes it by
+         * \ref commitWrite, the consumer reads a slot in place and releases it by \ref commitRead. This avoids
+         * allocations for slots that own memory, e.g., vectors.
+         */
+        template <typename T>
+        class RingBuffer
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            RingBuffer() = delete;
+
+            /*! \brief Constructs a ring buffer that holds up to capacity elements. */
+            explicit RingBuffer(const size_t capacity)
+                    : _slots(capacity + 1),
+                      _readIdx(0),
+                      _writeIdx(0)
+            {
+            }
+
+            ~RingBuffer() = default;
+
+            RingBuffer(const RingBuffer& rhs) = delete;
+
+            RingBuffer& operator=(const RingBuffer& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            size_t getCapacity() const
+            {
+                return _slots.size() - 1;
+            }
+
+            /*! \brief Returns the slot with the given index regardless of its state.
+             *
+             * \remark Only use this method if neither the producer nor the consumer is active, e.g., to initialize the
+             *         slots.
+             */
+            T& getSlot(const size_t idx)
+            {
+                return _slots[idx];
+            }
+
+            size_t getNumSlots() const
+            {
+                return _slots.size();
+            }
+
+            bool isEmpty() const
+            {
+                return _readIdx.load(std::memory_order_acquire) == _writeIdx.load(std::memory_order_acquire);
+            }
+
+            /*-----------------------------------------
+             * PRODUCER
+             *---------------------------------------*/
+
+            /*! \brief Returns the next free slot or nullptr, if the buffer is full. */
+            T* getWriteSlot()
+            {
+                auto writeIdx = _writeIdx.load(std::memory_order_relaxed);
+                if (next(writeIdx) == _readIdx.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+                return &_slots[writeIdx];
+            }
+
+            /*! \brief Publishes the slot returned by \ref getWriteSlot to the consumer. */
+            void commitWrite()
+            {
+                _writeIdx.store(next(_writeIdx.load(std::memory_order_relaxed)), std::memory_order_release);
+            }
+
+            /*-----------------------------------------
+             * CONSUMER
+             *---------------------------------------*/
+
+            /*! \brief Returns the oldest published slot or nullptr, if the buffer is empty. */
+            T* getReadSlot()
+            {
+                auto readIdx = _readIdx.load(std::memory_order_relaxed);
+                if (readIdx == _writeIdx.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+                return &_slots[readIdx];
+            }
+
+            /*! \brief Releases the slot returned by \ref getReadSlot to the producer. */
+            void commitRead()
+            {
+                _readIdx.store(next(_readIdx.load(std::memory_order_relaxed)), std::memory_order_release);
+            }
+
+            /*! \brief Releases all published slots.
+             *
+             * \remark Must only be called by the consumer.
+             */
+            void clear()
+            {
+                _readIdx.store(_writeIdx.load(std::memory_order_acquire), std::memory_order_release);
+            }
+
+         private:
+            size_t next(const size_t idx) const
+            {
+                return (idx + 1 == _slots.size()) ? 0 : idx + 1;
+            }
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            /// The slots. One slot is always kept free to distinguish a full from an empty buffer.
+            std::vector<T> _slots;
+            /// Index of the next slot to read. Only written by the consumer.
+            std::atomic<size_t> _readIdx;
+            /// Index of the next slot to write. Only written by the producer.
+            std::atomic<size_t> _writeIdx;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_RINGBUFFER_HPP_ */
+/**
+ * \}
+ */
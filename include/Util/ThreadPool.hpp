@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \addtogroup Util
+ *  \{
+ *  \copyright TU Dresden. All rights reserved.
+ *  \authors Volker Waurich, Martin Flehmig
+ *  \date Feb 2016
+ */
+
+#ifndef INCLUDE_THREADPOOL_HPP_
+#define INCLUDE_THREADPOOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*! \brief A fixed set of worker threads that process the tasks of a parallel loop.
+         *
+         * The workers are started once and wait for the next loop. Thus, a loop can be run per frame without the
+         * costs of starting threads. The thread calling \ref parallelFor processes tasks as well.
+         */
+        class ThreadPool
+        {
+         public:
+            /*-----------------------------------------
+             * CONSTRUCTORS
+             *---------------------------------------*/
+
+            ThreadPool() = delete;
+
+            /*! \brief Starts the given number of worker threads.
+             *
+             * \param numWorkers    Number of worker threads besides the calling thread. Might be zero.
+             */
+            explicit ThreadPool(const size_t numWorkers);
+
+            /*! \brief Stops and joins the worker threads. */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool& rhs) = delete;
+
+            ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+            /*-----------------------------------------
+             * GETTERS
+             *---------------------------------------*/
+
+            size_t getNumWorkers() const;
+
+            /*-----------------------------------------
+             * PARALLEL METHODS
+             *---------------------------------------*/
+
+            /*! \brief Calls task(i) for each i in [0, numTasks) and returns as soon as all tasks are done.
+             *
+             * The tasks are distributed to the workers and the calling thread on demand. If a task throws an exception,
+             * the remaining tasks are still processed and the first exception is rethrown afterwards.
+             *
+             * \remark Must not be called concurrently.
+             */
+            void parallelFor(const size_t numTasks, const std::function<void(size_t)>& task);
+
+         private:
+            /*-----------------------------------------
+             * PRIVATE METHODS
+             *---------------------------------------*/
+
+            /*! \brief Main loop of the worker threads. */
+            void work();
+
+            /*! \brief Processes tasks of the current loop until none is left. The lock is held on entry and exit. */
+            void processTasks(std::unique_lock<std::mutex>& lock);
+
+            /*-----------------------------------------
+             * MEMBERS
+             *---------------------------------------*/
+
+            std::vector<std::thread> _workers;
+            /// Guards the state of the current loop.
+            std::mutex _mutex;
+            /// Notifies the workers about a new loop or the shutdown.
+            std::condition_variable _taskCondition;
+            /// Notifies the calling thread that all tasks are done.
+            std::condition_variable _doneCondition;
+            /// The task of the current loop or nullptr, if no loop is running.
+            const std::function<void(size_t)>* _task;
+            size_t _numTasks;
+            size_t _nextTask;
+            size_t _numDoneTasks;
+            /// The first exception thrown by a task of the current loop.
+            std::exception_ptr _exception;
+            bool _isStopping;
+        };
+
+    }  // namespace Util
+}  // namespace OMVIS
+
+#endif /* INCLUDE_THREADPOOL_HPP_ */
+/**
+ * \}
+ */
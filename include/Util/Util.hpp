@@ -213,6 +213,12 @@ namespace OMVIS
             return (mat != std::string::npos);
         }
 
+        inline bool isCSV(const std::string& fileIn)
+        {
+            std::size_t csv = fileIn.find(".csv");
+            return (csv != std::string::npos);
+        }
+
         /*! \brief Creates the name of the xml visual file from model name and path.
          *
          * \param modelFile   Name of the file containing the model, e.g., modelFoo.fmu
@@ -227,8 +233,8 @@ namespace OMVIS
             {
                 signsOff = 4;
             }
-            // modelFoo_res.mat --> -8 signs
-            else if (isMAT(modelFile))
+            // modelFoo_res.mat or modelFoo_res.csv --> -8 signs
+            else if (isMAT(modelFile) || isCSV(modelFile))
             {
                 signsOff = 8;
             }
@@ -237,7 +243,7 @@ namespace OMVIS
             {
                 // todo: Handle this case.
             }
-            // Cut off prefix [fmu|mat]
+            // Cut off prefix [fmu|mat|csv]
             std::string fileName = modelFile.substr(0, modelFile.length() - signsOff);
             // Construct XML file name
             std::string xmlFileName = path + fileName + "_visual.xml";
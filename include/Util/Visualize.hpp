@@ -41,6 +41,8 @@
 #include <osg/Geode>
 #include <osg/Vec3f>
 
+#include <vector>
+
 namespace OMVIS
 {
     namespace Util
@@ -106,8 +108,11 @@ namespace OMVIS
         /*! \brief Update the attribute of the object using a MAT file result. */
         void updateObjectAttributeFMU(Model::ShapeObjectAttribute* attr, double time, fmi1_import_t* fmu);
 
-        /*! \brief Update the attribute of the object using remote FMU visualization. */
-        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const NetOff::ValueContainer& _outputCont);
+        /*! \brief Update the attribute of the object using remote FMU visualization.
+         *
+         * \param values  The values of the visualization variable table of the current frame.
+         */
+        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const std::vector<double>& values);
 
         /*! \brief Gets the value of the indicated node exp. */
         double getShapeAttrFMU(const char* attr, rapidxml::xml_node<>* node, double time, fmi1_import_t* fmu);
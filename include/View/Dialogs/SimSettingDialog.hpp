@@ -26,6 +26,7 @@
 
 #include <QDialog>
 #include <QLineEdit>
+#include <QCheckBox>
 #include <QComboBox>
 
 #include <memory>
@@ -48,9 +49,8 @@ namespace OMVIS
              * CONSTRUCTORS
              *---------------------------------------*/
 
-            /// Todo Implement that all solvers can be selected. I.e., Model::Solver --> QComboBox
             SimSettingDialogFMU(QWidget* parent = Q_NULLPTR,
-                                const Model::UserSimSettingsFMU& simSetFMU = {Model::Solver::NONE, 0.1, 100, 10.0});
+                                const Model::UserSimSettingsFMU& simSetFMU = {Model::Solver::NONE, 0.1, 100, 10.0, 1.0});
 
             ~SimSettingDialogFMU() = default;
 
@@ -84,6 +84,7 @@ namespace OMVIS
             std::unique_ptr<QLineEdit> _simStepSizeLineEdit;
             std::unique_ptr<QLineEdit> _visStepSizeLineEdit;
             std::unique_ptr<QLineEdit> _simEndTimeLineEdit;
+            std::unique_ptr<QLineEdit> _realTimeFactorLineEdit;
             Model::UserSimSettingsFMU _simSet;
         };
 
@@ -102,7 +103,8 @@ namespace OMVIS
              * CONSTRUCTORS
              *---------------------------------------*/
 
-            SimSettingDialogMAT(QWidget* parent = Q_NULLPTR);
+            SimSettingDialogMAT(QWidget* parent = Q_NULLPTR,
+                                const Model::UserSimSettingsMAT& simSetMAT = {1.0, false, 0.0, false});
 
             ~SimSettingDialogMAT() = default;
 
@@ -131,6 +133,9 @@ namespace OMVIS
              *---------------------------------------*/
 
             std::unique_ptr<QLineEdit> _speedupLineEdit;
+            std::unique_ptr<QCheckBox> _bakeCheckBox;
+            std::unique_ptr<QLineEdit> _toleranceLineEdit;
+            std::unique_ptr<QCheckBox> _followCheckBox;
             Model::UserSimSettingsMAT _simSet;
         };
 
@@ -248,6 +248,13 @@ namespace OMVIS
             /*! \todo Implement me. */
             void exportVideo();
 
+            /*! \brief Starts to record the FMU simulation to a MAT result file chosen by the user or stops the
+             *         recording.
+             *
+             * The result file can be opened by OMVIS afterwards.
+             */
+            void recordSimulation();
+
             /*! \brief Function that opens the input mapper dialog. */
             void openDialogInputMapper();
 
@@ -304,6 +311,7 @@ namespace OMVIS
             QAction* _openAct;
             QAction* _openRCAct;
             QAction* _exportAct;
+            QAction* _recordAct;
             QAction* _exitAct;
             QAction* _mapInputAct;
             QAction* _dontCareAct;
@@ -210,7 +210,7 @@ namespace OMVIS
 
         void GUIController::setVisTime(const int val)
         {
-            _modelVisualizer->getTimeManager()->setVisTime(
+            _modelVisualizer->setVisTime(
                     (_modelVisualizer->getTimeManager()->getEndTime()
                             - _modelVisualizer->getTimeManager()->getStartTime()) * static_cast<float>(val / 100.0));
         }
@@ -225,6 +225,16 @@ namespace OMVIS
             return _modelVisualizer->getTimeManager()->getRealTimeFactor();
         }
 
+        double GUIController::getLag()
+        {
+            return _modelVisualizer->getTimeManager()->getLag();
+        }
+
+        size_t GUIController::getNumDroppedFrames()
+        {
+            return _modelVisualizer->getTimeManager()->getNumDroppedFrames();
+        }
+
         double GUIController::getSimulationStartTime() const
         {
             return _modelVisualizer->getTimeManager()->getStartTime();
@@ -265,6 +275,11 @@ namespace OMVIS
             return visTypeIs(Model::VisType::MAT_REMOTE);
         }
 
+        bool GUIController::visTypeIsCSV() const
+        {
+            return visTypeIs(Model::VisType::CSV);
+        }
+
         std::string GUIController::getModelFile() const
         {
             return _modelVisualizer->getModelFile();
@@ -284,6 +299,16 @@ namespace OMVIS
             }
         }
 
+        Model::UserSimSettingsMAT GUIController::getCurrentSimSettingsMAT() const
+        {
+            // VisualizerCSV and VisualizerMATClient derive from VisualizerMAT.
+            if (visTypeIsMAT() || visTypeIsCSV() || visTypeIsMATRemote())
+            {
+                return std::dynamic_pointer_cast<Model::VisualizerMAT>(_modelVisualizer)->getCurrentSimSettings();
+            }
+            return {1.0, false, 0.0, false};
+        }
+
         bool GUIController::modelIsLoaded()
         {
             return (nullptr != _modelVisualizer);
@@ -327,20 +352,42 @@ namespace OMVIS
 
         void GUIController::handleSimulationSettings(const Model::UserSimSettingsMAT& simSetMAT)
         {
-            if (visTypeIsMAT())
+            if (visTypeIsMAT() || visTypeIsCSV() || visTypeIsMATRemote())
             {
                 std::dynamic_pointer_cast<Model::VisualizerMAT>(_modelVisualizer)->setSimulationSettings(simSetMAT);
                 //initVisualization();
             }
-            else if (visTypeIsMATRemote())
+            else
             {
-                LOGGER_WRITE("Not yet implemented for MAT Remote visualization.", Util::LC_CTR, Util::LL_INFO);
+                throw std::runtime_error("Wrong function called");
+            }
+        }
+
+        void GUIController::startRecording(const std::string& fileName, const bool withOutputs)
+        {
+            if (visTypeIsFMU())
+            {
+                auto omVisFMU = std::dynamic_pointer_cast<Model::VisualizerFMU>(_modelVisualizer);
+                omVisFMU->startRecording(fileName, withOutputs);
             }
             else
             {
-                throw std::runtime_error("Wrong function called");
+                throw std::runtime_error("Only FMU simulations can be recorded.");
+            }
+        }
+
+        void GUIController::stopRecording()
+        {
+            if (visTypeIsFMU())
+            {
+                std::dynamic_pointer_cast<Model::VisualizerFMU>(_modelVisualizer)->stopRecording();
             }
         }
 
+        bool GUIController::isRecording() const
+        {
+            return visTypeIsFMU() && std::dynamic_pointer_cast<Model::VisualizerFMU>(_modelVisualizer)->isRecording();
+        }
+
     }  // namespace Control
 }  // namespace OMVIS
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Control/HeadlessRunner.hpp"
+#include "Initialization/Factory.hpp"
+#include "Model/VisualizerFMU.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Util.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /// Wall clock time in seconds without progress after which a headless run is aborted.
+        static const double s_stallTimeout = 10.0;
+
+        /// Returns the time of a monotonic wall clock in seconds.
+        static double getWallTime()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        HeadlessRunner::HeadlessRunner(const Initialization::CommandLineArgs& clArgs)
+                : _clArgs(clArgs),
+                  _visualizer(nullptr)
+        {
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void HeadlessRunner::run()
+        {
+            const double loadStart = getWallTime();
+            loadModel();
+            const double loadTime = getWallTime() - loadStart;
+
+            // Without window, there is no need to keep pace with the wall clock.
+            auto fmuVisualizer = std::dynamic_pointer_cast<Model::VisualizerFMU>(_visualizer);
+            if (nullptr != fmuVisualizer)
+            {
+                fmuVisualizer->setPaced(false);
+            }
+
+            auto timeManager = _visualizer->getTimeManager();
+            const double startTime = timeManager->getVisTime();
+            const size_t maxNumFrames = static_cast<size_t>(_clArgs.numFrames);
+            size_t numFrames = 0;
+            const size_t startSolverSteps = (nullptr != fmuVisualizer) ? fmuVisualizer->getNumSolverSteps() : 0;
+            _visualizer->setProfiling(true);
+            _visualizer->startVisualization();
+
+            const double runStart = getWallTime();
+            double lastProgress = runStart;
+            while (!timeManager->isPaused() && (0 == maxNumFrames || numFrames < maxNumFrames))
+            {
+                const double visTime = timeManager->getVisTime();
+                _visualizer->sceneUpdate();
+                if (visTime != timeManager->getVisTime())
+                {
+                    ++numFrames;
+                    lastProgress = getWallTime();
+                    continue;
+                }
+
+                // A result file that is still being written holds the end time until further results arrive.
+                if (_visualizer->waitsAtEndTime() && visTime >= timeManager->getEndTime() - 1.e-6)
+                {
+                    break;
+                }
+                // The simulation thread lags behind.
+                if (getWallTime() - lastProgress > s_stallTimeout)
+                {
+                    throw std::runtime_error("The headless run stalled at time point " + std::to_string(visTime)
+                                             + ".");
+                }
+                std::this_thread::yield();
+            }
+            const double runTime = getWallTime() - runStart;
+            // The simulation thread may have simulated a few frames ahead, which are counted as well.
+            const size_t numSolverSteps = (nullptr != fmuVisualizer)
+                    ? fmuVisualizer->getNumSolverSteps() - startSolverSteps : 0;
+            _visualizer->pauseVisualization();
+
+            printReport(loadTime, runTime, numFrames, numSolverSteps, startTime);
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void HeadlessRunner::loadModel()
+        {
+            Initialization::Factory factory;
+            if (_clArgs.remoteVisualization())
+            {
+                // For remote visualization, the visual XML file needs to be in the local working directory.
+                auto cP = _clArgs.getRemoteVisualizationConstructionPlan();
+                if (!Util::checkForXMLFile(cP.modelFile, cP.wDir))
+                {
+                    throw std::runtime_error("Could not find the visual XML file in the working directory " + cP.wDir
+                                             + ".");
+                }
+                _visualizer = factory.createVisualizerObject(&cP);
+            }
+            else
+            {
+                auto cP = _clArgs.getVisualizationConstructionPlan();
+                if (!Util::checkForXMLFile(cP.modelFile, cP.path))
+                {
+                    throw std::runtime_error("Could not find the visual XML file "
+                                             + Util::getXMLFileName(cP.modelFile, cP.path) + ".");
+                }
+                _visualizer = factory.createVisualizerObject(&cP);
+            }
+
+            if (nullptr == _visualizer)
+            {
+                throw std::runtime_error("Could not load model. Factory returned nullptr.");
+            }
+            _visualizer->initialize();
+            LOGGER_WRITE("The model has been loaded for a headless run.", Util::LC_CTR, Util::LL_INFO);
+        }
+
+        void HeadlessRunner::printReport(const double loadTime, const double runTime, const size_t numFrames,
+                                         const size_t numSolverSteps, const double startTime) const
+        {
+            const Model::FrameTimings& timings = _visualizer->getFrameTimings();
+            const double endTime = _visualizer->getTimeManager()->getVisTime();
+            // Scene updates without a new frame, e.g., while the simulation thread lags behind, count as fetch time.
+            const double perFrame = (0 < numFrames) ? 1.e6 / numFrames : 0.0;
+
+            std::cout << "\nHeadless run of " << _visualizer->getModelFile() << ":" << std::endl;
+            std::cout << std::fixed << std::setprecision(3);
+            std::cout << "  Load Time [s]: " << loadTime << std::endl;
+            std::cout << "  Run Time [s]: " << runTime << std::endl;
+            std::cout << "  Visualization Time [s]: " << startTime << " to " << endTime << std::endl;
+            std::cout << "  Frames: " << numFrames << " of " << timings.numUpdates << " scene updates" << std::endl;
+            if (Model::VisType::FMU == _visualizer->getVisType())
+            {
+                std::cout << "  Solver Steps: " << numSolverSteps << std::endl;
+            }
+            if (0.0 < runTime)
+            {
+                std::cout << "  Frames per Second: " << numFrames / runTime << std::endl;
+                if (Model::VisType::FMU == _visualizer->getVisType())
+                {
+                    std::cout << "  Solver Steps per Second: " << numSolverSteps / runTime << std::endl;
+                }
+                std::cout << "  Simulated Seconds per Second: " << (endTime - startTime) / runTime << std::endl;
+            }
+            std::cout << "  Phase          Total [s]    Per Frame [us]" << std::endl;
+            std::cout << "  Fetch        " << std::setw(11) << timings.fetch << std::setw(18)
+                      << timings.fetch * perFrame << std::endl;
+            std::cout << "  Transform    " << std::setw(11) << timings.transform << std::setw(18)
+                      << timings.transform * perFrame << std::endl;
+            std::cout << "  Scene Update " << std::setw(11) << timings.sceneUpdate << std::setw(18)
+                      << timings.sceneUpdate * perFrame << std::endl;
+        }
+
+    }  // namespace Control
+}  // namespace OMVIS
@@ -22,6 +22,7 @@
 
 #include <SDL.h>
 
+#include <limits>
 #include <string>
 
 namespace OMVIS
@@ -35,9 +36,12 @@ namespace OMVIS
 
         JoystickDevice::JoystickDevice(const int joyID)
                 : _joystick(nullptr),
-                  _inputEvent(),
+                  _instanceId(-1),
                   _xDir(0),
                   _yDir(0),
+                  _buttons(0),
+                  _appliedXDir(0),
+                  _appliedYDir(0),
                   _joystickId(joyID)
         {
             //Initialize SDL
@@ -60,6 +64,10 @@ namespace OMVIS
                     LOGGER_WRITE(std::string("Unable to open joystick! SDL Error: ") + SDL_GetError(), Util::LC_LOADER,
                                  Util::LL_INFO);
                 }
+                else
+                {
+                    _instanceId = SDL_JoystickInstanceID(_joystick);
+                }
             }
         }
 
@@ -75,40 +83,68 @@ namespace OMVIS
          * SIMULATION METHODS
          *---------------------------------------*/
 
-        void JoystickDevice::detectContinuousInputEvents(std::shared_ptr<Model::InputData>& inputInfo)
+        bool JoystickDevice::handleEvent(const SDL_Event& event)
         {
-            SDL_PollEvent(&_inputEvent);
-
-            inputKey key;
+            if (nullptr == _joystick)
+            {
+                return false;
+            }
 
-            if (SDL_JOYAXISMOTION == _inputEvent.type)
+            if (SDL_JOYAXISMOTION == event.type && _instanceId == event.jaxis.which)
             {
-                //Motion on first joystick
-                if (_inputEvent.jaxis.which == _joystickId)
+                // Further axes are not mapped to inputs.
+                if (0 == event.jaxis.axis)
                 {
-                    //X axis motion
-                    if (0 == _inputEvent.jaxis.axis)
-                    {
-                        _xDir = _inputEvent.jaxis.value;
-                        key = inputKey(0 + (_joystickId * 2));
-                        //std::cout << "set x " << _joystickId << " to " << key << std::endl;
-                        inputInfo->setRealInputValueForInputKey(key, _xDir);
-                    }
-                    //Y axis motion
-                    else if (1 == _inputEvent.jaxis.axis)
+                    _xDir.store(event.jaxis.value, std::memory_order_relaxed);
+                }
+                else if (1 == event.jaxis.axis)
+                {
+                    _yDir.store(event.jaxis.value, std::memory_order_relaxed);
+                }
+                return true;
+            }
+            if ((SDL_JOYBUTTONDOWN == event.type || SDL_JOYBUTTONUP == event.type)
+                    && _instanceId == event.jbutton.which)
+            {
+                if (32 > event.jbutton.button)
+                {
+                    const std::uint32_t mask = std::uint32_t(1) << event.jbutton.button;
+                    if (SDL_PRESSED == event.jbutton.state)
                     {
-                        _yDir = _inputEvent.jaxis.value;
-                        key = inputKey(1 + (_joystickId * 2));
-                        //std::cout << "set y " << _joystickId << " to "<< key <<std::endl;
-                        inputInfo->setRealInputValueForInputKey(key, _yDir);
+                        _buttons.fetch_or(mask, std::memory_order_relaxed);
                     }
                     else
                     {
-                        _xDir = 0;
-                        _yDir = 0;
+                        _buttons.fetch_and(~mask, std::memory_order_relaxed);
                     }
                 }
+                return true;
             }
+            return false;
+        }
+
+        void JoystickDevice::applyInputs(std::shared_ptr<Model::InputData>& inputInfo)
+        {
+            const int xDir = _xDir.load(std::memory_order_relaxed);
+            if (xDir != _appliedXDir)
+            {
+                inputInfo->setRealInputValueForInputKey(inputKey(0 + (_joystickId * 2)), xDir);
+                _appliedXDir = xDir;
+            }
+
+            const int yDir = _yDir.load(std::memory_order_relaxed);
+            if (yDir != _appliedYDir)
+            {
+                inputInfo->setRealInputValueForInputKey(inputKey(1 + (_joystickId * 2)), yDir);
+                _appliedYDir = yDir;
+            }
+        }
+
+        void JoystickDevice::invalidateAppliedInputs()
+        {
+            // SDL axis values are 16 bit, thus, they never equal this value.
+            _appliedXDir = std::numeric_limits<int>::min();
+            _appliedYDir = std::numeric_limits<int>::min();
         }
 
         /*-----------------------------------------
@@ -117,12 +153,17 @@ namespace OMVIS
 
         int JoystickDevice::getXDir() const
         {
-            return _xDir;
+            return _xDir.load(std::memory_order_relaxed);
         }
 
         int JoystickDevice::getYDir() const
         {
-            return _yDir;
+            return _yDir.load(std::memory_order_relaxed);
+        }
+
+        bool JoystickDevice::isButtonPressed(const int button) const
+        {
+            return (0 <= button && 32 > button) && (0 != (_buttons.load(std::memory_order_relaxed) & (1u << button)));
         }
 
     }  // namespace Control
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Control/JoystickInputThread.hpp"
+#include "Util/Logger.hpp"
+
+#include <SDL.h>
+
+#include <string>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /// Time in ms the input thread waits for an event before it checks whether it has to stop.
+        static const int s_eventTimeout = 10;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        JoystickInputThread::JoystickInputThread()
+                : _joysticks(),
+                  _inputThread(),
+                  _isRunning(false)
+        {
+        }
+
+        JoystickInputThread::~JoystickInputThread()
+        {
+            stop();
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void JoystickInputThread::start(const std::vector<JoystickDevice*>& joysticks)
+        {
+            stop();
+            _joysticks = joysticks;
+            if (_joysticks.empty())
+            {
+                return;
+            }
+
+            _isRunning.store(true);
+            _inputThread = std::thread(&JoystickInputThread::run, this);
+            LOGGER_WRITE("Started input thread for " + std::to_string(_joysticks.size()) + " joystick(s).",
+                         Util::LC_CTR, Util::LL_DEBUG);
+        }
+
+        void JoystickInputThread::stop()
+        {
+            _isRunning.store(false);
+            if (_inputThread.joinable())
+            {
+                _inputThread.join();
+            }
+        }
+
+        /*-----------------------------------------
+         * GETTERS AND SETTERS
+         *---------------------------------------*/
+
+        bool JoystickInputThread::isRunning() const
+        {
+            return _isRunning.load();
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void JoystickInputThread::run()
+        {
+            SDL_Event event;
+            while (_isRunning.load())
+            {
+                // Drain all pending events before waiting again.
+                if (1 != SDL_WaitEventTimeout(&event, s_eventTimeout))
+                {
+                    continue;
+                }
+                do
+                {
+                    for (auto& joystick : _joysticks)
+                    {
+                        if (joystick->handleEvent(event))
+                        {
+                            break;
+                        }
+                    }
+                }
+                while (1 == SDL_PollEvent(&event));
+            }
+        }
+
+    }  // namespace Control
+}  // namespace OMVIS
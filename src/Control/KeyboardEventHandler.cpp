@@ -21,6 +21,7 @@
 #include "Model/InputData.hpp"
 #include "Util/Logger.hpp"
 
+#include <mutex>
 #include <string>
 
 namespace OMVIS
@@ -72,19 +73,20 @@ namespace OMVIS
                                             + std::to_string((int )iterValue._baseType),
                                     Util::LC_CTR, Util::LL_DEBUG);
                             int baseTypeIdx = static_cast<int>(iterValue._baseType);
+                            std::lock_guard<std::mutex> lock(_inputs->getMutex());
                             switch (baseTypeIdx)
                             {
                                 case (0):
-                                    _inputs->getInputValues()->_valuesReal[iterValue._valueIdx] = 1.0;
+                                    _inputs->setRealValue(iterValue._valueIdx, 1.0);
                                     break;
                                 case (1):
-                                    _inputs->getInputValues()->_valuesInteger[iterValue._valueIdx] = 1;
+                                    _inputs->setIntegerValue(iterValue._valueIdx, 1);
                                     break;
                                 case (2):
-                                    _inputs->getInputValues()->_valuesBoolean[iterValue._valueIdx] = 1;
+                                    _inputs->setBooleanValue(iterValue._valueIdx, 1);
                                     break;
                                 case (3):
-                                    _inputs->getInputValues()->_valuesString[iterValue._valueIdx] = "";
+                                    _inputs->setStringValue(iterValue._valueIdx, "");
                                     break;
                             }
                         }
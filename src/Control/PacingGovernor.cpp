@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Control/PacingGovernor.hpp"
+
+#include <algorithm>
+
+namespace OMVIS
+{
+    namespace Control
+    {
+
+        /// Default wall clock time the simulation may lag behind before frames are dropped.
+        static const double s_defaultMaxLag = 0.5;
+        /// Weight of the latest frame in the estimated costs of the solver.
+        static const double s_costSmoothing = 0.2;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        PacingGovernor::PacingGovernor()
+                : _targetRealTimeFactor(1.0),
+                  _maxLag(s_defaultMaxLag),
+                  _anchorSimTime(0.0),
+                  _anchorWallTime(0.0),
+                  _lag(0.0),
+                  _cost(0.0),
+                  _numDroppedFrames(0)
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void PacingGovernor::reset(const double simTime, const double wallTime)
+        {
+            _anchorSimTime = simTime;
+            _anchorWallTime = wallTime;
+            _lag = 0.0;
+        }
+
+        /*-----------------------------------------
+         * GETTERS and SETTERS
+         *---------------------------------------*/
+
+        double PacingGovernor::getTargetRealTimeFactor() const
+        {
+            return _targetRealTimeFactor;
+        }
+
+        void PacingGovernor::setTargetRealTimeFactor(const double rtf)
+        {
+            _targetRealTimeFactor = rtf;
+        }
+
+        double PacingGovernor::getMaxLag() const
+        {
+            return _maxLag;
+        }
+
+        void PacingGovernor::setMaxLag(const double maxLag)
+        {
+            _maxLag = maxLag;
+        }
+
+        double PacingGovernor::getLag() const
+        {
+            return _lag;
+        }
+
+        size_t PacingGovernor::getNumDroppedFrames() const
+        {
+            return _numDroppedFrames;
+        }
+
+        double PacingGovernor::getCost() const
+        {
+            return _cost;
+        }
+
+        double PacingGovernor::getDueSimTime(const double wallTime) const
+        {
+            return _anchorSimTime + (wallTime - _anchorWallTime) * _targetRealTimeFactor;
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        double PacingGovernor::planFrame(const double simTime, const double wallTime, const double frameInterval)
+        {
+            const double dueSimTime = getDueSimTime(wallTime);
+            if (simTime > dueSimTime)
+            {
+                _lag = 0.0;
+                return simTime;
+            }
+
+            // Give up catching up and skip the lost wall clock time. The measured lag is kept for reporting.
+            _lag = (dueSimTime - simTime) / _targetRealTimeFactor;
+            if (_lag > _maxLag)
+            {
+                _numDroppedFrames += static_cast<size_t>(_lag / frameInterval);
+                _anchorSimTime = simTime;
+                _anchorWallTime = wallTime;
+            }
+
+            double nextSimTime = getDueSimTime(wallTime + frameInterval);
+            if (0.0 < _cost)
+            {
+                nextSimTime = std::min(nextSimTime, simTime + frameInterval / _cost);
+            }
+            return nextSimTime;
+        }
+
+        void PacingGovernor::finishFrame(const double simSpan, const double duration)
+        {
+            if (0.0 >= simSpan)
+            {
+                return;
+            }
+            const double cost = duration / simSpan;
+            _cost = (0.0 == _cost) ? cost : (1.0 - s_costSmoothing) * _cost + s_costSmoothing * cost;
+        }
+
+    }  // namespace Control
+}  // namespace OMVIS
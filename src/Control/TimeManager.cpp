@@ -36,6 +36,8 @@ namespace OMVIS
                 : _simTime(simTime),
                   _realTime(realTime),
                   _realTimeFactor(realTimeFactor),
+                  _lag(0.0),
+                  _numDroppedFrames(0),
                   _visTime(visTime),
                   _hVisual(hVisual),
                   _startTime(startTime),
@@ -145,6 +147,26 @@ namespace OMVIS
             _realTimeFactor = rtf;
         }
 
+        double TimeManager::getLag() const
+        {
+            return _lag;
+        }
+
+        void TimeManager::setLag(const double lag)
+        {
+            _lag = lag;
+        }
+
+        size_t TimeManager::getNumDroppedFrames() const
+        {
+            return _numDroppedFrames;
+        }
+
+        void TimeManager::setNumDroppedFrames(const size_t numDroppedFrames)
+        {
+            _numDroppedFrames = numDroppedFrames;
+        }
+
         bool TimeManager::isPaused() const
         {
             return _pause;
@@ -39,6 +39,9 @@ namespace OMVIS
                   modelFile(),
                   modelPath(),
                   wDir(),
+                  ensembleSize(1),
+                  headless(false),
+                  numFrames(0),
                   logSet()
         {
         }
@@ -49,7 +52,9 @@ namespace OMVIS
 
         VisualizationConstructionPlan CommandLineArgs::getVisualizationConstructionPlan() const
         {
-            return VisualizationConstructionPlan(modelFile, modelPath);
+            VisualizationConstructionPlan result(modelFile, modelPath);
+            result.ensembleSize = static_cast<size_t>(ensembleSize);
+            return result;
         }
 
         RemoteVisualizationConstructionPlan CommandLineArgs::getRemoteVisualizationConstructionPlan() const
@@ -97,6 +102,9 @@ namespace OMVIS
                 cout << "  Model File: " << modelFile << endl;
                 cout << "  Model Path: " << modelPath << endl;
                 cout << "  Working Directory: " << wDir << endl;
+                cout << "  Ensemble Size: " << ensembleSize << endl;
+                cout << "  Headless: " << Util::boolToString(headless) << endl;
+                cout << "  Frames: " << numFrames << endl;
                 logSet.print();
             }
         }
@@ -142,6 +150,12 @@ namespace OMVIS
                         "port", boost::program_options::value<int>(), "Port to use for remote visualization.")(
                         "wdir", boost::program_options::value<std::string>(),
                         "Local working directory for remote visualization.")(
+                        "ensemble", boost::program_options::value<int>(),
+                        "Number of FMU instances with perturbed initial states which are simulated in parallel.")(
+                        "headless", "Runs the visualization without window and rendering as fast as possible and "
+                        "reports the timings of the scene updates.")(
+                        "frames", boost::program_options::value<int>(),
+                        "Number of frames of a headless run. By default, it runs up to the end time.")(
                         "loggerSettings,l", po::value<std::vector<std::string> >(),
                         "Specification of the logging information.\n"
                         "Available categories: loader, controller, viewer, solver, other.\n"
@@ -164,6 +178,9 @@ namespace OMVIS
                         cout << "Remote Visualization: OMVIS --host=HOSTNAME --port=PORT --model=BouncingBall.fmu "
                              "--path=/PATH/TO/BOUNCINGBALL/ --wdir=/PATH/TO/WORKINGDIR/"
                              << endl;
+                        cout << "  Headless Benchmark: OMVIS --headless --frames=1000 --model=BouncingBall.fmu "
+                             "--path=/PATH/TO/BOUNCINGBALL/"
+                             << endl;
                         cout << "\n" << endl;
                         cout << "OMVIS - An open source tool for model and simulation visualization" << endl;
                         cout << "\n" << endl;
@@ -237,6 +254,21 @@ namespace OMVIS
                         result.wDir = vm["wdir"].as<std::string>();
                     }
 
+                    if (0u != vm.count("ensemble"))
+                    {
+                        result.ensembleSize = vm["ensemble"].as<int>();
+                    }
+
+                    if (0u != vm.count("headless"))
+                    {
+                        result.headless = true;
+                    }
+
+                    if (0u != vm.count("frames"))
+                    {
+                        result.numFrames = vm["frames"].as<int>();
+                    }
+
                 }
                 catch (po::error& e)
                 {
@@ -277,6 +309,16 @@ namespace OMVIS
                 }
             }
 
+            if (1 > clArgs.ensembleSize)
+            {
+                throw std::runtime_error("An ensemble needs at least one member. Use --ensemble=N with N > 0.");
+            }
+
+            if (0 > clArgs.numFrames)
+            {
+                throw std::runtime_error("The number of frames must not be negative. Use --frames=N with N >= 0.");
+            }
+
             // We assume the user wants remote visualization if one of the following parameter is specified:
             // host, port, wdir.
             bool remoteVis = !clArgs.hostAddress.empty() || -1 < clArgs.port || !clArgs.wDir.empty();
@@ -20,6 +20,8 @@
 #include "Model/VisualizerFMU.hpp"
 #include "Model/VisualizerFMUClient.hpp"
 #include "Model/VisualizerMAT.hpp"
+#include "Model/VisualizerMATClient.hpp"
+#include "Model/VisualizerCSV.hpp"
 #include "Initialization/Factory.hpp"
 #include "Util/Logger.hpp"
 
@@ -60,7 +62,8 @@ namespace OMVIS
             // FMU based visualization
             if (cP->visType == Model::VisType::FMU)
             {
-                result = std::shared_ptr<Model::VisualizerAbstract>(new Model::VisualizerFMU(cP->modelFile, cP->path));
+                result = std::shared_ptr<Model::VisualizerAbstract>(
+                        new Model::VisualizerFMU(cP->modelFile, cP->path, cP->ensembleSize));
                 LOGGER_WRITE("Initialize VisualizerFMU.", Util::LC_LOADER, Util::LL_DEBUG);
             }
             // MAT file based visualization
@@ -69,6 +72,12 @@ namespace OMVIS
                 result = std::shared_ptr<Model::VisualizerAbstract>(new Model::VisualizerMAT(cP->modelFile, cP->path));
                 LOGGER_WRITE("Initialize VisualizerMAT.", Util::LC_LOADER, Util::LL_DEBUG);
             }
+            // CSV file based visualization
+            else if (cP->visType == Model::VisType::CSV)
+            {
+                result = std::shared_ptr<Model::VisualizerAbstract>(new Model::VisualizerCSV(cP->modelFile, cP->path));
+                LOGGER_WRITE("Initialize VisualizerCSV.", Util::LC_LOADER, Util::LL_DEBUG);
+            }
             // FMU based remote visualization
             else if (cP->visType == Model::VisType::FMU_REMOTE)
             {
@@ -77,12 +86,11 @@ namespace OMVIS
                 LOGGER_WRITE("Initialize VisualizerFMUClient.", Util::LC_LOADER, Util::LL_DEBUG);
             }
             // MAT file based remote visualization
-            /// \todo Todo Implement OMVisualizerMATClient!
             else if (cP->visType == Model::VisType::MAT_REMOTE)
             {
-                // result = std::shared_ptr<Model::OMVisualizerAbstract> (new Model::OMVisualizerMATClient(cP.modelFile, cP.workingDirectory));
-                LOGGER_WRITE("Initialize VisualizerMATClient. Argh, wait. This is not yet implemented!!!", Util::LC_LOADER,
-                             Util::LL_ERROR);
+                result = std::shared_ptr<Model::VisualizerAbstract>(
+                        new Model::VisualizerMATClient(dynamic_cast<const RemoteVisualizationConstructionPlan*>(cP)));
+                LOGGER_WRITE("Initialize VisualizerMATClient.", Util::LC_LOADER, Util::LL_DEBUG);
             }
             else
             {
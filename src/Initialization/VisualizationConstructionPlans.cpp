@@ -27,7 +27,8 @@ namespace OMVIS
         VisualizationConstructionPlan::VisualizationConstructionPlan()
                 : visType(Model::VisType::NONE),
                   modelFile(""),
-                  path("")
+                  path(""),
+                  ensembleSize(1)
         {
         }
 
@@ -35,7 +36,8 @@ namespace OMVIS
                                                                      const std::string& pathIn)
                 : visType(Model::VisType::NONE),
                   modelFile(modelFileIn),
-                  path(pathIn)
+                  path(pathIn),
+                  ensembleSize(1)
         {
             if (modelFileIn.empty())
             {
@@ -55,6 +57,10 @@ namespace OMVIS
             {
                 visType = Model::VisType::MAT;
             }
+            else if (Util::isCSV(modelFile))
+            {
+                visType = Model::VisType::CSV;
+            }
             else
             {
                 throw std::invalid_argument("VisualizationType is NONE.");
@@ -40,6 +40,14 @@ int main(int argc, char* argv[])
         Util::Logger::initialize(clArgs.logSet);
         Util::Logger logger = Util::Logger::getInstance();
 
+        // Benchmark runs skip the GUI entirely.
+        if (clArgs.headless)
+        {
+            Control::HeadlessRunner runner(clArgs);
+            runner.run();
+            return 0;
+        }
+
         LOGGER_WRITE("Okay, let's create the main widget...", Util::LC_OTHER, Util::LL_INFO);
         QApplication app(argc, argv);
 
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatFileServer.hpp"
+#include "Util/Logger.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace OMVIS;
+
+/*! \brief Serves the MAT result files in a directory to remote visualizations.
+ *
+ * Usage: OMVISMatServer <rootDir> <port>
+ */
+int main(int argc, char* argv[])
+{
+    if (3 != argc)
+    {
+        std::cerr << "Usage: " << argv[0] << " <rootDir> <port>" << std::endl;
+        return -1;
+    }
+
+    try
+    {
+        Util::LogSettings logSettings;
+        logSettings.setAll(Util::LL_INFO);
+        Util::Logger::initialize(logSettings);
+
+        Model::MatFileServer server(argv[1], static_cast<unsigned short>(std::stoi(argv[2])));
+        server.run();
+    }
+    catch (std::exception& ex)
+    {
+        LOGGER_WRITE("Execution failed. Error: " + std::string(ex.what()), Util::LC_OTHER, Util::LL_ERROR);
+        return -1;
+    }
+
+    return 0;
+}
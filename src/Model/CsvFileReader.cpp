@@ -0,0 +1,484 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/CsvFileReader.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Powers of ten that are exactly representable as double.
+        static const double s_powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                                1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+        /*! \brief Returns the first character in [p, end) outside of double quotes that satisfies isDelimiter or end.
+         *
+         * OMC quotes names of matrix elements, e.g., "body.R.T[1,1]", which contain commas.
+         */
+        template <typename Predicate>
+        static const char* findUnquoted(const char* p, const char* end, Predicate isDelimiter)
+        {
+            bool isQuoted = false;
+            for (; p < end; ++p)
+            {
+                if ('"' == *p)
+                {
+                    isQuoted = !isQuoted;
+                }
+                else if (!isQuoted && isDelimiter(*p))
+                {
+                    break;
+                }
+            }
+            return p;
+        }
+
+        /*! \brief Returns the start of the field that follows numFields delimiters after p or end, if the line is
+         *         too short.
+         *
+         * With SSE2, 16 characters are compared to the delimiter at once.
+         */
+        static const char* skipFields(const char* p, const char* end, const char delimiter, size_t numFields)
+        {
+            if (0 == numFields)
+            {
+                return p;
+            }
+#ifdef __SSE2__
+            const __m128i delim = _mm_set1_epi8(delimiter);
+            while (p + 16 <= end)
+            {
+                __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, delim)));
+                size_t count = static_cast<size_t>(__builtin_popcount(mask));
+                if (count >= numFields)
+                {
+                    // Drop the delimiters before the wanted one.
+                    for (size_t i = 1; i < numFields; ++i)
+                    {
+                        mask &= mask - 1;
+                    }
+                    return p + __builtin_ctz(mask) + 1;
+                }
+                numFields -= count;
+                p += 16;
+            }
+#endif
+            for (; p < end; ++p)
+            {
+                if (delimiter == *p && 0 == --numFields)
+                {
+                    return p + 1;
+                }
+            }
+            return end;
+        }
+
+        /*! \brief Returns true, if the line between p and end contains no data. */
+        static bool isEmptyLine(const char* p, const char* end)
+        {
+            return (p == end) || (p + 1 == end && '\r' == *p);
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        CsvFileReader::CsvFileReader()
+                : _file(),
+                  _delimiter(','),
+                  _columnNames(),
+                  _columnIndices(),
+                  _chunks(),
+                  _numRows(0)
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void CsvFileReader::open(const std::string& fileName)
+        {
+            close();
+
+            try
+            {
+                _file.open(fileName);
+            }
+            catch (std::exception& ex)
+            {
+                throw std::runtime_error("Could not map CSV file " + fileName + ": " + ex.what());
+            }
+
+            size_t dataOffset = parseHeader();
+            splitChunks(dataOffset);
+
+            if (_columnNames.empty() || 0 == _numRows)
+            {
+                close();
+                throw std::runtime_error("The file " + fileName + " is not a valid CSV result file.");
+            }
+        }
+
+        void CsvFileReader::close()
+        {
+            if (_file.is_open())
+            {
+                _file.close();
+            }
+            _columnNames.clear();
+            _columnIndices.clear();
+            _chunks.clear();
+            _numRows = 0;
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool CsvFileReader::isOpen() const
+        {
+            return _file.is_open();
+        }
+
+        int CsvFileReader::findColumn(const std::string& name) const
+        {
+            auto it = _columnIndices.find(name);
+            return (_columnIndices.end() == it) ? -1 : static_cast<int>(it->second);
+        }
+
+        size_t CsvFileReader::getNumColumns() const
+        {
+            return _columnNames.size();
+        }
+
+        size_t CsvFileReader::getNumRows() const
+        {
+            return _numRows;
+        }
+
+        size_t CsvFileReader::getTimeColumn() const
+        {
+            int column = findColumn("time");
+            return (0 > column) ? 0 : static_cast<size_t>(column);
+        }
+
+        void CsvFileReader::readColumns(const std::vector<size_t>& columns, double* times,
+                                        const std::vector<float*>& out) const
+        {
+            if (columns.size() != out.size())
+            {
+                throw std::invalid_argument("One output buffer per column is required.");
+            }
+
+            std::vector<ColumnTarget> targets;
+            targets.push_back({getTimeColumn(), times, nullptr});
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                if (columns[i] >= _columnNames.size())
+                {
+                    throw std::out_of_range("Requested column is not contained in CSV file.");
+                }
+                targets.push_back({columns[i], nullptr, out[i]});
+            }
+            std::stable_sort(targets.begin(), targets.end(), [](const ColumnTarget& a, const ColumnTarget& b)
+            {
+                return a.column < b.column;
+            });
+
+            std::vector<std::future<void>> workers;
+            for (const auto& chunk : _chunks)
+            {
+                workers.push_back(std::async(std::launch::async, &CsvFileReader::parseChunk, this, std::cref(chunk),
+                                             std::cref(targets)));
+            }
+            // Rethrows the exceptions of the workers.
+            for (auto& w : workers)
+            {
+                w.get();
+            }
+        }
+
+        bool CsvFileReader::parseNumber(const char*& p, const char* end, double& value)
+        {
+            while (p < end && (' ' == *p || '"' == *p))
+            {
+                ++p;
+            }
+            const char* start = p;
+
+            bool isNegative = false;
+            if (p < end && ('-' == *p || '+' == *p))
+            {
+                isNegative = ('-' == *p);
+                ++p;
+            }
+
+            // Accumulate up to 19 significant digits, the remaining digits only shift the exponent.
+            uint64_t mantissa = 0;
+            int numDigits = 0;
+            int exponent = 0;
+            bool hasDigits = false;
+            for (; p < end && '0' <= *p && '9' >= *p; ++p)
+            {
+                hasDigits = true;
+                if (19 > numDigits)
+                {
+                    mantissa = 10 * mantissa + static_cast<uint64_t>(*p - '0');
+                    numDigits += (0 < mantissa) ? 1 : 0;
+                }
+                else
+                {
+                    ++exponent;
+                }
+            }
+            if (p < end && '.' == *p)
+            {
+                for (++p; p < end && '0' <= *p && '9' >= *p; ++p)
+                {
+                    hasDigits = true;
+                    if (19 > numDigits)
+                    {
+                        mantissa = 10 * mantissa + static_cast<uint64_t>(*p - '0');
+                        numDigits += (0 < mantissa) ? 1 : 0;
+                        --exponent;
+                    }
+                }
+            }
+            if (hasDigits && p < end && ('e' == *p || 'E' == *p))
+            {
+                const char* expStart = p;
+                ++p;
+                bool isExpNegative = false;
+                if (p < end && ('-' == *p || '+' == *p))
+                {
+                    isExpNegative = ('-' == *p);
+                    ++p;
+                }
+                int exp = 0;
+                bool hasExpDigits = false;
+                for (; p < end && '0' <= *p && '9' >= *p; ++p)
+                {
+                    hasExpDigits = true;
+                    exp = std::min(10 * exp + (*p - '0'), 100000);
+                }
+                if (hasExpDigits)
+                {
+                    exponent += isExpNegative ? -exp : exp;
+                }
+                else
+                {
+                    p = expStart;
+                }
+            }
+
+            // Fast path: the mantissa and the power of ten are exact, thus, the result is correctly rounded.
+            if (hasDigits && (uint64_t(1) << 53) >= mantissa && -22 <= exponent && 22 >= exponent)
+            {
+                double val = static_cast<double>(mantissa);
+                val = (0 > exponent) ? val / s_powersOfTen[-exponent] : val * s_powersOfTen[exponent];
+                value = isNegative ? -val : val;
+                return true;
+            }
+
+            // Slow path: copy the field to a terminated buffer and let strtod handle it.
+            char buffer[64];
+            size_t length = 0;
+            for (p = start; p < end && length + 1 < sizeof(buffer) && ',' != *p && ';' != *p && '\t' != *p
+                    && '"' != *p && '\r' != *p; ++p)
+            {
+                buffer[length++] = *p;
+            }
+            buffer[length] = '\0';
+            char* parsedEnd = nullptr;
+            value = std::strtod(buffer, &parsedEnd);
+            p = start + (parsedEnd - buffer);
+            return parsedEnd != buffer;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        size_t CsvFileReader::parseHeader()
+        {
+            const char* data = _file.data();
+            const char* end = data + _file.size();
+            const char* lineEnd = static_cast<const char*>(std::memchr(data, '\n', _file.size()));
+            if (nullptr == lineEnd)
+            {
+                lineEnd = end;
+            }
+
+            // The delimiter is the first of comma, semicolon and tab that occurs in the header.
+            const char* delim = findUnquoted(data, lineEnd, [](const char c)
+            {
+                return ',' == c || ';' == c || '\t' == c;
+            });
+            _delimiter = (lineEnd == delim) ? ',' : *delim;
+
+            const char delimiter = _delimiter;
+            for (const char* p = data; p <= lineEnd && p < end;)
+            {
+                const char* fieldEnd = findUnquoted(p, lineEnd, [delimiter](const char c)
+                {
+                    return delimiter == c;
+                });
+                std::string name(p, fieldEnd);
+
+                // Strip blanks, carriage returns and quotes.
+                name.erase(0, name.find_first_not_of(" \"\r"));
+                name.erase(name.find_last_not_of(" \"\r") + 1);
+
+                _columnIndices.emplace(name, _columnNames.size());
+                _columnNames.push_back(name);
+                p = fieldEnd + 1;
+            }
+
+            return std::min(static_cast<size_t>(lineEnd - data) + 1, _file.size());
+        }
+
+        void CsvFileReader::splitChunks(const size_t dataOffset)
+        {
+            const char* data = _file.data();
+            const size_t size = _file.size();
+
+            // Each chunk starts at the beginning of a line.
+            size_t numChunks = std::max(1u, std::thread::hardware_concurrency());
+            numChunks = std::max<size_t>(1, std::min(numChunks, (size - dataOffset) / (1 << 16)));
+            std::vector<size_t> bounds(1, dataOffset);
+            for (size_t i = 1; i < numChunks; ++i)
+            {
+                size_t pos = std::max(bounds.back(), dataOffset + i * (size - dataOffset) / numChunks);
+                const char* nl = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+                pos = (nullptr == nl) ? size : static_cast<size_t>(nl - data) + 1;
+                if (pos > bounds.back() && pos < size)
+                {
+                    bounds.push_back(pos);
+                }
+            }
+            bounds.push_back(size);
+
+            _chunks.resize(bounds.size() - 1);
+            for (size_t i = 0; i < _chunks.size(); ++i)
+            {
+                _chunks[i].begin = bounds[i];
+                _chunks[i].end = bounds[i + 1];
+                _chunks[i].firstRow = 0;
+                _chunks[i].numRows = 0;
+            }
+
+            // Count the non-empty lines of all chunks in parallel. memchr scans many characters at once.
+            auto countRows = [data](Chunk& chunk)
+            {
+                const char* p = data + chunk.begin;
+                const char* end = data + chunk.end;
+                while (p < end)
+                {
+                    const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                    if (nullptr == lineEnd)
+                    {
+                        lineEnd = end;
+                    }
+                    if (!isEmptyLine(p, lineEnd))
+                    {
+                        ++chunk.numRows;
+                    }
+                    p = lineEnd + 1;
+                }
+            };
+            std::vector<std::future<void>> workers;
+            for (auto& chunk : _chunks)
+            {
+                workers.push_back(std::async(std::launch::async, countRows, std::ref(chunk)));
+            }
+            for (auto& w : workers)
+            {
+                w.get();
+            }
+
+            _numRows = 0;
+            for (auto& chunk : _chunks)
+            {
+                chunk.firstRow = _numRows;
+                _numRows += chunk.numRows;
+            }
+        }
+
+        void CsvFileReader::parseChunk(const Chunk& chunk, const std::vector<ColumnTarget>& targets) const
+        {
+            const char* p = _file.data() + chunk.begin;
+            const char* end = _file.data() + chunk.end;
+            size_t row = chunk.firstRow;
+
+            while (p < end)
+            {
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                if (nullptr == lineEnd)
+                {
+                    lineEnd = end;
+                }
+                if (!isEmptyLine(p, lineEnd))
+                {
+                    // Jump from one requested field to the next one. Fields in between are not parsed.
+                    const char* field = p;
+                    size_t column = 0;
+                    for (const auto& target : targets)
+                    {
+                        field = skipFields(field, lineEnd, _delimiter, target.column - column);
+                        column = target.column;
+
+                        const char* q = field;
+                        double value;
+                        if (lineEnd == field || !parseNumber(q, lineEnd, value))
+                        {
+                            throw std::runtime_error("Invalid value in column " + _columnNames[column] + " of row "
+                                                     + std::to_string(row + 1) + " in CSV file.");
+                        }
+                        if (nullptr != target.times)
+                        {
+                            target.times[row] = value;
+                        }
+                        else
+                        {
+                            target.values[row] = static_cast<float>(value);
+                        }
+                    }
+                    ++row;
+                }
+                p = lineEnd + 1;
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/FMUCache.hpp"
+#include "Util/Hash.hpp"
+#include "Util/Logger.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Identifies a manifest file.
+        static const char s_manifestMagic[8] = {'O', 'M', 'V', 'I', 'S', 'F', 'C', '\0'};
+        /// Increment whenever the layout of an entry changes.
+        static const uint32_t s_cacheVersion = 1;
+        /// Name of the manifest file of an entry.
+        static const std::string s_manifestFileName = "omvis.manifest";
+        /// Default maximum number of entries. Extracted FMUs may take hundreds of megabytes each.
+        static const size_t s_defaultMaxNumEntries = 8;
+        /// Maximum length of the strings of a manifest.
+        static const uint32_t s_maxStringLength = 4096;
+
+        /// Size of the end of central directory record of a ZIP archive without comment.
+        static const size_t s_eocdSize = 22;
+        /// Maximum size of the comment of a ZIP archive.
+        static const size_t s_maxCommentSize = 65535;
+        /// Number of bytes hashed at once if the whole file is hashed.
+        static const size_t s_hashChunkSize = 1 << 20;
+
+        static uint32_t readUInt32LE(const unsigned char* data)
+        {
+            return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8)
+                    | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+        }
+
+        static void writeString(std::ofstream& stream, const std::string& str)
+        {
+            uint32_t length = static_cast<uint32_t>(str.size());
+            stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            stream.write(str.data(), length);
+        }
+
+        static bool readString(std::ifstream& stream, std::string& str)
+        {
+            uint32_t length = 0;
+            stream.read(reinterpret_cast<char*>(&length), sizeof(length));
+            if (!stream || s_maxStringLength < length)
+            {
+                return false;
+            }
+            str.resize(length);
+            stream.read(&str[0], length);
+            return static_cast<bool>(stream);
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        FMUCache::FMUCache()
+                : FMUCache(getDefaultDirectory(), s_defaultMaxNumEntries)
+        {
+        }
+
+        FMUCache::FMUCache(const std::string& directory, const size_t maxNumEntries)
+                : _directory(directory),
+                  _maxNumEntries(std::max<size_t>(maxNumEntries, 1))
+        {
+            if (!_directory.empty() && '/' != _directory.back() && '\\' != _directory.back())
+            {
+                _directory += "/";
+            }
+            boost::system::error_code ec;
+            boost::filesystem::create_directories(_directory, ec);
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        std::string FMUCache::getDefaultDirectory()
+        {
+            return (boost::filesystem::temp_directory_path() / "omvis-fmu-cache").string();
+        }
+
+        uint64_t FMUCache::computeKey(const std::string& fmuFileName)
+        {
+            std::ifstream fmu(fmuFileName, std::ios::binary);
+            if (!fmu)
+            {
+                throw std::runtime_error("Could not read FMU file " + fmuFileName + ".");
+            }
+            uint64_t size = boost::filesystem::file_size(fmuFileName);
+            uint64_t key = Util::hashValue(s_cacheVersion);
+            key = Util::hashValue(size, key);
+
+            // The end of central directory record is located at the end of the archive, followed by the comment.
+            const uint64_t tailSize = std::min<uint64_t>(size, s_eocdSize + s_maxCommentSize);
+            std::vector<unsigned char> tail(static_cast<size_t>(tailSize));
+            fmu.seekg(size - tail.size());
+            fmu.read(reinterpret_cast<char*>(tail.data()), tail.size());
+            for (size_t pos = tail.size(); fmu && pos >= s_eocdSize; --pos)
+            {
+                const unsigned char* eocd = tail.data() + pos - s_eocdSize;
+                if (0x06054b50 != readUInt32LE(eocd))
+                {
+                    continue;
+                }
+                // ZIP64 archives mark the fields as 0xFFFFFFFF, they are hashed completely.
+                const uint64_t cdSize = readUInt32LE(eocd + 12);
+                const uint64_t cdOffset = readUInt32LE(eocd + 16);
+                const uint64_t eocdOffset = size - tail.size() + pos - s_eocdSize;
+                if (0 < cdSize && 0xFFFFFFFF != cdOffset && cdOffset + cdSize <= eocdOffset)
+                {
+                    std::vector<char> centralDirectory(static_cast<size_t>(cdSize));
+                    fmu.seekg(cdOffset);
+                    fmu.read(centralDirectory.data(), centralDirectory.size());
+                    if (fmu)
+                    {
+                        return Util::hashBytes(centralDirectory.data(), centralDirectory.size(), key);
+                    }
+                }
+                break;
+            }
+
+            LOGGER_WRITE("No ZIP central directory found in " + fmuFileName + ". Hash the whole file.",
+                         Util::LC_LOADER, Util::LL_WARNING);
+            fmu.clear();
+            fmu.seekg(0);
+            std::vector<char> buffer(s_hashChunkSize);
+            while (fmu.read(buffer.data(), buffer.size()) || 0 < fmu.gcount())
+            {
+                key = Util::hashBytes(buffer.data(), static_cast<size_t>(fmu.gcount()), key);
+            }
+            return key;
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        const std::string& FMUCache::getDirectory() const
+        {
+            return _directory;
+        }
+
+        std::string FMUCache::getEntryPath(const uint64_t key) const
+        {
+            char name[17];
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+            return _directory + name + "/";
+        }
+
+        size_t FMUCache::getNumEntries() const
+        {
+            size_t numEntries = 0;
+            boost::system::error_code ec;
+            for (boost::filesystem::directory_iterator it(_directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                if (boost::filesystem::exists(it->path() / s_manifestFileName))
+                {
+                    ++numEntries;
+                }
+            }
+            return numEntries;
+        }
+
+        /*-----------------------------------------
+         * ENTRIES
+         *---------------------------------------*/
+
+        bool FMUCache::lookup(const uint64_t key, FMUManifest& manifest) const
+        {
+            const std::string fileName = getManifestFileName(key);
+            std::ifstream stream(fileName, std::ios::binary);
+            if (!stream)
+            {
+                return false;
+            }
+
+            char magic[sizeof(s_manifestMagic)];
+            uint32_t version = 0;
+            stream.read(magic, sizeof(magic));
+            stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+            stream.read(reinterpret_cast<char*>(&manifest.fmiVersion), sizeof(manifest.fmiVersion));
+            if (!stream || 0 != std::memcmp(magic, s_manifestMagic, sizeof(magic)) || s_cacheVersion != version
+                    || !readString(stream, manifest.guid) || !readString(stream, manifest.modelIdentifier))
+            {
+                return false;
+            }
+            stream.close();
+
+            // The modification time of the manifest orders the entries by their last use.
+            boost::system::error_code ec;
+            boost::filesystem::last_write_time(fileName, std::time(nullptr), ec);
+            return true;
+        }
+
+        std::string FMUCache::beginEntry(const uint64_t key) const
+        {
+            const std::string path = getEntryPath(key);
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(path, ec);
+            boost::filesystem::create_directories(path, ec);
+            if (ec)
+            {
+                throw std::runtime_error("Could not create the FMU cache entry " + path + ": " + ec.message());
+            }
+            return path;
+        }
+
+        void FMUCache::commitEntry(const uint64_t key, const FMUManifest& manifest) const
+        {
+            // The manifest is renamed after it has been written. Thus, an incomplete manifest is never picked up.
+            const std::string fileName = getManifestFileName(key);
+            const std::string tmpFileName = fileName + ".tmp";
+            std::ofstream stream(tmpFileName, std::ios::binary | std::ios::trunc);
+            stream.write(s_manifestMagic, sizeof(s_manifestMagic));
+            stream.write(reinterpret_cast<const char*>(&s_cacheVersion), sizeof(s_cacheVersion));
+            stream.write(reinterpret_cast<const char*>(&manifest.fmiVersion), sizeof(manifest.fmiVersion));
+            writeString(stream, manifest.guid);
+            writeString(stream, manifest.modelIdentifier);
+            stream.close();
+            if (!stream || 0 != std::rename(tmpFileName.c_str(), fileName.c_str()))
+            {
+                std::remove(tmpFileName.c_str());
+                throw std::runtime_error("Could not write the FMU cache manifest " + fileName + ".");
+            }
+
+            evict(key);
+        }
+
+        void FMUCache::removeEntry(const uint64_t key) const
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(getEntryPath(key), ec);
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        std::string FMUCache::getManifestFileName(const uint64_t key) const
+        {
+            return getEntryPath(key) + s_manifestFileName;
+        }
+
+        void FMUCache::evict(const uint64_t key) const
+        {
+            const boost::filesystem::path current = boost::filesystem::path(getEntryPath(key)).parent_path();
+            std::vector<std::pair<std::time_t, boost::filesystem::path>> entries;
+            boost::system::error_code ec;
+            for (boost::filesystem::directory_iterator it(_directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                boost::system::error_code timeEc;
+                std::time_t lastUse = boost::filesystem::last_write_time(it->path() / s_manifestFileName, timeEc);
+                if (!timeEc && current.filename() != it->path().filename())
+                {
+                    entries.emplace_back(lastUse, it->path());
+                }
+            }
+            if (entries.size() < _maxNumEntries)
+            {
+                return;
+            }
+
+            // The current entry is kept in any case.
+            std::sort(entries.begin(), entries.end());
+            for (size_t i = 0; i + _maxNumEntries <= entries.size(); ++i)
+            {
+                LOGGER_WRITE("Remove FMU cache entry " + entries[i].second.string() + ".", Util::LC_LOADER,
+                             Util::LL_DEBUG);
+                boost::filesystem::remove_all(entries[i].second, ec);
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
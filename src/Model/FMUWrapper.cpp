@@ -17,18 +17,59 @@
  * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Model/FMUCache.hpp"
 #include "Util/Logger.hpp"
+#include "Util/LinearSolver.hpp"
 #include "Util/Util.hpp"
 #include <FMI/fmi_import_util.h>
 #include <Model/FMUWrapper.hpp>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        /// Maximum number of stages of the implemented Runge-Kutta methods.
+        static const size_t s_maxNumStages = 7;
+
+        /// Coefficients of the Dormand-Prince method. The last stage is evaluated at the solution of order 5.
+        static const fmi1_real_t s_dpC[s_maxNumStages] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+        static const fmi1_real_t s_dpA[s_maxNumStages][s_maxNumStages - 1] = {
+                {},
+                {1.0 / 5.0},
+                {3.0 / 40.0, 9.0 / 40.0},
+                {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+                {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+                {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+                {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}};
+        /// Difference of the weights of the solutions of order 5 and 4, i.e., the weights of the error estimate.
+        static const fmi1_real_t s_dpE[s_maxNumStages] = {71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+                                                          -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+
+        /// Bounds of the factor by which the adaptive step size changes from one step to the next.
+        static const fmi1_real_t s_minStepFactor = 0.2;
+        static const fmi1_real_t s_maxStepFactor = 5.0;
+        /// Smallest step size the adaptive solver reduces the step to.
+        static const fmi1_real_t s_minStepSize = 1.0e-10;
+
+        /// Maximum number of Newton iterations of the implicit Euler method before the Jacobian is updated.
+        static const size_t s_maxNewtonIterations = 5;
+
+        /// Maximum number of iterations of the event localization.
+        static const size_t s_maxEventIterations = 50;
+
+        /// Returns true, if an event indicator changed its domain, i.e., z > 0 or z <= 0, between the given values.
+        static bool isCrossing(const fmi1_real_t before, const fmi1_real_t after)
+        {
+            return (0.0 < before) != (0.0 < after);
+        }
+
         void doExit()
         {
             //printf("Press 'Enter' to exit\n");
@@ -46,7 +87,21 @@ namespace OMVIS
                   _context(nullptr),
                   _callbacks(),
                   _callBackFunctions(),
-                  _fmuData()
+                  _fmuData(),
+                  _statesStart(),
+                  _stages(),
+                  _statesTmp(),
+                  _indicatorsLow(),
+                  _indicatorsHigh(),
+                  _indicatorsMid(),
+                  _jacobian(),
+                  _jacobianPattern(),
+                  _jacobianColors(),
+                  _numJacobianColors(0),
+                  _iterationMatrix(),
+                  _iterationPivots(),
+                  _iterationStepSize(0.0),
+                  _extractionPath()
         {
         }
 
@@ -64,6 +119,60 @@ namespace OMVIS
          *---------------------------------------*/
 
         void FMUWrapper::load(const std::string& modelFile, const std::string& path)
+        {
+            initContext();
+
+            // The FMU is extracted to the cache entry of its content. Thus, a reload of the same FMU skips the unzip
+            // and a loaded shared object is never overwritten.
+            std::string fmuFileName = path + modelFile;
+            FMUCache cache;
+            const uint64_t key = FMUCache::computeKey(fmuFileName);
+            const std::string extractionPath = cache.getEntryPath(key);
+            FMUManifest manifest;
+            if (cache.lookup(key, manifest) && fmi_version_1_enu == manifest.fmiVersion)
+            {
+                LOGGER_WRITE("Use the extracted FMU in " + extractionPath + ".", Util::LC_LOADER, Util::LL_DEBUG);
+                importExtracted(extractionPath);
+                if (manifest.guid == fmi1_import_get_GUID(_fmu.get()))
+                {
+                    return;
+                }
+                LOGGER_WRITE("The extracted FMU in " + extractionPath + " does not match " + fmuFileName
+                             + ". Extract it again.", Util::LC_LOADER, Util::LL_WARNING);
+                _fmu.reset();
+                initContext();
+            }
+
+            cache.beginEntry(key);
+            fmi_version_enu_t version = fmi_import_get_fmi_version(_context.get(), fmuFileName.c_str(),
+                                                                   extractionPath.c_str());
+            if (fmi_version_1_enu != version)
+            {
+                LOGGER_WRITE("Only version 1.0 is supported so far. Exiting.", Util::LC_LOADER, Util::LL_ERROR);
+                cache.removeEntry(key);
+                doExit();
+            }
+
+            importExtracted(extractionPath);
+            try
+            {
+                cache.commitEntry(key, {static_cast<uint32_t>(version), fmi1_import_get_GUID(_fmu.get()),
+                                        fmi1_import_get_model_identifier(_fmu.get())});
+            }
+            catch (std::exception& ex)
+            {
+                // The FMU is loaded anyway, it is just extracted again next time.
+                LOGGER_WRITE(ex.what(), Util::LC_LOADER, Util::LL_WARNING);
+            }
+        }
+
+        void FMUWrapper::loadExtracted(const std::string& path)
+        {
+            initContext();
+            importExtracted(path);
+        }
+
+        void FMUWrapper::initContext()
         {
             // First we need to define the callbacks and set up the context.
             _callbacks.malloc = malloc;
@@ -84,38 +193,11 @@ namespace OMVIS
 #endif
             _context = std::shared_ptr<fmi_import_context_t>(fmi_import_allocate_context(&_callbacks),
                                                              fmi_import_free_context);
+        }
 
-            // If the FMU is already extracted, we remove the shared object file.
-            std::string sharedObjectFile(fmi_import_get_dll_path(path.c_str(), modelFile.c_str(), &_callbacks));
-            if (Util::fileExists(sharedObjectFile))
-            {
-                if (0 != remove(sharedObjectFile.c_str()))
-                {
-                    LOGGER_WRITE("Error deleting the shared object file " + sharedObjectFile + ".", Util::LC_LOADER,
-                                 Util::LL_ERROR);
-                }
-                else
-                {
-                    LOGGER_WRITE("Shared object file " + sharedObjectFile + " deleted.", Util::LC_LOADER,
-                                 Util::LL_DEBUG);
-                }
-            }
-            else
-            {
-                LOGGER_WRITE("Shared object file " + sharedObjectFile + " does not exist.", Util::LC_LOADER,
-                             Util::LL_DEBUG);
-            }
-
-            // Unzip the FMU and pars it.
-            // Unzip the FMU only once. Overwriting the dll/so file may cause a segmentation fault.
-            std::string fmuFileName = path + modelFile;
-            fmi_version_enu_t version = fmi_import_get_fmi_version(_context.get(), fmuFileName.c_str(), path.c_str());
-            if (fmi_version_1_enu != version)
-            {
-                LOGGER_WRITE("Only version 1.0 is supported so far. Exiting.", Util::LC_LOADER, Util::LL_ERROR);
-                doExit();
-            }
-
+        void FMUWrapper::importExtracted(const std::string& path)
+        {
+            _extractionPath = path;
             _fmu = std::shared_ptr<fmi1_import_t>(fmi1_import_parse_xml(_context.get(), path.c_str()),
                                                   fmi1_import_free);
             if (!_fmu)
@@ -138,6 +220,7 @@ namespace OMVIS
         {
             // Initialize data
             _fmuData._hcur = simSettings->getHdef();
+            _fmuData._hnext = simSettings->getHdef();
             _fmuData._tcur = simSettings->getTstart();
 
             LOGGER_WRITE("Version returned from FMU: " + std::string(fmi1_import_get_version(_fmu.get())),
@@ -157,6 +240,17 @@ namespace OMVIS
             _fmuData._eventIndicators = static_cast<fmi1_real_t*>(calloc(_fmuData._nEventIndicators, sizeof(double)));
             _fmuData._eventIndicatorsPrev =
                     static_cast<fmi1_real_t*>(calloc(_fmuData._nEventIndicators, sizeof(double)));
+            _statesStart.assign(_fmuData._nStates, 0.0);
+            _stages.assign(s_maxNumStages * _fmuData._nStates, 0.0);
+            _statesTmp.assign(_fmuData._nStates, 0.0);
+            _indicatorsLow.assign(_fmuData._nEventIndicators, 0.0);
+            _indicatorsHigh.assign(_fmuData._nEventIndicators, 0.0);
+            _indicatorsMid.assign(_fmuData._nEventIndicators, 0.0);
+            _jacobian.assign(_fmuData._nStates * _fmuData._nStates, 0.0);
+            _jacobianPattern.clear();
+            _jacobianColors.clear();
+            _numJacobianColors = 0;
+            _iterationStepSize = 0.0;
 
             // Instantiate model
             jm_status_enu_t jmstatus = fmi1_import_instantiate_model(_fmu.get(), "Test ME model instance");
@@ -200,11 +294,47 @@ namespace OMVIS
             return _fmuData._tcur;
         }
 
+        const std::string& FMUWrapper::getExtractionPath() const
+        {
+            return _extractionPath;
+        }
+
         void FMUWrapper::setContinuousStates()
         {
             _fmuData._fmiStatus = fmi1_import_set_continuous_states(_fmu.get(), _fmuData._states, _fmuData._nStates);
         }
 
+        void FMUWrapper::perturbContinuousStates(const fmi1_real_t offset)
+        {
+            for (size_t i = 0; i < _fmuData._nStates; ++i)
+            {
+                _fmuData._states[i] += offset * std::max(std::abs(_fmuData._states[i]), 1.0);
+            }
+            setContinuousStates();
+            _fmuData._fmiStatus = fmi1_import_get_event_indicators(_fmu.get(), _fmuData._eventIndicatorsPrev,
+                                                                   _fmuData._nEventIndicators);
+        }
+
+        void FMUWrapper::saveCheckpoint(FMUCheckpoint& checkpoint) const
+        {
+            checkpoint.time = _fmuData._tcur;
+            checkpoint.states.assign(_fmuData._states, _fmuData._states + _fmuData._nStates);
+        }
+
+        void FMUWrapper::restoreCheckpoint(const FMUCheckpoint& checkpoint)
+        {
+            if (checkpoint.states.size() != _fmuData._nStates)
+            {
+                throw std::runtime_error("The checkpoint does not match the number of states of the FMU.");
+            }
+            _fmuData._tcur = checkpoint.time;
+            std::copy(checkpoint.states.begin(), checkpoint.states.end(), _fmuData._states);
+            _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), checkpoint.time);
+            setContinuousStates();
+            _fmuData._fmiStatus = fmi1_import_get_event_indicators(_fmu.get(), _fmuData._eventIndicatorsPrev,
+                                                                   _fmuData._nEventIndicators);
+        }
+
         /*-----------------------------------------
          * SIMULATION METHODS
          *---------------------------------------*/
@@ -213,7 +343,7 @@ namespace OMVIS
         {
             for (size_t k = 0; k < _fmuData._nEventIndicators; ++k)
             {
-                if (_fmuData._eventIndicators[k] * _fmuData._eventIndicatorsPrev[k] < 0)
+                if (isCrossing(_fmuData._eventIndicatorsPrev[k], _fmuData._eventIndicators[k]))
                 {
                     LOGGER_WRITE("Event occurred at " + std::to_string(_fmuData._tcur), Util::LC_CTR, Util::LL_DEBUG);
                     return true;
@@ -289,17 +419,367 @@ namespace OMVIS
 
         void FMUWrapper::doEulerStep()
         {
+            std::copy(_fmuData._states, _fmuData._states + _fmuData._nStates, _statesStart.begin());
             for (size_t k = 0; k < _fmuData._nStates; ++k)
             {
                 _fmuData._states[k] = _fmuData._states[k] + _fmuData._hcur * _fmuData._statesDer[k];
             }
         }
 
+        void FMUWrapper::doRungeKuttaStep()
+        {
+            static const fmi1_real_t a2[] = {0.5};
+            static const fmi1_real_t a3[] = {0.0, 0.5};
+            static const fmi1_real_t a4[] = {0.0, 0.0, 1.0};
+
+            const size_t nStates = _fmuData._nStates;
+            const fmi1_real_t h = _fmuData._hcur;
+            const fmi1_real_t t0 = _fmuData._tcur - h;
+            std::copy(_fmuData._states, _fmuData._states + nStates, _statesStart.begin());
+            std::copy(_fmuData._statesDer, _fmuData._statesDer + nStates, getStage(0));
+
+            evaluateStage(t0 + 0.5 * h, h, a2, 1);
+            evaluateStage(t0 + 0.5 * h, h, a3, 2);
+            evaluateStage(t0 + h, h, a4, 3);
+
+            const fmi1_real_t* k1 = getStage(0);
+            const fmi1_real_t* k2 = getStage(1);
+            const fmi1_real_t* k3 = getStage(2);
+            const fmi1_real_t* k4 = getStage(3);
+            for (size_t k = 0; k < nStates; ++k)
+            {
+                _fmuData._states[k] = _statesStart[k] + h / 6.0 * (k1[k] + 2.0 * k2[k] + 2.0 * k3[k] + k4[k]);
+            }
+        }
+
+        void FMUWrapper::doDormandPrinceStep(const fmi1_real_t tolerance)
+        {
+            const size_t nStates = _fmuData._nStates;
+            const fmi1_real_t t0 = _fmuData._tcur - _fmuData._hcur;
+            fmi1_real_t h = _fmuData._hcur;
+            fmi1_real_t err = 0.0;
+            std::copy(_fmuData._states, _fmuData._states + nStates, _statesStart.begin());
+            std::copy(_fmuData._statesDer, _fmuData._statesDer + nStates, getStage(0));
+
+            while (true)
+            {
+                // The last stage sets the states to the solution of order 5.
+                for (size_t i = 1; i < s_maxNumStages; ++i)
+                {
+                    evaluateStage(t0 + s_dpC[i] * h, h, s_dpA[i], i);
+                }
+
+                // Weighted root mean square norm of the difference to the solution of order 4.
+                err = 0.0;
+                for (size_t k = 0; k < nStates; ++k)
+                {
+                    fmi1_real_t diff = 0.0;
+                    for (size_t i = 0; i < s_maxNumStages; ++i)
+                    {
+                        diff += s_dpE[i] * getStage(i)[k];
+                    }
+                    const fmi1_real_t scale = tolerance
+                            * (1.0 + std::max(std::abs(_statesStart[k]), std::abs(_fmuData._states[k])));
+                    err += (h * diff / scale) * (h * diff / scale);
+                }
+                err = (0 < nStates) ? std::sqrt(err / nStates) : 0.0;
+
+                if (1.0 >= err)
+                {
+                    break;
+                }
+                // Steps with a local error above the tolerance are never accepted.
+                if (s_minStepSize >= h)
+                {
+                    std::copy(_statesStart.begin(), _statesStart.end(), _fmuData._states);
+                    throw std::runtime_error("The Dormand-Prince method cannot meet the tolerance at time "
+                                             + std::to_string(t0) + ", the scaled local error is " + std::to_string(err)
+                                             + " for the minimal step size.");
+                }
+                h *= std::max(s_minStepFactor, 0.9 * std::pow(err, -0.2));
+                h = std::max(h, s_minStepSize);
+            }
+
+            _fmuData._tcur = t0 + h;
+            _fmuData._hcur = h;
+            const fmi1_real_t factor = (0.0 < err) ? 0.9 * std::pow(err, -0.2) : s_maxStepFactor;
+            _fmuData._hnext = h * std::min(s_maxStepFactor, std::max(s_minStepFactor, factor));
+        }
+
+        void FMUWrapper::doBackwardEulerStep(const fmi1_real_t tolerance)
+        {
+            const size_t nStates = _fmuData._nStates;
+            const fmi1_real_t t0 = _fmuData._tcur - _fmuData._hcur;
+            fmi1_real_t h = _fmuData._hcur;
+            std::copy(_fmuData._states, _fmuData._states + nStates, _statesStart.begin());
+
+            // Unconverged states are never accepted. The step is retried from its start with half the step size.
+            while (!doBackwardEulerIteration(t0 + h, h, tolerance))
+            {
+                std::copy(_statesStart.begin(), _statesStart.end(), _fmuData._states);
+                if (s_minStepSize >= h)
+                {
+                    throw std::runtime_error("The Newton iteration of the implicit Euler method did not converge at "
+                                             "time " + std::to_string(t0 + h) + ".");
+                }
+                h *= 0.5;
+                LOGGER_WRITE("The Newton iteration of the implicit Euler method did not converge. Retry with step "
+                             "size " + std::to_string(h) + ".", Util::LC_SOLVER, Util::LL_DEBUG);
+            }
+
+            _fmuData._tcur = t0 + h;
+            _fmuData._hcur = h;
+            // The FMU has to be at the end of the step, the states are set by the caller.
+            _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), _fmuData._tcur);
+        }
+
+        bool FMUWrapper::doBackwardEulerIteration(const fmi1_real_t t1, const fmi1_real_t h,
+                                                  const fmi1_real_t tolerance)
+        {
+            const size_t nStates = _fmuData._nStates;
+            fmi1_real_t* der = getStage(0);
+
+            // The Forward Euler solution is the predictor.
+            for (size_t k = 0; k < nStates; ++k)
+            {
+                _fmuData._states[k] = _statesStart[k] + h * _fmuData._statesDer[k];
+            }
+
+            bool isConverged = (0 == nStates);
+            for (int attempt = 0; attempt < 3 && !isConverged; ++attempt)
+            {
+                // A fresh Jacobian is only computed if there is none or the iteration with the old one failed. First,
+                // the known sparsity pattern is used. If the iteration still fails, the pattern is sampled again,
+                // since entries that were zero at the last sample may be nonzero now.
+                if (2 == attempt)
+                {
+                    _jacobianPattern.clear();
+                }
+                if (_jacobianPattern.empty() || 0 < attempt)
+                {
+                    updateJacobian(t1);
+                    _iterationStepSize = 0.0;
+                }
+                if (h != _iterationStepSize && !factorizeIterationMatrix(h))
+                {
+                    LOGGER_WRITE("The iteration matrix of the implicit Euler method is singular at time "
+                                 + std::to_string(t1) + ".", Util::LC_SOLVER, Util::LL_WARNING);
+                    break;
+                }
+
+                for (size_t it = 0; it < s_maxNewtonIterations && !isConverged; ++it)
+                {
+                    evaluateDerivatives(t1, _fmuData._states, der);
+                    for (size_t k = 0; k < nStates; ++k)
+                    {
+                        _statesTmp[k] = _statesStart[k] + h * der[k] - _fmuData._states[k];
+                    }
+                    Util::luSolve(_iterationMatrix, nStates, _iterationPivots, _statesTmp.data());
+
+                    fmi1_real_t norm = 0.0;
+                    for (size_t k = 0; k < nStates; ++k)
+                    {
+                        _fmuData._states[k] += _statesTmp[k];
+                        const fmi1_real_t scaled = _statesTmp[k] / (tolerance * (1.0 + std::abs(_fmuData._states[k])));
+                        norm += scaled * scaled;
+                    }
+                    isConverged = (1.0 >= std::sqrt(norm / nStates));
+                }
+            }
+            return isConverged;
+        }
+
+        bool FMUWrapper::locateStateEvent()
+        {
+            const size_t nIndicators = _fmuData._nEventIndicators;
+            if (0 == nIndicators)
+            {
+                return false;
+            }
+
+            // The indicators at the beginning of the step are the reference for the next event check.
+            const fmi1_real_t h = _fmuData._hcur;
+            const fmi1_real_t t0 = _fmuData._tcur - h;
+            std::copy(_fmuData._eventIndicators, _fmuData._eventIndicators + nIndicators, _indicatorsLow.begin());
+            std::copy(_fmuData._eventIndicators, _fmuData._eventIndicators + nIndicators,
+                      _fmuData._eventIndicatorsPrev);
+            evaluateEventIndicators(_fmuData._tcur, _fmuData._states, _indicatorsHigh.data());
+
+            bool isCrossed = false;
+            for (size_t k = 0; k < nIndicators && !isCrossed; ++k)
+            {
+                isCrossed = isCrossing(_indicatorsLow[k], _indicatorsHigh[k]);
+            }
+            if (!isCrossed || 0.0 >= h)
+            {
+                return false;
+            }
+
+            // The derivatives at the end of the step complete the interpolation of the states.
+            evaluateDerivatives(_fmuData._tcur, _fmuData._states, getStage(1));
+
+            // Illinois algorithm on the bracket [thetaLow, thetaHigh] of the step. The secant estimate of the earliest
+            // crossing indicator is used. If the same bound is kept twice, the weight of its indicator is halved.
+            const fmi1_real_t tolerance = 100.0 * DBL_EPSILON * (std::abs(_fmuData._tcur) + std::abs(h)) / h;
+            fmi1_real_t thetaLow = 0.0;
+            fmi1_real_t thetaHigh = 1.0;
+            fmi1_real_t alpha = 1.0;
+            int lastSide = 0;
+            for (size_t iter = 0; iter < s_maxEventIterations && thetaHigh - thetaLow > tolerance; ++iter)
+            {
+                fmi1_real_t thetaMid = thetaHigh;
+                for (size_t k = 0; k < nIndicators; ++k)
+                {
+                    if (isCrossing(_indicatorsLow[k], _indicatorsHigh[k]))
+                    {
+                        fmi1_real_t estimate = thetaHigh - (thetaHigh - thetaLow) * _indicatorsHigh[k]
+                                / (_indicatorsHigh[k] - alpha * _indicatorsLow[k]);
+                        thetaMid = std::min(thetaMid, estimate);
+                    }
+                }
+                thetaMid = std::max(thetaLow + 0.5 * tolerance, std::min(thetaMid, thetaHigh - 0.5 * tolerance));
+                interpolateStates(thetaMid, _statesTmp.data());
+                evaluateEventIndicators(t0 + thetaMid * h, _statesTmp.data(), _indicatorsMid.data());
+
+                bool isCrossedLow = false;
+                for (size_t k = 0; k < nIndicators && !isCrossedLow; ++k)
+                {
+                    isCrossedLow = isCrossing(_indicatorsLow[k], _indicatorsMid[k]);
+                }
+                if (isCrossedLow)
+                {
+                    thetaHigh = thetaMid;
+                    _indicatorsHigh.swap(_indicatorsMid);
+                    alpha = (1 == lastSide) ? 0.5 * alpha : 1.0;
+                    lastSide = 1;
+                }
+                else
+                {
+                    thetaLow = thetaMid;
+                    _indicatorsLow.swap(_indicatorsMid);
+                    alpha = (2 == lastSide) ? 2.0 * alpha : 1.0;
+                    lastSide = 2;
+                }
+            }
+
+            // End the step right behind the crossing.
+            interpolateStates(thetaHigh, _statesTmp.data());
+            std::copy(_statesTmp.begin(), _statesTmp.end(), _fmuData._states);
+            _fmuData._hcur = thetaHigh * h;
+            _fmuData._tcur = t0 + _fmuData._hcur;
+            _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), _fmuData._tcur);
+            LOGGER_WRITE("State event located at " + std::to_string(_fmuData._tcur), Util::LC_SOLVER, Util::LL_DEBUG);
+            return true;
+        }
+
         void FMUWrapper::completedIntegratorStep(fmi1_boolean_t* callEventUpdate)
         {
             _fmuData._fmiStatus = fmi1_import_completed_integrator_step(_fmu.get(), callEventUpdate);
         }
 
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void FMUWrapper::evaluateStage(const fmi1_real_t time, const fmi1_real_t h, const fmi1_real_t* coeffs,
+                                       const size_t numStages)
+        {
+            const size_t nStates = _fmuData._nStates;
+            for (size_t k = 0; k < nStates; ++k)
+            {
+                fmi1_real_t sum = 0.0;
+                for (size_t j = 0; j < numStages; ++j)
+                {
+                    sum += coeffs[j] * _stages[j * nStates + k];
+                }
+                _fmuData._states[k] = _statesStart[k] + h * sum;
+            }
+            evaluateDerivatives(time, _fmuData._states, getStage(numStages));
+        }
+
+        void FMUWrapper::interpolateStates(const fmi1_real_t theta, fmi1_real_t* states)
+        {
+            // Cubic Hermite basis functions.
+            const fmi1_real_t theta2 = theta * theta;
+            const fmi1_real_t theta3 = theta2 * theta;
+            const fmi1_real_t h00 = 2.0 * theta3 - 3.0 * theta2 + 1.0;
+            const fmi1_real_t h10 = (theta3 - 2.0 * theta2 + theta) * _fmuData._hcur;
+            const fmi1_real_t h01 = -2.0 * theta3 + 3.0 * theta2;
+            const fmi1_real_t h11 = (theta3 - theta2) * _fmuData._hcur;
+            const fmi1_real_t* derEnd = getStage(1);
+            for (size_t k = 0; k < _fmuData._nStates; ++k)
+            {
+                states[k] = h00 * _statesStart[k] + h10 * _fmuData._statesDer[k] + h01 * _fmuData._states[k]
+                        + h11 * derEnd[k];
+            }
+        }
+
+        void FMUWrapper::evaluateEventIndicators(const fmi1_real_t time, const fmi1_real_t* states,
+                                                 fmi1_real_t* indicators)
+        {
+            _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), time);
+            _fmuData._fmiStatus = fmi1_import_set_continuous_states(_fmu.get(), states, _fmuData._nStates);
+            _fmuData._fmiStatus = fmi1_import_get_event_indicators(_fmu.get(), indicators, _fmuData._nEventIndicators);
+        }
+
+        fmi1_real_t* FMUWrapper::getStage(const size_t stage)
+        {
+            return _stages.data() + stage * _fmuData._nStates;
+        }
+
+        void FMUWrapper::evaluateDerivatives(const fmi1_real_t time, const fmi1_real_t* states, fmi1_real_t* der)
+        {
+            _fmuData._fmiStatus = fmi1_import_set_time(_fmu.get(), time);
+            _fmuData._fmiStatus = fmi1_import_set_continuous_states(_fmu.get(), states, _fmuData._nStates);
+            _fmuData._fmiStatus = fmi1_import_get_derivatives(_fmu.get(), der, _fmuData._nStates);
+        }
+
+        void FMUWrapper::updateJacobian(const fmi1_real_t time)
+        {
+            const size_t nStates = _fmuData._nStates;
+            const fmi1_real_t* states = _fmuData._states;
+            fmi1_real_t* der = getStage(1);
+
+            evaluateDerivatives(time, states, der);
+            const size_t numEvaluations = Util::approximateJacobian(
+                    [this, time](const double* x, double* fx)
+                    {
+                        evaluateDerivatives(time, x, fx);
+                    },
+                    states, der, nStates, _jacobianPattern, _jacobianColors, _jacobian);
+
+            if (_jacobianPattern.empty())
+            {
+                _jacobianPattern.resize(nStates * nStates);
+                for (size_t i = 0; i < nStates * nStates; ++i)
+                {
+                    _jacobianPattern[i] = (0.0 != _jacobian[i]) || (i / nStates == i % nStates);
+                }
+                _jacobianColors = Util::colorColumns(_jacobianPattern, nStates);
+                _numJacobianColors = 0;
+                for (auto color : _jacobianColors)
+                {
+                    _numJacobianColors = std::max(_numJacobianColors, color + 1);
+                }
+                LOGGER_WRITE("Sampled the sparsity pattern of the Jacobian of " + std::to_string(nStates)
+                             + " states with " + std::to_string(numEvaluations) + " evaluations. Further approximations "
+                             + "need " + std::to_string(_numJacobianColors) + " evaluations.", Util::LC_SOLVER,
+                             Util::LL_DEBUG);
+            }
+        }
+
+        bool FMUWrapper::factorizeIterationMatrix(const fmi1_real_t h)
+        {
+            const size_t nStates = _fmuData._nStates;
+            _iterationMatrix.resize(nStates * nStates);
+            for (size_t i = 0; i < nStates * nStates; ++i)
+            {
+                _iterationMatrix[i] = ((i / nStates == i % nStates) ? 1.0 : 0.0) - h * _jacobian[i];
+            }
+            _iterationStepSize = Util::luFactorize(_iterationMatrix, nStates, _iterationPivots) ? h : 0.0;
+            return 0.0 != _iterationStepSize;
+        }
+
         /*-----------------------------------------
          * FREE METHODS
          *---------------------------------------*/
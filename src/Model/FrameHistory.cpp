@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/FrameHistory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Returns the bit pattern of the float.
+        static uint32_t toBits(const float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        /// Returns the float of the bit pattern.
+        static float fromBits(const uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        FrameHistory::FrameHistory(const size_t maxNumBytes, const size_t keyFrameInterval)
+                : _maxNumBytes(maxNumBytes),
+                  _keyFrameInterval(std::max<size_t>(keyFrameInterval, 1)),
+                  _frames(),
+                  _numBytes(0),
+                  _numValues(0),
+                  _numFramesSinceKeyFrame(0),
+                  _lastValues(),
+                  _values()
+        {
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool FrameHistory::empty() const
+        {
+            return _frames.empty();
+        }
+
+        size_t FrameHistory::getNumFrames() const
+        {
+            return _frames.size();
+        }
+
+        size_t FrameHistory::getNumBytes() const
+        {
+            return _numBytes;
+        }
+
+        double FrameHistory::getFirstTime() const
+        {
+            return _frames.front().time;
+        }
+
+        double FrameHistory::getLastTime() const
+        {
+            return _frames.back().time;
+        }
+
+        /*-----------------------------------------
+         * HISTORY METHODS
+         *---------------------------------------*/
+
+        void FrameHistory::clear()
+        {
+            _frames.clear();
+            _numBytes = 0;
+            _numFramesSinceKeyFrame = 0;
+            _lastValues.clear();
+        }
+
+        void FrameHistory::push(const double time, const std::vector<double>& values)
+        {
+            if (values.size() != _numValues)
+            {
+                clear();
+                _numValues = values.size();
+            }
+            else if (!_frames.empty() && time <= _frames.back().time)
+            {
+                truncate(std::nextafter(time, -std::numeric_limits<double>::infinity()));
+            }
+
+            _values.assign(values.begin(), values.end());
+            Frame frame;
+            frame.time = time;
+            frame.isKeyFrame = _frames.empty() || _keyFrameInterval <= _numFramesSinceKeyFrame;
+            encode(_values.data(), frame.isKeyFrame ? nullptr : _lastValues.data(), _numValues, frame.data);
+            _numFramesSinceKeyFrame = frame.isKeyFrame ? 1 : _numFramesSinceKeyFrame + 1;
+            _numBytes += frame.data.size();
+            _frames.push_back(std::move(frame));
+            std::swap(_lastValues, _values);
+
+            while (_maxNumBytes < _numBytes && 1 < _frames.size())
+            {
+                removeFirstFrame();
+            }
+        }
+
+        double FrameHistory::read(const double time, std::vector<double>& values) const
+        {
+            if (_frames.empty())
+            {
+                throw std::runtime_error("The frame history is empty.");
+            }
+
+            // The last frame with a time point less than or equal to the given time, at least the first one.
+            auto it = std::upper_bound(_frames.begin(), _frames.end(), time, [](const double t, const Frame& frame)
+            {
+                return t < frame.time;
+            });
+            const size_t idx = (_frames.begin() == it) ? 0 : static_cast<size_t>(it - _frames.begin()) - 1;
+
+            std::vector<float> frameValues;
+            std::vector<float> tmp;
+            decodeFrame(idx, frameValues, tmp);
+            values.assign(frameValues.begin(), frameValues.end());
+            return _frames[idx].time;
+        }
+
+        void FrameHistory::truncate(const double time)
+        {
+            while (!_frames.empty() && time < _frames.back().time)
+            {
+                _numBytes -= _frames.back().data.size();
+                _frames.pop_back();
+            }
+            if (_frames.empty())
+            {
+                clear();
+                return;
+            }
+
+            std::vector<float> tmp;
+            decodeFrame(_frames.size() - 1, _lastValues, tmp);
+            _numFramesSinceKeyFrame = 0;
+            for (auto it = _frames.rbegin(); it != _frames.rend(); ++it)
+            {
+                ++_numFramesSinceKeyFrame;
+                if (it->isKeyFrame)
+                {
+                    break;
+                }
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void FrameHistory::encode(const float* values, const float* reference, const size_t numValues,
+                                  std::vector<uint8_t>& data)
+        {
+            data.clear();
+            data.reserve(numValues);
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                uint32_t bits = toBits(values[i]) ^ ((nullptr == reference) ? 0u : toBits(reference[i]));
+                while (0x80u <= bits)
+                {
+                    data.push_back(static_cast<uint8_t>(bits | 0x80u));
+                    bits >>= 7;
+                }
+                data.push_back(static_cast<uint8_t>(bits));
+            }
+        }
+
+        void FrameHistory::decode(const std::vector<uint8_t>& data, const float* reference, const size_t numValues,
+                                  float* values)
+        {
+            size_t pos = 0;
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                uint32_t bits = 0;
+                for (unsigned int shift = 0; ; shift += 7)
+                {
+                    const uint8_t byte = data[pos++];
+                    bits |= static_cast<uint32_t>(byte & 0x7Fu) << shift;
+                    if (0 == (byte & 0x80u))
+                    {
+                        break;
+                    }
+                }
+                values[i] = fromBits(bits ^ ((nullptr == reference) ? 0u : toBits(reference[i])));
+            }
+        }
+
+        void FrameHistory::decodeFrame(const size_t idx, std::vector<float>& values, std::vector<float>& tmp) const
+        {
+            size_t keyIdx = idx;
+            while (!_frames[keyIdx].isKeyFrame)
+            {
+                --keyIdx;
+            }
+
+            values.resize(_numValues);
+            tmp.resize(_numValues);
+            decode(_frames[keyIdx].data, nullptr, _numValues, values.data());
+            for (size_t i = keyIdx + 1; i <= idx; ++i)
+            {
+                decode(_frames[i].data, values.data(), _numValues, tmp.data());
+                std::swap(values, tmp);
+            }
+        }
+
+        void FrameHistory::removeFirstFrame()
+        {
+            if (!_frames[1].isKeyFrame)
+            {
+                // Encode the second frame without reference before its reference is removed.
+                std::vector<float> values;
+                std::vector<float> tmp;
+                decodeFrame(1, values, tmp);
+                _numBytes -= _frames[1].data.size();
+                encode(values.data(), nullptr, _numValues, _frames[1].data);
+                _numBytes += _frames[1].data.size();
+                _frames[1].isKeyFrame = true;
+            }
+            _numBytes -= _frames.front().data.size();
+            _frames.pop_front();
+            _numFramesSinceKeyFrame = std::min(_numFramesSinceKeyFrame, _frames.size());
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
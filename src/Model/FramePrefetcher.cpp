@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/FramePrefetcher.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        FramePrefetcher::FramePrefetcher(const ResultTimeline& timeline, const size_t numFrames)
+                : _timeline(timeline),
+                  _frames(numFrames),
+                  _worker(),
+                  _running(false),
+                  _wakeMutex(),
+                  _wakeCondition(),
+                  _generation(0),
+                  _startTime(0.0),
+                  _step(0.0),
+                  _nextTime(0.0),
+                  _nextStep(0.0)
+        {
+        }
+
+        FramePrefetcher::~FramePrefetcher()
+        {
+            stop();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void FramePrefetcher::initialize()
+        {
+            stop();
+            for (size_t i = 0; i < _frames.getNumSlots(); ++i)
+            {
+                _timeline.initFrame(_frames.getSlot(i).frame);
+                _frames.getSlot(i).generation = 0;
+            }
+            _frames.clear();
+        }
+
+        void FramePrefetcher::stop()
+        {
+            _running.store(false, std::memory_order_release);
+            wakeWorker();
+            if (_worker.joinable())
+            {
+                _worker.join();
+            }
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void FramePrefetcher::restart(const double time, const double step)
+        {
+            _nextTime = time;
+            _nextStep = step;
+            _startTime.store(time, std::memory_order_relaxed);
+            _step.store(step, std::memory_order_relaxed);
+            _generation.fetch_add(1, std::memory_order_release);
+
+            if (!_worker.joinable())
+            {
+                _running.store(true, std::memory_order_release);
+                _worker = std::thread(&FramePrefetcher::run, this);
+            }
+            else
+            {
+                wakeWorker();
+            }
+        }
+
+        bool FramePrefetcher::popFrame(const double time, const double step, TimelineFrame& frame)
+        {
+            const double eps = 1.0e-9 * std::max(1.0, std::abs(time));
+            if (std::abs(time - _nextTime) > eps || step != _nextStep)
+            {
+                // The requested frame has not been prefetched.
+                restart(time + step, step);
+                return false;
+            }
+            _nextTime = time + step;
+
+            const unsigned int generation = _generation.load(std::memory_order_relaxed);
+            PrefetchedFrame* slot = nullptr;
+            while (nullptr != (slot = _frames.getReadSlot()))
+            {
+                if (generation == slot->generation)
+                {
+                    if (std::abs(slot->frame.time - time) <= eps)
+                    {
+                        // Exchange the buffers instead of copying the values.
+                        std::swap(frame.values, slot->frame.values);
+                        frame.time = slot->frame.time;
+                        _frames.commitRead();
+                        wakeWorker();
+                        return true;
+                    }
+                    else if (slot->frame.time > time)
+                    {
+                        return false;
+                    }
+                }
+                // Discard outdated frames.
+                _frames.commitRead();
+            }
+
+            // The worker lags behind. Its frame for this time is discarded by the next request.
+            wakeWorker();
+            return false;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void FramePrefetcher::run()
+        {
+            unsigned int generation = _generation.load(std::memory_order_acquire) - 1;
+            double time = 0.0;
+            double step = 0.0;
+            TimelineCursor cursor;
+
+            while (_running.load(std::memory_order_acquire))
+            {
+                auto currentGeneration = _generation.load(std::memory_order_acquire);
+                if (currentGeneration != generation)
+                {
+                    generation = currentGeneration;
+                    time = _startTime.load(std::memory_order_relaxed);
+                    step = _step.load(std::memory_order_relaxed);
+                    cursor.reset();
+                }
+
+                // Nothing to do, if the buffer is full or the end of the timeline is reached.
+                PrefetchedFrame* slot = nullptr;
+                if (0.0 < step && time <= _timeline.getStopTime())
+                {
+                    slot = _frames.getWriteSlot();
+                }
+                if (nullptr == slot)
+                {
+                    // Sleep until the consumer frees a slot, the prefetcher is restarted or stopped.
+                    std::unique_lock<std::mutex> lock(_wakeMutex);
+                    _wakeCondition.wait(lock, [this, generation, time, step]()
+                    {
+                        return !_running.load(std::memory_order_acquire)
+                                || generation != _generation.load(std::memory_order_acquire)
+                                || (0.0 < step && time <= _timeline.getStopTime() && nullptr != _frames.getWriteSlot());
+                    });
+                    continue;
+                }
+
+                _timeline.interpolate(time, slot->frame, cursor);
+                slot->generation = generation;
+                _frames.commitWrite();
+                time += step;
+            }
+        }
+
+        void FramePrefetcher::wakeWorker()
+        {
+            // Taking the lock orders the state change before the predicate check of a worker that is about to wait.
+            {
+                std::lock_guard<std::mutex> lock(_wakeMutex);
+            }
+            _wakeCondition.notify_one();
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
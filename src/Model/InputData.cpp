@@ -32,6 +32,43 @@ namespace OMVIS
         const inputKey keys_real[4] = { JOY_1_X, JOY_1_Y, JOY_2_X, JOY_2_Y };
         const inputKey keys_bool[4] = { KEY_W, KEY_A, KEY_S, KEY_D };
 
+        /// Returns the string value as it is stored in the values written to the FMU.
+        static std::string toWrittenValue(fmi1_string_t value)
+        {
+            return (nullptr == value) ? std::string() : std::string(value);
+        }
+
+        template <typename T>
+        static T toWrittenValue(const T value)
+        {
+            return value;
+        }
+
+        /*! \brief Collects the value references and values that differ from the values written to the FMU.
+         *
+         * If no values have been written to the FMU yet, all values are collected. The written values are updated.
+         */
+        template <typename T, typename W>
+        static void collectChangedValues(const fmi1_value_reference_t* vrs, const T* values, const size_t num,
+                                         std::vector<W>& written, std::vector<fmi1_value_reference_t>& changedVrs,
+                                         std::vector<T>& changedValues)
+        {
+            changedVrs.clear();
+            changedValues.clear();
+            const bool writeAll = (written.size() != num);
+            written.resize(num);
+            for (size_t i = 0; i < num; ++i)
+            {
+                const W value = toWrittenValue(values[i]);
+                if (writeAll || !(written[i] == value))
+                {
+                    changedVrs.push_back(vrs[i]);
+                    changedValues.push_back(values[i]);
+                    written[i] = value;
+                }
+            }
+        }
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
@@ -39,7 +76,13 @@ namespace OMVIS
         InputData::InputData()
                 : _inputVals(),
                   _keyToInputMap(),
-                  _keyboardToKeyMap()
+                  _keyboardToKeyMap(),
+                  _mutex(),
+                  _changedVrs(),
+                  _changedReals(),
+                  _changedIntegers(),
+                  _changedBooleans(),
+                  _changedStrings()
         {
         }
 
@@ -148,6 +191,7 @@ namespace OMVIS
                                                                             sizeof(fmi1_boolean_t)));
             _inputVals._valuesString = static_cast<fmi1_string_t*>(calloc(_inputVals.getNumString(),
                                                                           sizeof(fmi1_string_t)));
+            invalidateInputsInFMU();
             // malloc attributes
             _inputVals._attrReal =
                     static_cast<AttributesReal*>(calloc(_inputVals.getNumReal(), sizeof(AttributesReal)));
@@ -206,12 +250,12 @@ namespace OMVIS
             // Reset real input values to 0.0.
             for (auto r = 0u; r < _inputVals.getNumReal(); ++r)
             {
-                _inputVals._valuesReal[r] = 0.0;
+                setRealValue(r, 0.0);
             }
             // Reset integer input values to 0.
             for (auto i = 0u; i < _inputVals.getNumInteger(); ++i)
             {
-                _inputVals._valuesInteger[i] = 0;
+                setIntegerValue(i, 0);
             }
 
             // Reset boolean and string values.
@@ -223,13 +267,12 @@ namespace OMVIS
             // Reset boolean input values to false.
             for (auto b = 0u; b < _inputVals.getNumBoolean(); ++b)
             {
-                _inputVals._valuesBoolean[b] = 0;
+                setBooleanValue(b, 0);
             }
             // Reset string input values to empty string.
             for (auto s = 0u; s < _inputVals.getNumString(); ++s)
             {
-                _inputVals._valuesString[s] = "";
-
+                setStringValue(s, "");
             }
         }
 
@@ -240,14 +283,97 @@ namespace OMVIS
         /// \todo: What do we do with the variable status?
         void InputData::setInputsInFMU(fmi1_import_t* fmu)
         {
-            fmi1_status_t status = fmi1_import_set_real(fmu, _inputVals._vrReal, _inputVals.getNumReal(),
-                                                        _inputVals._valuesReal);
-            status = fmi1_import_set_integer(fmu, _inputVals._vrInteger, _inputVals.getNumInteger(),
-                                             _inputVals._valuesInteger);
-            status = fmi1_import_set_boolean(fmu, _inputVals._vrBoolean, _inputVals.getNumBoolean(),
-                                             _inputVals._valuesBoolean);
-            status = fmi1_import_set_string(fmu, _inputVals._vrBoolean, _inputVals.getNumString(),
-                                            _inputVals._valuesString);
+            // Setting an input may invalidate cached computations of the FMU. Thus, unchanged values are skipped.
+            fmi1_status_t status = fmi1_status_ok;
+            if (_inputVals._isDirtyReal)
+            {
+                collectChangedValues(_inputVals._vrReal, _inputVals._valuesReal, _inputVals.getNumReal(),
+                                     _inputVals._fmuValuesReal, _changedVrs, _changedReals);
+                if (!_changedVrs.empty())
+                {
+                    status = fmi1_import_set_real(fmu, _changedVrs.data(), _changedVrs.size(), _changedReals.data());
+                }
+                _inputVals._isDirtyReal = false;
+            }
+            if (_inputVals._isDirtyInteger)
+            {
+                collectChangedValues(_inputVals._vrInteger, _inputVals._valuesInteger, _inputVals.getNumInteger(),
+                                     _inputVals._fmuValuesInteger, _changedVrs, _changedIntegers);
+                if (!_changedVrs.empty())
+                {
+                    status = fmi1_import_set_integer(fmu, _changedVrs.data(), _changedVrs.size(),
+                                                     _changedIntegers.data());
+                }
+                _inputVals._isDirtyInteger = false;
+            }
+            if (_inputVals._isDirtyBoolean)
+            {
+                collectChangedValues(_inputVals._vrBoolean, _inputVals._valuesBoolean, _inputVals.getNumBoolean(),
+                                     _inputVals._fmuValuesBoolean, _changedVrs, _changedBooleans);
+                if (!_changedVrs.empty())
+                {
+                    status = fmi1_import_set_boolean(fmu, _changedVrs.data(), _changedVrs.size(),
+                                                     _changedBooleans.data());
+                }
+                _inputVals._isDirtyBoolean = false;
+            }
+            if (_inputVals._isDirtyString)
+            {
+                collectChangedValues(_inputVals._vrString, _inputVals._valuesString, _inputVals.getNumString(),
+                                     _inputVals._fmuValuesString, _changedVrs, _changedStrings);
+                if (!_changedVrs.empty())
+                {
+                    status = fmi1_import_set_string(fmu, _changedVrs.data(), _changedVrs.size(),
+                                                    _changedStrings.data());
+                }
+                _inputVals._isDirtyString = false;
+            }
+        }
+
+        void InputData::invalidateInputsInFMU()
+        {
+            _inputVals._fmuValuesReal.clear();
+            _inputVals._fmuValuesInteger.clear();
+            _inputVals._fmuValuesBoolean.clear();
+            _inputVals._fmuValuesString.clear();
+            _inputVals._isDirtyReal = true;
+            _inputVals._isDirtyInteger = true;
+            _inputVals._isDirtyBoolean = true;
+            _inputVals._isDirtyString = true;
+        }
+
+        void InputData::setRealValue(const size_t idx, const fmi1_real_t value)
+        {
+            if (_inputVals._valuesReal[idx] != value)
+            {
+                _inputVals._valuesReal[idx] = value;
+                _inputVals._isDirtyReal = true;
+            }
+        }
+
+        void InputData::setIntegerValue(const size_t idx, const fmi1_integer_t value)
+        {
+            if (_inputVals._valuesInteger[idx] != value)
+            {
+                _inputVals._valuesInteger[idx] = value;
+                _inputVals._isDirtyInteger = true;
+            }
+        }
+
+        void InputData::setBooleanValue(const size_t idx, const fmi1_boolean_t value)
+        {
+            if (_inputVals._valuesBoolean[idx] != value)
+            {
+                _inputVals._valuesBoolean[idx] = value;
+                _inputVals._isDirtyBoolean = true;
+            }
+        }
+
+        void InputData::setStringValue(const size_t idx, fmi1_string_t value)
+        {
+            // The strings are compared when they are written to the FMU.
+            _inputVals._valuesString[idx] = value;
+            _inputVals._isDirtyString = true;
         }
 
         void InputData::getVariableNames(fmi1_import_variable_list_t* varLst, const int numVars,
@@ -295,7 +421,7 @@ namespace OMVIS
                     double min = _inputVals._attrReal[realIdx]._min;
                     double max = _inputVals._attrReal[realIdx]._max;
                     double val = value / 32767.0;
-                    _inputVals._valuesReal[iterValue._valueIdx] = val;
+                    setRealValue(iterValue._valueIdx, val);
                     return true;
                 }
 
@@ -306,6 +432,11 @@ namespace OMVIS
             return false;
         }
 
+        std::mutex& InputData::getMutex()
+        {
+            return _mutex;
+        }
+
         const keyboardMap* InputData::getKeyboardMap()
         {
             return &_keyboardToKeyMap;
@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatFileReader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MatFileReader::MatFileReader()
+                : _file(),
+                  _fileName(),
+                  _variables(),
+                  _variableIndices(),
+                  _params(),
+                  _data2HeaderOffset(0),
+                  _data2Offset(0),
+                  _data2Type(0),
+                  _data2Transposed(true),
+                  _numVariables(0),
+                  _numRows(0),
+                  _numDeclaredRows(0),
+                  _columns()
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void MatFileReader::open(const std::string& fileName)
+        {
+            close();
+
+            try
+            {
+                _file.open(fileName);
+            }
+            catch (std::exception& ex)
+            {
+                throw std::runtime_error("Could not map MAT file " + fileName + ": " + ex.what());
+            }
+            _fileName = fileName;
+
+            // The result file consists of the matrices Aclass, name, description, dataInfo, data_1 and data_2.
+            size_t offset = 0;
+            MatrixHeader hdr;
+            bool binTrans = true;
+            bool hasData2 = false;
+            try
+            {
+                while (offset < _file.size() && !hasData2)
+                {
+                    size_t hdrOffset = offset;
+                    auto name = readMatrixHeader(offset, hdr);
+
+                    // The file may be truncated, e.g., if it is still being written. Only data_2 may be incomplete.
+                    const size_t elementSize = getElementSize(hdr.type);
+                    if ("data_2" != name && 0 != hdr.ncols
+                            && static_cast<size_t>(hdr.mrows) > (_file.size() - offset) / elementSize / hdr.ncols)
+                    {
+                        throw std::runtime_error("The matrix " + name + " exceeds the MAT file.");
+                    }
+
+                    if ("Aclass" == name && 3 < hdr.mrows)
+                    {
+                        // The fourth row of Aclass is either "binTrans" or "binNormal".
+                        std::string storage;
+                        for (int32_t j = 0; j < hdr.ncols; ++j)
+                        {
+                            storage.push_back(_file.data()[offset + 3 + j * hdr.mrows]);
+                        }
+                        binTrans = (0 == storage.compare(0, 8, "binTrans"));
+                    }
+                    else if ("name" == name)
+                    {
+                        parseNames(offset, hdr, binTrans);
+                    }
+                    else if ("dataInfo" == name)
+                    {
+                        parseDataInfo(offset, hdr, binTrans);
+                    }
+                    else if ("data_1" == name)
+                    {
+                        parseData1(offset, hdr, binTrans);
+                    }
+                    else if ("data_2" == name)
+                    {
+                        _data2HeaderOffset = hdrOffset;
+                        parseData2(offset, hdr, binTrans);
+                        hasData2 = true;
+                    }
+
+                    if (!hasData2)
+                    {
+                        offset += elementSize * hdr.mrows * hdr.ncols;
+                    }
+                }
+            }
+            catch (std::exception&)
+            {
+                close();
+                throw;
+            }
+
+            if (!hasData2 || _variables.empty() || 0 == _numRows)
+            {
+                close();
+                throw std::runtime_error("The file " + fileName + " is not a valid MAT result file.");
+            }
+        }
+
+        void MatFileReader::close()
+        {
+            if (_file.is_open())
+            {
+                _file.close();
+            }
+            _variables.clear();
+            _variableIndices.clear();
+            _params.clear();
+            _columns.clear();
+            _fileName.clear();
+            _data2HeaderOffset = 0;
+            _data2Offset = 0;
+            _numVariables = 0;
+            _numRows = 0;
+            _numDeclaredRows = 0;
+        }
+
+        size_t MatFileReader::refresh()
+        {
+            // Only time-major files can grow by appending rows.
+            if (!isOpen() || !_data2Transposed)
+            {
+                return _numRows;
+            }
+
+            _file.close();
+            try
+            {
+                _file.open(_fileName);
+            }
+            catch (std::exception& ex)
+            {
+                std::string fileName = _fileName;
+                close();
+                throw std::runtime_error("Could not map MAT file " + fileName + ": " + ex.what());
+            }
+
+            size_t offset = _data2HeaderOffset;
+            MatrixHeader hdr;
+            readMatrixHeader(offset, hdr);
+            if (static_cast<size_t>(hdr.mrows) != _numVariables)
+            {
+                throw std::runtime_error("The number of variables in MAT file " + _fileName + " changed.");
+            }
+            parseData2(offset, hdr, true);
+            return _numRows;
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool MatFileReader::isOpen() const
+        {
+            return _file.is_open();
+        }
+
+        const MatVariable* MatFileReader::findVariable(const std::string& name) const
+        {
+            auto it = _variableIndices.find(name);
+            return (_variableIndices.end() == it) ? nullptr : &_variables[it->second];
+        }
+
+        const std::vector<MatVariable>& MatFileReader::getVariables() const
+        {
+            return _variables;
+        }
+
+        size_t MatFileReader::getNumVariables() const
+        {
+            return _numVariables;
+        }
+
+        size_t MatFileReader::getNumRows() const
+        {
+            return _numRows;
+        }
+
+        bool MatFileReader::isComplete() const
+        {
+            return _numRows == _numDeclaredRows;
+        }
+
+        const std::vector<double>& MatFileReader::getParameters() const
+        {
+            return _params;
+        }
+
+        double MatFileReader::getStartTime() const
+        {
+            return readElement(_data2Offset, _data2Type, 0);
+        }
+
+        double MatFileReader::getStopTime() const
+        {
+            return readElement(_data2Offset, _data2Type, _data2Transposed ? (_numRows - 1) * _numVariables : _numRows - 1);
+        }
+
+        const std::vector<double>& MatFileReader::getColumn(const size_t column)
+        {
+            auto& values = _columns.at(column);
+            if (values.size() != _numRows)
+            {
+                values.resize(_numRows);
+                readColumn(column, 0, _numRows, values.data());
+            }
+            return values;
+        }
+
+        void MatFileReader::readColumn(const size_t column, const size_t firstRow, const size_t numRows,
+                                       double* out) const
+        {
+            readColumnImpl(column, firstRow, numRows, out);
+        }
+
+        void MatFileReader::readColumn(const size_t column, const size_t firstRow, const size_t numRows,
+                                       float* out) const
+        {
+            readColumnImpl(column, firstRow, numRows, out);
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        std::string MatFileReader::readMatrixHeader(size_t& offset, MatrixHeader& hdr) const
+        {
+            if (offset + sizeof(MatrixHeader) > _file.size())
+            {
+                throw std::runtime_error("Unexpected end of MAT file.");
+            }
+            std::memcpy(&hdr, _file.data() + offset, sizeof(MatrixHeader));
+            offset += sizeof(MatrixHeader);
+
+            // MOPT: M is the byte order, P the precision and T the matrix type.
+            if (0 != hdr.type / 1000)
+            {
+                throw std::runtime_error("Only little-endian MAT files are supported.");
+            }
+            if (0 > hdr.mrows || 0 > hdr.ncols || 0 >= hdr.namelen || 0 != hdr.imagf
+                    || offset + hdr.namelen > _file.size())
+            {
+                throw std::runtime_error("Corrupt matrix header in MAT file.");
+            }
+
+            std::string name(_file.data() + offset, strnlen(_file.data() + offset, hdr.namelen));
+            offset += hdr.namelen;
+            return name;
+        }
+
+        size_t MatFileReader::getElementSize(const int32_t type) const
+        {
+            switch ((type % 100) / 10)
+            {
+                case 0:
+                    return sizeof(double);
+                case 1:
+                    return sizeof(float);
+                case 2:
+                    return sizeof(int32_t);
+                case 3:
+                case 4:
+                    return sizeof(int16_t);
+                case 5:
+                    return sizeof(uint8_t);
+                default:
+                    throw std::runtime_error("Unknown precision in MAT file.");
+            }
+        }
+
+        double MatFileReader::readElement(const size_t offset, const int32_t type, const size_t index) const
+        {
+            const char* ptr = _file.data() + offset + index * getElementSize(type);
+            switch ((type % 100) / 10)
+            {
+                case 0:
+                {
+                    double val;
+                    std::memcpy(&val, ptr, sizeof(double));
+                    return val;
+                }
+                case 1:
+                {
+                    float val;
+                    std::memcpy(&val, ptr, sizeof(float));
+                    return val;
+                }
+                case 2:
+                {
+                    int32_t val;
+                    std::memcpy(&val, ptr, sizeof(int32_t));
+                    return val;
+                }
+                case 3:
+                {
+                    int16_t val;
+                    std::memcpy(&val, ptr, sizeof(int16_t));
+                    return val;
+                }
+                case 4:
+                {
+                    uint16_t val;
+                    std::memcpy(&val, ptr, sizeof(uint16_t));
+                    return val;
+                }
+                default:
+                    return static_cast<uint8_t>(*ptr);
+            }
+        }
+
+        void MatFileReader::parseNames(const size_t offset, const MatrixHeader& hdr, const bool binTrans)
+        {
+            // Names are stored as char matrix, one name per column (binTrans) or one name per row (binNormal).
+            size_t numNames = binTrans ? hdr.ncols : hdr.mrows;
+            size_t maxLen = binTrans ? hdr.mrows : hdr.ncols;
+            const char* data = _file.data() + offset;
+
+            _variables.resize(numNames);
+            _variableIndices.clear();
+            _variableIndices.reserve(numNames);
+            for (size_t i = 0; i < numNames; ++i)
+            {
+                std::string name;
+                name.reserve(maxLen);
+                for (size_t j = 0; j < maxLen; ++j)
+                {
+                    name.push_back(binTrans ? data[i * maxLen + j] : data[i + j * numNames]);
+                }
+                // Names are padded with '\0' or blanks.
+                name.erase(name.find_last_not_of(std::string(" \0", 2)) + 1);
+                name.erase(std::find(name.begin(), name.end(), '\0'), name.end());
+
+                _variables[i].name = name;
+                _variables[i].isParam = false;
+                _variables[i].index = 0;
+                _variableIndices.emplace(name, i);
+            }
+        }
+
+        void MatFileReader::parseDataInfo(const size_t offset, const MatrixHeader& hdr, const bool binTrans)
+        {
+            size_t numInfos = binTrans ? hdr.ncols : hdr.mrows;
+            size_t numEntries = binTrans ? hdr.mrows : hdr.ncols;
+            if (numInfos != _variables.size() || 2 > numEntries)
+            {
+                throw std::runtime_error("The dataInfo matrix does not match the name matrix in MAT file.");
+            }
+
+            // Each variable has four entries: data set (1 = data_1, 2 = data_2), index, interpolation, extrapolation.
+            for (size_t i = 0; i < numInfos; ++i)
+            {
+                auto dataSet = readElement(offset, hdr.type, binTrans ? numEntries * i : i);
+                auto index = readElement(offset, hdr.type, binTrans ? numEntries * i + 1 : i + numInfos);
+                _variables[i].isParam = (1 == static_cast<int>(dataSet));
+                _variables[i].index = static_cast<int>(index);
+            }
+        }
+
+        void MatFileReader::parseData1(const size_t offset, const MatrixHeader& hdr, const bool binTrans)
+        {
+            size_t numParams = binTrans ? hdr.mrows : hdr.ncols;
+            _params.resize(numParams);
+            for (size_t i = 0; i < numParams; ++i)
+            {
+                _params[i] = readElement(offset, hdr.type, binTrans ? i : hdr.mrows * i);
+            }
+        }
+
+        void MatFileReader::parseData2(const size_t offset, const MatrixHeader& hdr, const bool binTrans)
+        {
+            _data2Offset = offset;
+            _data2Type = hdr.type;
+            _data2Transposed = binTrans;
+            _numVariables = binTrans ? hdr.mrows : hdr.ncols;
+            _numRows = binTrans ? hdr.ncols : hdr.mrows;
+            _numDeclaredRows = _numRows;
+
+            // If the file is still being written or has been truncated, only complete rows are available.
+            if (binTrans && 0 < _numVariables)
+            {
+                size_t available = (_file.size() - offset) / (getElementSize(hdr.type) * _numVariables);
+                _numRows = (0 == _numRows) ? available : std::min(_numRows, available);
+            }
+            else if (offset + getElementSize(hdr.type) * _numVariables * _numRows > _file.size())
+            {
+                throw std::runtime_error("The data_2 matrix exceeds the MAT file.");
+            }
+
+            _columns.clear();
+            _columns.resize(_numVariables);
+        }
+
+        template <typename T>
+        void MatFileReader::readColumnImpl(const size_t column, const size_t firstRow, const size_t numRows, T* out) const
+        {
+            if (column >= _numVariables || firstRow + numRows > _numRows)
+            {
+                throw std::out_of_range("Requested data is not contained in data_2 of MAT file.");
+            }
+
+            // In binTrans files consecutive values of a variable are numVariables elements apart.
+            size_t elementSize = getElementSize(_data2Type);
+            size_t stride = _data2Transposed ? _numVariables : 1;
+            size_t first = _data2Transposed ? firstRow * _numVariables + column : column * _numRows + firstRow;
+            const char* ptr = _file.data() + _data2Offset + first * elementSize;
+
+            if (sizeof(double) == elementSize && 0 == (_data2Type % 100) / 10)
+            {
+                double val;
+                for (size_t i = 0; i < numRows; ++i, ptr += stride * elementSize)
+                {
+                    std::memcpy(&val, ptr, sizeof(double));
+                    out[i] = static_cast<T>(val);
+                }
+            }
+            else if (sizeof(float) == elementSize && 1 == (_data2Type % 100) / 10)
+            {
+                float val;
+                for (size_t i = 0; i < numRows; ++i, ptr += stride * elementSize)
+                {
+                    std::memcpy(&val, ptr, sizeof(float));
+                    out[i] = static_cast<T>(val);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numRows; ++i)
+                {
+                    out[i] = static_cast<T>(readElement(_data2Offset, _data2Type, first + i * stride));
+                }
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
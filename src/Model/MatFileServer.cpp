@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatFileServer.hpp"
+#include "Model/MatFileReader.hpp"
+#include "Model/MatStreamProtocol.hpp"
+#include "Util/Logger.hpp"
+
+#include <boost/asio/error.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Maximum number of columns of a single read request. More columns indicate a corrupt stream.
+        static const uint64_t s_maxColumns = 1 << 24;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MatFileServer::MatFileServer(const std::string& rootDir, const unsigned short port)
+                : _rootDir(boost::filesystem::canonical(rootDir).string()),
+                  _ioService(),
+                  _acceptor(_ioService, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
+                  _isRunning(false)
+        {
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        unsigned short MatFileServer::getPort() const
+        {
+            return _acceptor.local_endpoint().port();
+        }
+
+        /*-----------------------------------------
+         * SERVER METHODS
+         *---------------------------------------*/
+
+        void MatFileServer::run()
+        {
+            _isRunning = true;
+            LOGGER_WRITE("Serving MAT files in " + _rootDir + " on port " + std::to_string(getPort()) + ".",
+                         Util::LC_LOADER, Util::LL_INFO);
+
+            while (_isRunning)
+            {
+                boost::asio::ip::tcp::socket socket(_ioService);
+                _acceptor.accept(socket);
+                if (!_isRunning)
+                {
+                    break;
+                }
+
+                try
+                {
+                    serveClient(socket);
+                }
+                catch (std::exception& ex)
+                {
+                    LOGGER_WRITE("Connection to client lost: " + std::string(ex.what()), Util::LC_LOADER,
+                                 Util::LL_WARNING);
+                }
+            }
+        }
+
+        void MatFileServer::stop()
+        {
+            _isRunning = false;
+
+            // Wake up the blocking accept by connecting to it.
+            try
+            {
+                boost::asio::io_service ioService;
+                boost::asio::ip::tcp::socket socket(ioService);
+                socket.connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), getPort()));
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE("Could not wake up the server: " + std::string(ex.what()), Util::LC_LOADER,
+                             Util::LL_WARNING);
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void MatFileServer::serveClient(boost::asio::ip::tcp::socket& socket)
+        {
+            MatFileReader reader;
+            while (true)
+            {
+                MatStreamRequest request;
+                try
+                {
+                    request = MatStream::read<MatStreamRequest>(socket);
+                }
+                catch (boost::system::system_error& ex)
+                {
+                    // The client closed the connection without saying goodbye.
+                    if (boost::asio::error::eof == ex.code())
+                    {
+                        return;
+                    }
+                    throw;
+                }
+
+                switch (request)
+                {
+                    case MatStreamRequest::OPEN:
+                        handleOpen(socket, reader);
+                        break;
+                    case MatStreamRequest::READ:
+                        handleRead(socket, reader);
+                        break;
+                    case MatStreamRequest::CLOSE:
+                        return;
+                    default:
+                        throw std::runtime_error("Unknown request " + std::to_string(static_cast<int32_t>(request))
+                                                 + ".");
+                }
+            }
+        }
+
+        void MatFileServer::handleOpen(boost::asio::ip::tcp::socket& socket, MatFileReader& reader)
+        {
+            std::string fileName = MatStream::readString(socket);
+            try
+            {
+                reader.open(resolveFileName(fileName));
+            }
+            catch (std::exception& ex)
+            {
+                MatStream::write(socket, MatStreamStatus::ERROR);
+                MatStream::writeString(socket, ex.what());
+                return;
+            }
+            LOGGER_WRITE("Opened " + fileName + " for a client.", Util::LC_LOADER, Util::LL_INFO);
+
+            const size_t numRows = reader.getNumRows();
+            MatStream::write(socket, MatStreamStatus::OK);
+            MatStream::write<uint64_t>(socket, numRows);
+
+            const auto& variables = reader.getVariables();
+            MatStream::write<uint64_t>(socket, variables.size());
+            for (const auto& var : variables)
+            {
+                MatStream::writeString(socket, var.name);
+                MatStream::write<uint8_t>(socket, var.isParam ? 1 : 0);
+                MatStream::write<int32_t>(socket, var.index);
+            }
+
+            const auto& params = reader.getParameters();
+            MatStream::write<uint64_t>(socket, params.size());
+            MatStream::writeBytes(socket, params.data(), params.size() * sizeof(double));
+
+            // Time is always the first variable in data_2.
+            std::vector<double> times(numRows);
+            reader.readColumn(0, 0, numRows, times.data());
+            MatStream::writeBytes(socket, times.data(), numRows * sizeof(double));
+        }
+
+        void MatFileServer::handleRead(boost::asio::ip::tcp::socket& socket, MatFileReader& reader)
+        {
+            auto firstRow = MatStream::read<uint64_t>(socket);
+            auto numRows = MatStream::read<uint64_t>(socket);
+            auto numColumns = MatStream::read<uint64_t>(socket);
+            if (s_maxColumns < numColumns)
+            {
+                throw std::runtime_error("Received a read request for " + std::to_string(numColumns) + " columns.");
+            }
+            std::vector<uint64_t> columns(numColumns);
+            MatStream::readBytes(socket, columns.data(), numColumns * sizeof(uint64_t));
+
+            // The whole request has been received, thus, the stream stays consistent if the request is refused.
+            std::string error;
+            if (!reader.isOpen())
+            {
+                error = "No file has been opened.";
+            }
+            else if (firstRow > reader.getNumRows() || numRows > reader.getNumRows() - firstRow)
+            {
+                error = "The time points " + std::to_string(firstRow) + " to " + std::to_string(firstRow + numRows)
+                        + " are out of range.";
+            }
+            else if (std::any_of(columns.begin(), columns.end(),
+                                 [&reader](const uint64_t column) {return column >= reader.getNumVariables();}))
+            {
+                error = "A requested column is out of range.";
+            }
+            if (!error.empty())
+            {
+                MatStream::write(socket, MatStreamStatus::ERROR);
+                MatStream::writeString(socket, error);
+                return;
+            }
+
+            MatStream::write(socket, MatStreamStatus::OK);
+            std::vector<float> values(numRows);
+            for (auto column : columns)
+            {
+                reader.readColumn(column, firstRow, numRows, values.data());
+                MatStream::writeBytes(socket, values.data(), numRows * sizeof(float));
+            }
+        }
+
+        std::string MatFileServer::resolveFileName(const std::string& fileName) const
+        {
+            boost::filesystem::path file(fileName);
+            if (file.is_relative())
+            {
+                file = boost::filesystem::path(_rootDir) / file;
+            }
+            if (!boost::filesystem::exists(file))
+            {
+                throw std::runtime_error("Could not find MAT file " + fileName + ".");
+            }
+            file = boost::filesystem::canonical(file);
+
+            // The root directory has to be a prefix of the file.
+            boost::filesystem::path root(_rootDir);
+            auto mismatch = std::mismatch(root.begin(), root.end(), file.begin(), file.end());
+            if (root.end() != mismatch.first)
+            {
+                throw std::runtime_error("The MAT file " + fileName + " is not located in the served directory.");
+            }
+            return file.string();
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatFileWriter.hpp"
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Time the writer thread sleeps if no block is pending.
+        static const std::chrono::milliseconds s_writerIdleTime(5);
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        MatFileWriter::MatFileWriter()
+                : _fileName(),
+                  _stream(),
+                  _data2HeaderOffset(0),
+                  _numVariables(0),
+                  _rowsPerBlock(0),
+                  _numRows(0),
+                  _numDroppedRows(0),
+                  _blocks(),
+                  _block(nullptr),
+                  _writerThread(),
+                  _isWriting(false),
+                  _hasFailed(false)
+        {
+        }
+
+        MatFileWriter::~MatFileWriter()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void MatFileWriter::open(const std::string& fileName, const std::vector<std::string>& names,
+                                 const size_t rowsPerBlock, const size_t numBlocks)
+        {
+            close();
+
+            if (names.empty() || "time" != names.front() || 0 == rowsPerBlock || 0 == numBlocks)
+            {
+                throw std::invalid_argument("A MAT result file needs the time as first variable.");
+            }
+
+            _stream.open(fileName, std::ios::binary | std::ios::trunc);
+            if (!_stream)
+            {
+                throw std::runtime_error("Could not create MAT file " + fileName + ".");
+            }
+            _fileName = fileName;
+            _numVariables = names.size();
+            _rowsPerBlock = rowsPerBlock;
+            _numRows = 0;
+            _numDroppedRows = 0;
+            _hasFailed = false;
+
+            // The result file consists of the matrices Aclass, name, description, dataInfo, data_1 and data_2.
+            writeStrings("Aclass", {"Atrajectory", "1.1", "", "binTrans"}, false);
+            writeStrings("name", names, true);
+            writeStrings("description", std::vector<std::string>(names.size()), true);
+
+            // Each variable has four entries: data set (1 = data_1, 2 = data_2), index, interpolation, extrapolation.
+            writeMatrixHeader("dataInfo", 20, 4, static_cast<int32_t>(_numVariables));
+            for (size_t i = 0; i < _numVariables; ++i)
+            {
+                int32_t info[4] = {2, static_cast<int32_t>(i + 1), 0, -1};
+                _stream.write(reinterpret_cast<const char*>(info), sizeof(info));
+            }
+
+            writeMatrixHeader("data_1", 0, 1, 2);
+            double params[2] = {0.0, 0.0};
+            _stream.write(reinterpret_cast<const char*>(params), sizeof(params));
+
+            // The number of rows is set on close. Until then, readers take the complete rows of the file.
+            _data2HeaderOffset = _stream.tellp();
+            writeMatrixHeader("data_2", 0, static_cast<int32_t>(_numVariables), 0);
+            _stream.flush();
+            if (!_stream)
+            {
+                _stream.close();
+                throw std::runtime_error("Could not write MAT file " + fileName + ".");
+            }
+
+            _blocks.reset(new Util::RingBuffer<Block>(numBlocks));
+            for (size_t i = 0; i < _blocks->getNumSlots(); ++i)
+            {
+                _blocks->getSlot(i).numRows = 0;
+                _blocks->getSlot(i).values.resize(_rowsPerBlock * _numVariables);
+            }
+            _block = nullptr;
+
+            _isWriting = true;
+            _writerThread = std::thread(&MatFileWriter::run, this);
+        }
+
+        void MatFileWriter::close()
+        {
+            if (!_stream.is_open())
+            {
+                return;
+            }
+
+            if (nullptr != _block && 0 < _block->numRows)
+            {
+                _blocks->commitWrite();
+            }
+            _block = nullptr;
+            _isWriting = false;
+            if (_writerThread.joinable())
+            {
+                _writerThread.join();
+            }
+
+            int32_t ncols = static_cast<int32_t>(_numRows);
+            _stream.seekp(_data2HeaderOffset + 2 * static_cast<std::streamoff>(sizeof(int32_t)));
+            _stream.write(reinterpret_cast<const char*>(&ncols), sizeof(ncols));
+            _stream.close();
+            if (_hasFailed || _stream.fail())
+            {
+                LOGGER_WRITE("Could not write MAT file " + _fileName + ".", Util::LC_LOADER, Util::LL_ERROR);
+            }
+            else if (0 < _numDroppedRows)
+            {
+                LOGGER_WRITE("Dropped " + std::to_string(_numDroppedRows) + " rows while writing MAT file " + _fileName
+                                     + ".",
+                             Util::LC_LOADER, Util::LL_WARNING);
+            }
+            _blocks.reset();
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool MatFileWriter::isOpen() const
+        {
+            return _stream.is_open();
+        }
+
+        const std::string& MatFileWriter::getFileName() const
+        {
+            return _fileName;
+        }
+
+        size_t MatFileWriter::getNumVariables() const
+        {
+            return _numVariables;
+        }
+
+        size_t MatFileWriter::getNumRows() const
+        {
+            return _numRows;
+        }
+
+        size_t MatFileWriter::getNumDroppedRows() const
+        {
+            return _numDroppedRows;
+        }
+
+        /*-----------------------------------------
+         * WRITE METHODS
+         *---------------------------------------*/
+
+        bool MatFileWriter::writeRow(const double* values)
+        {
+            if (nullptr == _block)
+            {
+                _block = _blocks->getWriteSlot();
+                if (nullptr == _block)
+                {
+                    ++_numDroppedRows;
+                    return false;
+                }
+                _block->numRows = 0;
+            }
+
+            std::copy(values, values + _numVariables, _block->values.begin() + _block->numRows * _numVariables);
+            ++_numRows;
+            if (_rowsPerBlock == ++_block->numRows)
+            {
+                _blocks->commitWrite();
+                _block = nullptr;
+            }
+            return true;
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void MatFileWriter::writeMatrixHeader(const std::string& name, const int32_t type, const int32_t mrows,
+                                              const int32_t ncols)
+        {
+            int32_t hdr[5] = {type, mrows, ncols, 0, static_cast<int32_t>(name.size() + 1)};
+            _stream.write(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+            _stream.write(name.c_str(), name.size() + 1);
+        }
+
+        void MatFileWriter::writeStrings(const std::string& name, const std::vector<std::string>& strings,
+                                         const bool binTrans)
+        {
+            size_t maxLen = 1;
+            for (const auto& str : strings)
+            {
+                maxLen = std::max(maxLen, str.size());
+            }
+
+            // The strings are padded with zeros. Matrices are stored column-major.
+            const size_t numStrings = strings.size();
+            std::vector<char> data(maxLen * numStrings, '\0');
+            for (size_t i = 0; i < numStrings; ++i)
+            {
+                for (size_t j = 0; j < strings[i].size(); ++j)
+                {
+                    data[binTrans ? i * maxLen + j : i + j * numStrings] = strings[i][j];
+                }
+            }
+            if (binTrans)
+            {
+                writeMatrixHeader(name, 51, static_cast<int32_t>(maxLen), static_cast<int32_t>(numStrings));
+            }
+            else
+            {
+                writeMatrixHeader(name, 51, static_cast<int32_t>(numStrings), static_cast<int32_t>(maxLen));
+            }
+            _stream.write(data.data(), data.size());
+        }
+
+        void MatFileWriter::run()
+        {
+            while (true)
+            {
+                // Load the flag first, so that no block committed before close is missed.
+                bool isWriting = _isWriting;
+                Block* block;
+                while (nullptr != (block = _blocks->getReadSlot()))
+                {
+                    _stream.write(reinterpret_cast<const char*>(block->values.data()),
+                                  block->numRows * _numVariables * sizeof(double));
+                    _blocks->commitRead();
+                }
+                _stream.flush();
+                if (!_stream)
+                {
+                    _hasFailed = true;
+                }
+
+                if (!isWriting)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(s_writerIdleTime);
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/MatStreamProtocol.hpp"
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+        namespace MatStream
+        {
+
+            /// Maximum length of a single string. Longer strings indicate a corrupt stream.
+            static const uint64_t s_maxStringLength = 1 << 20;
+
+            void writeBytes(boost::asio::ip::tcp::socket& socket, const void* data, const size_t size)
+            {
+                boost::asio::write(socket, boost::asio::buffer(data, size));
+            }
+
+            void readBytes(boost::asio::ip::tcp::socket& socket, void* data, const size_t size)
+            {
+                boost::asio::read(socket, boost::asio::buffer(data, size));
+            }
+
+            void writeString(boost::asio::ip::tcp::socket& socket, const std::string& str)
+            {
+                write<uint64_t>(socket, str.size());
+                writeBytes(socket, str.data(), str.size());
+            }
+
+            std::string readString(boost::asio::ip::tcp::socket& socket)
+            {
+                auto length = read<uint64_t>(socket);
+                if (s_maxStringLength < length)
+                {
+                    throw std::runtime_error("Received a string of invalid length " + std::to_string(length) + ".");
+                }
+                std::string str(length, '\0');
+                readBytes(socket, &str[0], length);
+                return str;
+            }
+
+            void readStatus(boost::asio::ip::tcp::socket& socket)
+            {
+                if (MatStreamStatus::OK != read<MatStreamStatus>(socket))
+                {
+                    throw std::runtime_error("Server error: " + readString(socket));
+                }
+            }
+
+        }  // namespace MatStream
+    }  // namespace Model
+}  // namespace OMVIS
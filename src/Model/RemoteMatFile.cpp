@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/RemoteMatFile.hpp"
+#include "Model/MatStreamProtocol.hpp"
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        RemoteMatFile::RemoteMatFile()
+                : _ioService(),
+                  _socket(_ioService),
+                  _variables(),
+                  _variableIndices(),
+                  _params(),
+                  _times()
+        {
+        }
+
+        RemoteMatFile::~RemoteMatFile()
+        {
+            close();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void RemoteMatFile::open(const std::string& hostAddress, const int port, const std::string& fileName)
+        {
+            close();
+
+            boost::asio::ip::tcp::resolver resolver(_ioService);
+            boost::asio::connect(_socket,
+                                 resolver.resolve(boost::asio::ip::tcp::resolver::query(hostAddress,
+                                                                                        std::to_string(port))));
+
+            try
+            {
+                MatStream::write(_socket, MatStreamRequest::OPEN);
+                MatStream::writeString(_socket, fileName);
+                MatStream::readStatus(_socket);
+
+                auto numRows = MatStream::read<uint64_t>(_socket);
+                auto numVariables = MatStream::read<uint64_t>(_socket);
+                _variables.resize(numVariables);
+                for (size_t i = 0; i < numVariables; ++i)
+                {
+                    _variables[i].name = MatStream::readString(_socket);
+                    _variables[i].isParam = (0 != MatStream::read<uint8_t>(_socket));
+                    _variables[i].index = MatStream::read<int32_t>(_socket);
+                    _variableIndices[_variables[i].name] = i;
+                }
+
+                _params.resize(MatStream::read<uint64_t>(_socket));
+                MatStream::readBytes(_socket, _params.data(), _params.size() * sizeof(double));
+                _times.resize(numRows);
+                MatStream::readBytes(_socket, _times.data(), numRows * sizeof(double));
+            }
+            catch (std::exception&)
+            {
+                // Do not leave a connection without an open file behind.
+                close();
+                throw;
+            }
+        }
+
+        void RemoteMatFile::close()
+        {
+            if (_socket.is_open())
+            {
+                // The server does not answer, thus, a failing connection is irrelevant.
+                boost::system::error_code error;
+                auto request = MatStreamRequest::CLOSE;
+                boost::asio::write(_socket, boost::asio::buffer(&request, sizeof(request)), error);
+                _socket.close(error);
+            }
+            _variables.clear();
+            _variableIndices.clear();
+            _params.clear();
+            _times.clear();
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool RemoteMatFile::isOpen() const
+        {
+            return _socket.is_open();
+        }
+
+        const MatVariable* RemoteMatFile::findVariable(const std::string& name) const
+        {
+            auto it = _variableIndices.find(name);
+            return (_variableIndices.end() == it) ? nullptr : &_variables[it->second];
+        }
+
+        size_t RemoteMatFile::getNumRows() const
+        {
+            return _times.size();
+        }
+
+        const std::vector<double>& RemoteMatFile::getParameters() const
+        {
+            return _params;
+        }
+
+        const std::vector<double>& RemoteMatFile::getTimes() const
+        {
+            return _times;
+        }
+
+        size_t RemoteMatFile::findRow(const double time) const
+        {
+            auto it = std::upper_bound(_times.begin(), _times.end(), time);
+            return (_times.begin() == it) ? 0 : static_cast<size_t>(it - _times.begin()) - 1;
+        }
+
+        void RemoteMatFile::readRows(const std::vector<size_t>& columns, const size_t firstRow, const size_t numRows,
+                                     const std::vector<float*>& out)
+        {
+            if (!isOpen())
+            {
+                throw std::runtime_error("No remote MAT file has been opened.");
+            }
+
+            MatStream::write(_socket, MatStreamRequest::READ);
+            MatStream::write<uint64_t>(_socket, firstRow);
+            MatStream::write<uint64_t>(_socket, numRows);
+            MatStream::write<uint64_t>(_socket, columns.size());
+            for (auto column : columns)
+            {
+                MatStream::write<uint64_t>(_socket, column);
+            }
+
+            MatStream::readStatus(_socket);
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                MatStream::readBytes(_socket, out[i], numRows * sizeof(float));
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
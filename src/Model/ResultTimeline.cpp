@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/ResultTimeline.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Maximum number of rows the cursor walks before a binary search is used.
+        static const size_t s_maxCursorSteps = 16;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        ResultTimeline::ResultTimeline()
+                : _times(),
+                  _values(),
+                  _capacity(0),
+                  _columnOffsets(),
+                  _columnStrides()
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void ResultTimeline::allocate(const size_t numRows, const std::vector<bool>& constColumns)
+        {
+            _times.assign(numRows, 0.0);
+            _columnOffsets.resize(constColumns.size());
+            _columnStrides.resize(constColumns.size());
+
+            size_t offset = 0;
+            for (size_t i = 0; i < constColumns.size(); ++i)
+            {
+                _columnOffsets[i] = offset;
+                _columnStrides[i] = constColumns[i] ? 0 : 1;
+                offset += constColumns[i] ? 1 : numRows;
+            }
+            _values.assign(offset, 0.0f);
+            _capacity = numRows;
+        }
+
+        void ResultTimeline::resize(const size_t numRows)
+        {
+            if (numRows > _capacity)
+            {
+                // Move the columns into a larger store.
+                const size_t capacity = std::max(numRows, 2 * _capacity);
+                const size_t numValid = std::min(numRows, _times.size());
+                std::vector<float> values;
+                std::vector<size_t> offsets(_columnOffsets.size());
+                size_t offset = 0;
+                for (size_t i = 0; i < _columnOffsets.size(); ++i)
+                {
+                    offsets[i] = offset;
+                    offset += (0 == _columnStrides[i]) ? 1 : capacity;
+                }
+                values.assign(offset, 0.0f);
+                for (size_t i = 0; i < _columnOffsets.size(); ++i)
+                {
+                    const float* column = _values.data() + _columnOffsets[i];
+                    std::copy(column, column + ((0 == _columnStrides[i]) ? 1 : numValid), values.data() + offsets[i]);
+                }
+                _values.swap(values);
+                _columnOffsets.swap(offsets);
+                _capacity = capacity;
+            }
+            _times.resize(numRows, 0.0);
+        }
+
+        void ResultTimeline::clear()
+        {
+            _times.clear();
+            _values.clear();
+            _capacity = 0;
+            _columnOffsets.clear();
+            _columnStrides.clear();
+        }
+
+        void ResultTimeline::swap(ResultTimeline& other)
+        {
+            _times.swap(other._times);
+            _values.swap(other._values);
+            std::swap(_capacity, other._capacity);
+            _columnOffsets.swap(other._columnOffsets);
+            _columnStrides.swap(other._columnStrides);
+        }
+
+        size_t ResultTimeline::decimate(const double tolerance)
+        {
+            const size_t numRows = _times.size();
+            if (3 > numRows)
+            {
+                return numRows;
+            }
+
+            std::vector<size_t> columns;
+            for (size_t i = 0; i < _columnStrides.size(); ++i)
+            {
+                if (0 != _columnStrides[i])
+                {
+                    columns.push_back(i);
+                }
+            }
+
+            // Range of slopes starting at the anchor that pass all rows since the anchor within the tolerance.
+            const double inf = std::numeric_limits<double>::infinity();
+            std::vector<double> lower(columns.size(), -inf);
+            std::vector<double> upper(columns.size(), inf);
+            std::vector<size_t> keep(1, 0);
+            size_t anchor = 0;
+
+            for (size_t k = 1; k < numRows; ++k)
+            {
+                // Both rows of an event are kept.
+                if (_times[k] <= _times[k - 1])
+                {
+                    if (keep.back() != k - 1)
+                    {
+                        keep.push_back(k - 1);
+                    }
+                    keep.push_back(k);
+                    anchor = k;
+                    std::fill(lower.begin(), lower.end(), -inf);
+                    std::fill(upper.begin(), upper.end(), inf);
+                    continue;
+                }
+
+                // Check whether the segment from the anchor to row k passes all rows in between.
+                double dt = _times[k] - _times[anchor];
+                bool isValid = true;
+                for (size_t j = 0; j < columns.size() && isValid; ++j)
+                {
+                    const float* values = _values.data() + _columnOffsets[columns[j]];
+                    double slope = (static_cast<double>(values[k]) - values[anchor]) / dt;
+                    isValid = (lower[j] <= slope && slope <= upper[j]);
+                }
+
+                // Otherwise, row k - 1 is the last valid end of the segment and starts the next one.
+                if (!isValid)
+                {
+                    keep.push_back(k - 1);
+                    anchor = k - 1;
+                    dt = _times[k] - _times[anchor];
+                    std::fill(lower.begin(), lower.end(), -inf);
+                    std::fill(upper.begin(), upper.end(), inf);
+                }
+
+                // Narrow the slopes such that the segment passes row k within the tolerance.
+                for (size_t j = 0; j < columns.size(); ++j)
+                {
+                    const float* values = _values.data() + _columnOffsets[columns[j]];
+                    double diff = static_cast<double>(values[k]) - values[anchor];
+                    lower[j] = std::max(lower[j], (diff - tolerance) / dt);
+                    upper[j] = std::min(upper[j], (diff + tolerance) / dt);
+                }
+            }
+            if (keep.back() != numRows - 1)
+            {
+                keep.push_back(numRows - 1);
+            }
+
+            // Compact the time points and the time dependent columns in place. Since keep is ascending, every value
+            // is moved to the front.
+            const size_t numKept = keep.size();
+            size_t offset = 0;
+            for (size_t i = 0; i < numKept; ++i)
+            {
+                _times[i] = _times[keep[i]];
+            }
+            for (size_t i = 0; i < _columnOffsets.size(); ++i)
+            {
+                const size_t oldOffset = _columnOffsets[i];
+                _columnOffsets[i] = offset;
+                if (0 == _columnStrides[i])
+                {
+                    _values[offset++] = _values[oldOffset];
+                    continue;
+                }
+                for (size_t j = 0; j < numKept; ++j)
+                {
+                    _values[offset + j] = _values[oldOffset + keep[j]];
+                }
+                offset += numKept;
+            }
+            _times.resize(numKept);
+            _times.shrink_to_fit();
+            _values.resize(offset);
+            _values.shrink_to_fit();
+            _capacity = numKept;
+
+            return numKept;
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        size_t ResultTimeline::getNumColumns() const
+        {
+            return _columnOffsets.size();
+        }
+
+        size_t ResultTimeline::getNumRows() const
+        {
+            return _times.size();
+        }
+
+        double ResultTimeline::getStartTime() const
+        {
+            return _times.empty() ? 0.0 : _times.front();
+        }
+
+        double ResultTimeline::getStopTime() const
+        {
+            return _times.empty() ? 0.0 : _times.back();
+        }
+
+        double* ResultTimeline::getTimes()
+        {
+            return _times.data();
+        }
+
+        const double* ResultTimeline::getTimes() const
+        {
+            return _times.data();
+        }
+
+        float* ResultTimeline::getColumn(const size_t column)
+        {
+            return _values.data() + _columnOffsets[column];
+        }
+
+        const float* ResultTimeline::getColumn(const size_t column) const
+        {
+            return _values.data() + _columnOffsets[column];
+        }
+
+        bool ResultTimeline::isConstColumn(const size_t column) const
+        {
+            return 0 == _columnStrides[column];
+        }
+
+        /*-----------------------------------------
+         * SIMULATION METHODS
+         *---------------------------------------*/
+
+        void ResultTimeline::initFrame(TimelineFrame& frame) const
+        {
+            frame.time = getStartTime();
+            frame.values.assign(getNumColumns(), 0.0);
+            frame.low.assign(getNumColumns(), 0.0);
+            frame.high.assign(getNumColumns(), 0.0);
+        }
+
+        void ResultTimeline::interpolate(const double time, TimelineFrame& frame, TimelineCursor& cursor) const
+        {
+            frame.time = time;
+            if (_times.empty())
+            {
+                return;
+            }
+
+            size_t i1, i2;
+            double w;
+            findBracket(time, cursor, i1, i2, w);
+
+            // Gather the values at the bracket bounds into contiguous buffers.
+            const size_t numColumns = getNumColumns();
+            const float* values = _values.data();
+            for (size_t i = 0; i < numColumns; ++i)
+            {
+                frame.low[i] = values[_columnOffsets[i] + i1 * _columnStrides[i]];
+                frame.high[i] = values[_columnOffsets[i] + i2 * _columnStrides[i]];
+            }
+
+            // Interpolate all columns in one pass.
+            const double* lo = frame.low.data();
+            const double* hi = frame.high.data();
+            double* out = frame.values.data();
+            for (size_t i = 0; i < numColumns; ++i)
+            {
+                out[i] = lo[i] + w * (hi[i] - lo[i]);
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void ResultTimeline::findBracket(const double time, TimelineCursor& cursor, size_t& i1, size_t& i2,
+                                         double& w) const
+        {
+            // upper is the first row with a time point greater than time. For events, the time point is stored twice,
+            // thus, the value after the event is selected.
+            const size_t numRows = _times.size();
+            const double* times = _times.data();
+            size_t upper = numRows;
+            bool found = false;
+
+            if (cursor.isValid && cursor.row < numRows)
+            {
+                size_t row = cursor.row;
+                size_t steps = 0;
+                while (row + 1 < numRows && times[row + 1] <= time && steps < s_maxCursorSteps)
+                {
+                    ++row;
+                    ++steps;
+                }
+                while (0 < row && times[row] > time && steps < s_maxCursorSteps)
+                {
+                    --row;
+                    ++steps;
+                }
+                if (steps < s_maxCursorSteps)
+                {
+                    upper = (times[row] <= time) ? row + 1 : row;
+                    found = true;
+                }
+            }
+
+            if (!found)
+            {
+                upper = static_cast<size_t>(std::upper_bound(times, times + numRows, time) - times);
+            }
+            cursor.row = (0 < upper) ? upper - 1 : 0;
+            cursor.isValid = true;
+
+            i2 = std::min(upper, numRows - 1);
+            i1 = (0 < i2) ? i2 - 1 : 0;
+            w = 0.0;
+            if (times[i2] > times[i1])
+            {
+                w = (std::min(std::max(time, times[i1]), times[i2]) - times[i1]) / (times[i2] - times[i1]);
+            }
+            else if (time >= times[i2])
+            {
+                i1 = i2;
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
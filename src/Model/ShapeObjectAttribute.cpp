@@ -29,7 +29,8 @@ namespace OMVIS
                 : isConst(true),
                   exp(0.0),
                   cref("NONE"),
-                  fmuValueRef(0)
+                  fmuValueRef(0),
+                  varIdx(0)
         {
         }
 
@@ -37,13 +38,14 @@ namespace OMVIS
                 : isConst(true),
                   exp((float)value),
                   cref("NONE"),
-                  fmuValueRef(0)
+                  fmuValueRef(0),
+                  varIdx(0)
         {
         }
 
         std::string ShapeObjectAttribute::getValueString() const
         {
-            return std::to_string(exp) + " (" + std::to_string(fmuValueRef) + ") Is const: "
+            return std::to_string(exp) + " (" + std::to_string(varIdx) + ") Is const: "
                     + Util::boolToString(isConst);
 //                    std::to_string(static_cast<int>(isConst)) + " ";
         }
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/TransformCache.hpp"
+#include "Util/Hash.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Identifies a cache file.
+        static const char s_cacheMagic[8] = {'O', 'M', 'V', 'I', 'S', 'T', 'C', '\0'};
+        /// Increment whenever the layout of the cache file changes.
+        static const uint32_t s_cacheVersion = 1;
+        /// Number of bytes hashed at the beginning and at the end of the MAT file.
+        static const size_t s_hashedBytes = 1 << 20;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        TransformCache::TransformCache()
+                : _file(),
+                  _numShapes(0),
+                  _numFrames(0),
+                  _times(nullptr),
+                  _frames(nullptr),
+                  _writeFileName(),
+                  _writeStream(),
+                  _numFramesToWrite(0)
+        {
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        std::string TransformCache::getCacheFileName(const std::string& matFileName)
+        {
+            return matFileName + ".bake";
+        }
+
+        uint64_t TransformCache::computeKey(const std::string& matFileName, const std::string& xmlFileName)
+        {
+            uint64_t key = Util::hashValue(s_cacheVersion);
+
+            std::ifstream xml(xmlFileName, std::ios::binary);
+            if (!xml)
+            {
+                throw std::runtime_error("Could not read visual XML file " + xmlFileName + ".");
+            }
+            std::string content((std::istreambuf_iterator<char>(xml)), std::istreambuf_iterator<char>());
+            key = Util::hashString(content, key);
+
+            std::ifstream mat(matFileName, std::ios::binary);
+            if (!mat)
+            {
+                throw std::runtime_error("Could not read MAT file " + matFileName + ".");
+            }
+            uint64_t size = boost::filesystem::file_size(matFileName);
+            int64_t modTime = boost::filesystem::last_write_time(matFileName);
+            key = Util::hashValue(size, key);
+            key = Util::hashValue(modTime, key);
+
+            std::vector<char> buffer(static_cast<size_t>(std::min<uint64_t>(size, s_hashedBytes)));
+            mat.read(buffer.data(), buffer.size());
+            key = Util::hashBytes(buffer.data(), buffer.size(), key);
+            if (size > s_hashedBytes)
+            {
+                mat.seekg(size - s_hashedBytes);
+                mat.read(buffer.data(), buffer.size());
+                key = Util::hashBytes(buffer.data(), buffer.size(), key);
+            }
+            return key;
+        }
+
+        bool TransformCache::open(const std::string& fileName, const uint64_t key, const size_t numShapes)
+        {
+            close();
+
+            if (!boost::filesystem::exists(fileName))
+            {
+                return false;
+            }
+            try
+            {
+                _file.open(fileName);
+            }
+            catch (std::exception&)
+            {
+                return false;
+            }
+
+            CacheHeader hdr;
+            if (sizeof(CacheHeader) > _file.size())
+            {
+                close();
+                return false;
+            }
+            std::memcpy(&hdr, _file.data(), sizeof(CacheHeader));
+
+            size_t expectedSize = sizeof(CacheHeader)
+                    + hdr.numFrames * (sizeof(double) + hdr.numShapes * sizeof(BakedShape));
+            if (0 != std::memcmp(hdr.magic, s_cacheMagic, sizeof(s_cacheMagic)) || s_cacheVersion != hdr.version
+                    || sizeof(BakedShape) != hdr.shapeSize || key != hdr.key || numShapes != hdr.numShapes
+                    || 0 == hdr.numFrames || expectedSize != _file.size())
+            {
+                close();
+                return false;
+            }
+
+            // The header and the time points are multiples of 8 bytes, thus, the data is properly aligned.
+            _numShapes = hdr.numShapes;
+            _numFrames = hdr.numFrames;
+            _times = reinterpret_cast<const double*>(_file.data() + sizeof(CacheHeader));
+            _frames = reinterpret_cast<const BakedShape*>(_times + _numFrames);
+            return true;
+        }
+
+        void TransformCache::close()
+        {
+            if (_file.is_open())
+            {
+                _file.close();
+            }
+            _numShapes = 0;
+            _numFrames = 0;
+            _times = nullptr;
+            _frames = nullptr;
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool TransformCache::isOpen() const
+        {
+            return nullptr != _frames;
+        }
+
+        size_t TransformCache::getNumFrames() const
+        {
+            return _numFrames;
+        }
+
+        size_t TransformCache::getNumShapes() const
+        {
+            return _numShapes;
+        }
+
+        double TransformCache::getStartTime() const
+        {
+            return (0 == _numFrames) ? 0.0 : _times[0];
+        }
+
+        double TransformCache::getStopTime() const
+        {
+            return (0 == _numFrames) ? 0.0 : _times[_numFrames - 1];
+        }
+
+        size_t TransformCache::findFrame(const double time) const
+        {
+            auto upper = static_cast<size_t>(std::upper_bound(_times, _times + _numFrames, time) - _times);
+            return (0 < upper) ? upper - 1 : 0;
+        }
+
+        const BakedShape* TransformCache::getFrame(const size_t frame) const
+        {
+            return _frames + frame * _numShapes;
+        }
+
+        /*-----------------------------------------
+         * WRITE METHODS
+         *---------------------------------------*/
+
+        void TransformCache::beginWrite(const std::string& fileName, const uint64_t key, const size_t numShapes,
+                                        const std::vector<double>& times)
+        {
+            close();
+            _writeFileName = fileName;
+            _writeStream.open(fileName + ".tmp", std::ios::binary | std::ios::trunc);
+            if (!_writeStream)
+            {
+                throw std::runtime_error("Could not create cache file " + fileName + ".tmp.");
+            }
+
+            CacheHeader hdr;
+            std::memcpy(hdr.magic, s_cacheMagic, sizeof(s_cacheMagic));
+            hdr.version = s_cacheVersion;
+            hdr.shapeSize = sizeof(BakedShape);
+            hdr.numShapes = numShapes;
+            hdr.numFrames = times.size();
+            hdr.key = key;
+            _writeStream.write(reinterpret_cast<const char*>(&hdr), sizeof(CacheHeader));
+            _writeStream.write(reinterpret_cast<const char*>(times.data()), times.size() * sizeof(double));
+
+            _numShapes = numShapes;
+            _numFramesToWrite = times.size();
+        }
+
+        void TransformCache::writeFrame(const BakedShape* shapes)
+        {
+            if (0 == _numFramesToWrite)
+            {
+                throw std::runtime_error("Too many frames written to cache file " + _writeFileName + ".");
+            }
+            _writeStream.write(reinterpret_cast<const char*>(shapes), _numShapes * sizeof(BakedShape));
+            --_numFramesToWrite;
+        }
+
+        void TransformCache::endWrite()
+        {
+            bool isComplete = (0 == _numFramesToWrite) && _writeStream.good();
+            _writeStream.close();
+            _numShapes = 0;
+            std::string tmpFileName = _writeFileName + ".tmp";
+            if (!isComplete || 0 != std::rename(tmpFileName.c_str(), _writeFileName.c_str()))
+            {
+                std::remove(tmpFileName.c_str());
+                throw std::runtime_error("Could not write cache file " + _writeFileName + ".");
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
@@ -24,12 +24,48 @@
 #include <osgDB/ReadFile>
 
 #include <exception>
+#include <utility>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        /// Calls func for each attribute of the shape that may reference a variable.
+        template <typename Func>
+        static void forEachAttribute(ShapeObject& shape, Func func)
+        {
+            func(shape._length);
+            func(shape._width);
+            func(shape._height);
+            for (auto& attr : shape._lDir)
+            {
+                func(attr);
+            }
+            for (auto& attr : shape._wDir)
+            {
+                func(attr);
+            }
+            for (auto& attr : shape._r)
+            {
+                func(attr);
+            }
+            for (auto& attr : shape._rShape)
+            {
+                func(attr);
+            }
+            for (auto& attr : shape._color)
+            {
+                func(attr);
+            }
+            for (auto& attr : shape._T)
+            {
+                func(attr);
+            }
+            func(shape._specCoeff);
+            func(shape._extra);
+        }
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
@@ -38,6 +74,7 @@ namespace OMVIS
                 : _modelFile(modelFile),
                   _path(path),
                   _xmlDoc(),
+                  _visVariables(),
                   _shapes(),
                   _xmlFileName(Util::getXMLFileName(modelFile, path))
         {
@@ -81,6 +118,8 @@ namespace OMVIS
             auto rootNode = _xmlDoc.first_node();
             rapidxml::xml_node<>* expNode;
             Model::ShapeObject shape;
+            std::unordered_map<std::string, unsigned int> crefIndices;
+            _visVariables.clear();
 
             //Begin std::vector<T>::reserve()
             //int i = 0;
@@ -194,11 +233,80 @@ namespace OMVIS
                     expNode = shapeNode->first_node("extra")->first_node();
                     shape._extra = Util::getObjectAttributeForNode(expNode);
 
+                    forEachAttribute(shape, [this, &crefIndices](ShapeObjectAttribute& attr)
+                    {
+                        internVisVariable(attr, crefIndices);
+                    });
                     _shapes.push_back(shape);
                 }
             }  // end for-loop
 
-            //std::vector<std::string> vs = getVisualizationVariables();
+            LOGGER_WRITE("There are " + std::to_string(_visVariables.size()) + " visualization variables.",
+                         Util::LC_LOADER, Util::LL_INFO);
+        }
+
+        void VisualBase::internVisVariable(ShapeObjectAttribute& attr,
+                                           std::unordered_map<std::string, unsigned int>& crefIndices)
+        {
+            if (attr.isConst)
+            {
+                return;
+            }
+
+            auto it = crefIndices.find(attr.cref);
+            if (crefIndices.end() != it)
+            {
+                attr.varIdx = it->second;
+                return;
+            }
+            attr.varIdx = static_cast<unsigned int>(_visVariables.size());
+            _visVariables.push_back(attr.cref);
+            crefIndices[attr.cref] = attr.varIdx;
+        }
+
+        void VisualBase::removeVisVariables(const std::vector<bool>& isMissing)
+        {
+            // Compact the table and remember the new index of each remaining variable.
+            std::vector<unsigned int> newIndices(_visVariables.size(), 0);
+            unsigned int numKept = 0;
+            for (size_t i = 0; i < _visVariables.size(); ++i)
+            {
+                if (!isMissing[i])
+                {
+                    newIndices[i] = numKept;
+                    if (numKept != i)
+                    {
+                        _visVariables[numKept] = std::move(_visVariables[i]);
+                    }
+                    ++numKept;
+                }
+            }
+            if (numKept == _visVariables.size())
+            {
+                return;
+            }
+
+            for (auto& shape : _shapes)
+            {
+                forEachAttribute(shape, [&isMissing, &newIndices](ShapeObjectAttribute& attr)
+                {
+                    if (attr.isConst)
+                    {
+                        return;
+                    }
+                    if (isMissing[attr.varIdx])
+                    {
+                        attr.isConst = true;
+                        attr.exp = 0.0;
+                        attr.varIdx = 0;
+                    }
+                    else
+                    {
+                        attr.varIdx = newIndices[attr.varIdx];
+                    }
+                });
+            }
+            _visVariables.resize(numKept);
         }
 
         void VisualBase::clearXMLDoc()
@@ -230,109 +338,9 @@ namespace OMVIS
             return _xmlFileName;
         }
 
-        void VisualBase::appendVisVariable(const rapidxml::xml_node<>* node,
-                                             std::vector<std::string>& visVariables) const
-        {
-            if (0 == strcmp("cref", node->name()))
-            {
-                char* cref = node->value();
-                visVariables.push_back(std::string(cref));
-            }
-        }
-
-        std::vector<std::string> VisualBase::getVisualizationVariables() const
+        const std::vector<std::string>& VisualBase::getVisualizationVariables() const
         {
-            auto rootNode = _xmlDoc.first_node();
-            rapidxml::xml_node<>* expNode;
-            Model::ShapeObject shape;
-
-            // Oh yes, I know how large this vector will be.
-            std::vector<std::string> visVariables;
-            visVariables.reserve(_shapes.size());
-
-            for (auto shapeNode = rootNode->first_node("shape"); shapeNode != nullptr;
-                    shapeNode = shapeNode->next_sibling())
-            {
-                expNode = shapeNode->first_node("ident")->first_node();
-                shape._id = std::string(expNode->value());
-
-                expNode = shapeNode->first_node("type")->first_node();
-                if (expNode == nullptr)
-                {
-                    LOGGER_WRITE("The type of  " + shape._id + " is not supported right in the visxml file.",
-                                 Util::LC_LOADER, Util::LL_DEBUG);
-                    break;
-                }
-
-                shape._type = std::string(expNode->value());
-
-                expNode = shapeNode->first_node("length")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = shapeNode->first_node("width")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = shapeNode->first_node("height")->first_node();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("lengthDir")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("widthDir")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("r")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("r_shape")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("color")->first_node();
-                shape._color[0] = Util::getObjectAttributeForNode(expNode);
-                expNode = expNode->next_sibling();
-                shape._color[1] = Util::getObjectAttributeForNode(expNode);
-                expNode = expNode->next_sibling();
-                shape._color[2] = Util::getObjectAttributeForNode(expNode);
-
-                expNode = shapeNode->first_node("T")->first_node();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-                expNode = expNode->next_sibling();
-                appendVisVariable(expNode, visVariables);
-
-                expNode = shapeNode->first_node("specCoeff")->first_node();
-                appendVisVariable(expNode, visVariables);
-            }
-            LOGGER_WRITE("There are " + std::to_string(visVariables.size()) + " visualization variables.",
-                         Util::LC_LOADER, Util::LL_INFO);
-            return visVariables;
+            return _visVariables;
         }
 
     }  // namespace Model
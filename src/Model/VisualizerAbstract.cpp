@@ -22,6 +22,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include <chrono>
 #include <stdlib.h>
 #include <string>
 
@@ -39,7 +40,9 @@ namespace OMVIS
                   _baseData(nullptr),
                   _viewerStuff(nullptr),
                   _nodeUpdater(nullptr),
-                  _timeManager(nullptr)
+                  _timeManager(nullptr),
+                  _isProfiling(false),
+                  _frameTimings()
         {
         }
 
@@ -49,7 +52,9 @@ namespace OMVIS
                   _baseData(nullptr),
                   _viewerStuff(std::make_shared<OMVISScene>()),
                   _nodeUpdater(std::make_shared<Model::UpdateVisitor>()),
-                  _timeManager(std::make_shared<Control::TimeManager>(0.0, 0.0, 0.0, 0.0, 0.1, 0.0, 100.0))
+                  _timeManager(std::make_shared<Control::TimeManager>(0.0, 0.0, 0.0, 0.0, 0.1, 0.0, 100.0)),
+                  _isProfiling(false),
+                  _frameTimings()
         {
             // We need the absolute path to the directory. Otherwise the FMUlibrary can not open the shared objects.
             //char fullPathTmp[PATH_MAX];
@@ -121,13 +126,33 @@ namespace OMVIS
             return _baseData->getModelFile();
         }
 
+        void VisualizerAbstract::setProfiling(const bool isProfiling)
+        {
+            _isProfiling = isProfiling;
+            _frameTimings = FrameTimings();
+        }
+
+        const FrameTimings& VisualizerAbstract::getFrameTimings() const
+        {
+            return _frameTimings;
+        }
+
+        double VisualizerAbstract::profilingTick() const
+        {
+            if (!_isProfiling)
+            {
+                return 0.0;
+            }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
         /*-----------------------------------------
          * SIMULATION METHODS
          *---------------------------------------*/
 
         void VisualizerAbstract::startVisualization()
         {
-            if (_timeManager->getVisTime() < _timeManager->getEndTime() - 1.e-6)
+            if (_timeManager->getVisTime() < _timeManager->getEndTime() - 1.e-6 || waitsAtEndTime())
             {
                 _timeManager->setPause(false);
                 LOGGER_WRITE("Start visualization ...", Util::LC_CTR, Util::LL_INFO);
@@ -155,13 +180,32 @@ namespace OMVIS
             _timeManager->setPause(true);
         }
 
+        void VisualizerAbstract::setVisTime(const double visTime)
+        {
+            _timeManager->setVisTime(visTime);
+        }
+
+        bool VisualizerAbstract::waitsAtEndTime() const
+        {
+            return false;
+        }
+
         void VisualizerAbstract::sceneUpdate()
         {
             _timeManager->updateTick();
 
             if (!_timeManager->isPaused())
             {
+                // The time that is not spent on the shapes is spent on fetching the frame.
+                const double start = profilingTick();
+                const double shapeTime = _frameTimings.transform + _frameTimings.sceneUpdate;
                 updateScene(_timeManager->getVisTime());
+                if (_isProfiling)
+                {
+                    _frameTimings.fetch += profilingTick() - start - (_frameTimings.transform
+                            + _frameTimings.sceneUpdate - shapeTime);
+                    ++_frameTimings.numUpdates;
+                }
                 _timeManager->setVisTime(_timeManager->getVisTime() + _timeManager->getHVisual());
 
                 LOGGER_WRITE(
@@ -171,8 +215,16 @@ namespace OMVIS
                         Util::LC_CTR, Util::LL_INFO);
                 if (_timeManager->getVisTime() >= _timeManager->getEndTime() - 1.e-6)
                 {
-                    LOGGER_WRITE("The End.", Util::LC_CTR, Util::LL_INFO);
-                    _timeManager->setPause(true);
+                    // Hold the last time point until further results arrive.
+                    if (waitsAtEndTime())
+                    {
+                        _timeManager->setVisTime(_timeManager->getEndTime());
+                    }
+                    else
+                    {
+                        LOGGER_WRITE("The End.", Util::LC_CTR, Util::LL_INFO);
+                        _timeManager->setPause(true);
+                    }
                 }
             }
         }
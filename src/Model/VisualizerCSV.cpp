@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/VisualizerCSV.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Util.hpp"
+
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        VisualizerCSV::VisualizerCSV(const std::string& modelFile, const std::string& path)
+                : VisualizerMAT(modelFile, path, VisType::CSV),
+                  _csvReader()
+        {
+        }
+
+        /*-----------------------------------------
+         * RESULT FILE METHODS
+         *---------------------------------------*/
+
+        void VisualizerCSV::openResultFile()
+        {
+            std::string resFileName = _baseData->getPath() + _baseData->getModelFile();
+
+            // Check if the CSV file exists.
+            if (!Util::fileExists(resFileName))
+            {
+                auto msg = "Could not find CSV file " + resFileName + ".";
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+
+            try
+            {
+                _csvReader.open(resFileName);
+            }
+            catch (std::exception& ex)
+            {
+                std::string msg(ex.what());
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+        }
+
+        void VisualizerCSV::closeResultFile()
+        {
+            _csvReader.close();
+        }
+
+        size_t VisualizerCSV::refreshResultFile()
+        {
+            return _csvReader.getNumRows();
+        }
+
+        bool VisualizerCSV::isResultFileComplete() const
+        {
+            return true;
+        }
+
+        bool VisualizerCSV::findResultVariable(const std::string& name, MatVariableRef& ref) const
+        {
+            int column = _csvReader.findColumn(name);
+            if (0 > column)
+            {
+                return false;
+            }
+
+            // CSV files neither distinguish parameters nor store aliases.
+            ref.isParam = false;
+            ref.index = static_cast<size_t>(column);
+            ref.sign = 1.0;
+            return true;
+        }
+
+        size_t VisualizerCSV::getNumResultRows() const
+        {
+            return _csvReader.getNumRows();
+        }
+
+        void VisualizerCSV::readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow)
+        {
+            if (0 != firstRow || 0 != timelineRow || numRows != _csvReader.getNumRows())
+            {
+                throw std::logic_error("CSV files can only be read completely.");
+            }
+
+            std::vector<size_t> columns(_matVarRefs.size());
+            std::vector<float*> out(_matVarRefs.size());
+            for (size_t i = 0; i < _matVarRefs.size(); ++i)
+            {
+                columns[i] = _matVarRefs[i].index;
+                out[i] = _timeline.getColumn(i);
+            }
+
+            try
+            {
+                _csvReader.readColumns(columns, _timeline.getTimes(), out);
+            }
+            catch (std::exception& ex)
+            {
+                std::string msg(ex.what());
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
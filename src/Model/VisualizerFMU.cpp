@@ -23,39 +23,119 @@
 
 #include <SDL.h>
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
 
 namespace OMVIS
 {
     namespace Model
     {
 
+        /// Distance in meters along the x axis between the shapes of consecutive members of an ensemble.
+        static const float s_memberOffset = 1.0f;
+        /// Relative shift of the states between consecutive members of an ensemble.
+        static const double s_memberPerturbation = 0.05;
+        /// Colors the shapes of the members of an ensemble are tinted with. The first member keeps its colors.
+        static const float s_memberColors[][3] = { { 230.0f, 25.0f, 75.0f }, { 60.0f, 180.0f, 75.0f },
+                                                   { 0.0f, 130.0f, 200.0f }, { 245.0f, 130.0f, 48.0f },
+                                                   { 145.0f, 30.0f, 180.0f }, { 70.0f, 240.0f, 240.0f } };
+        static const size_t s_numMemberColors = sizeof(s_memberColors) / sizeof(s_memberColors[0]);
+
+        /// Maximum size of the encoded frames of the history in bytes.
+        static const size_t s_historySize = 64 * 1024 * 1024;
+        /// Number of frames of the history from one key frame to the next one.
+        static const size_t s_historyKeyFrameInterval = 32;
+
+        const double VisualizerFMU::s_checkpointInterval = 1.0;
+
+        /// Returns the time of a monotonic wall clock in seconds.
+        static double getWallTime()
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
 
-        VisualizerFMU::VisualizerFMU(const std::string& modelFile, const std::string& path)
+        VisualizerFMU::VisualizerFMU(const std::string& modelFile, const std::string& path, const size_t numMembers)
                 : VisualizerAbstract(modelFile, path, VisType::FMU),
                   _fmu(std::make_shared<FMUWrapper>()),
+                  _members(),
+                  _memberPool(nullptr),
+                  _numShapes(0),
                   _simSettings(std::make_shared<SimSettingsFMU>()),
                   _inputData(std::make_shared<InputData>()),
-                  _joysticks()
+                  _valueRefs(),
+                  _values(),
+                  _frames(s_numFrames),
+                  _simulationThread(),
+                  _isSimulating(false),
+                  _simVisTime(0.0),
+                  _simHVisual(0.0),
+                  _simEndTime(0.0),
+                  _pacing(),
+                  _isPaced(true),
+                  _numSolverSteps(0),
+                  _simNextCheckpointTime(0.0),
+                  _history(s_historySize, s_historyKeyFrameInterval),
+                  _checkpoints(),
+                  _isRewound(false),
+                  _recorder(),
+                  _isRecording(false),
+                  _recordOutputRefs(),
+                  _recordRow(),
+                  _joysticks(),
+                  _joystickInput()
         {
+            if (0 == numMembers)
+            {
+                throw std::invalid_argument("An ensemble needs at least one member.");
+            }
+            _members.push_back(_fmu);
+            for (size_t i = 1; i < numMembers; ++i)
+            {
+                _members.push_back(std::make_shared<FMUWrapper>());
+            }
+            if (1 < numMembers)
+            {
+                // The simulation thread steps a member as well.
+                const size_t numCores = std::max(std::thread::hardware_concurrency(), 1u);
+                _memberPool.reset(new Util::ThreadPool(std::min(numMembers, numCores) - 1));
+            }
+
             LOGGER_WRITE("Initialize joysticks", Util::LC_LOADER, Util::LL_INFO);
             initJoySticks();
         }
 
+        VisualizerFMU::~VisualizerFMU()
+        {
+            stopSimulationThread();
+            stopRecording();
+        }
+
         /*-----------------------------------------
          * INITIALIZATION METHODS
          *---------------------------------------*/
 
         void VisualizerFMU::initData()
         {
+            stopSimulationThread();
+            stopRecording();
             VisualizerAbstract::initData();
             loadFMU(_baseData->getModelFile(), _baseData->getPath());
             _simSettings->setTend(_timeManager->getEndTime());
             _simSettings->setHdef(0.001);
+            replicateShapes();
             setVarReferencesInVisAttributes();
+            fetchVisVariables(_values);
+            resetFrames(_timeManager->getStartTime());
+            resetHistory(_timeManager->getStartTime());
 
             //OMVisualizerFMU::initializeVisAttributes(_omvManager->getStartTime());
         }
@@ -70,7 +150,18 @@ namespace OMVIS
             _fmu->load(modelFile, path);
             LOGGER_WRITE("VisualizerFMU::loadFMU: FMU was successfully loaded.", Util::LC_LOADER, Util::LL_DEBUG);
 
-            _fmu->initialize(_simSettings);
+            // The further members share the extracted FMU.
+            for (size_t i = 1; i < _members.size(); ++i)
+            {
+                _members[i]->loadExtracted(_fmu->getExtractionPath());
+            }
+            if (1 < _members.size())
+            {
+                LOGGER_WRITE("VisualizerFMU::loadFMU: " + std::to_string(_members.size()) + " instances of the FMU were "
+                             "successfully loaded.", Util::LC_LOADER, Util::LL_DEBUG);
+            }
+
+            initializeMembers();
             LOGGER_WRITE("VisualizerFMU::loadFMU: FMU was successfully initialized.", Util::LC_LOADER, Util::LL_DEBUG);
 
             _inputData->initializeInputs(_fmu->getFMU());
@@ -85,9 +176,55 @@ namespace OMVIS
             //}
         }
 
+        void VisualizerFMU::initializeMembers()
+        {
+            for (size_t i = 0; i < _members.size(); ++i)
+            {
+                _members[i]->initialize(_simSettings);
+                if (0 < i)
+                {
+                    _members[i]->perturbContinuousStates(i * s_memberPerturbation);
+                }
+            }
+            // The initialized FMU does not know the current input values.
+            std::lock_guard<std::mutex> lock(_inputData->getMutex());
+            _inputData->invalidateInputsInFMU();
+            for (auto& joystick : _joysticks)
+            {
+                joystick->invalidateAppliedInputs();
+            }
+        }
+
+        void VisualizerFMU::replicateShapes()
+        {
+            _numShapes = _baseData->_shapes.size();
+            _baseData->_shapes.reserve(_numShapes * _members.size());
+            for (size_t member = 1; member < _members.size(); ++member)
+            {
+                const float* color = s_memberColors[(member - 1) % s_numMemberColors];
+                for (size_t i = 0; i < _numShapes; ++i)
+                {
+                    ShapeObject shape = _baseData->_shapes[i];
+                    shape._id += "_" + std::to_string(member);
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        // The colors are not updated during the simulation, thus, the tint is kept constant.
+                        shape._color[j].exp = 0.5f * (shape._color[j].exp + color[j]);
+                        shape._color[j].isConst = true;
+                    }
+                    _baseData->_shapes.push_back(shape);
+                }
+            }
+        }
+
         void VisualizerFMU::resetInputs()
         {
+            std::lock_guard<std::mutex> lock(_inputData->getMutex());
             _inputData->resetInputValues();
+            for (auto& joystick : _joysticks)
+            {
+                joystick->invalidateAppliedInputs();
+            }
         }
 
         void VisualizerFMU::initJoySticks()
@@ -123,6 +260,7 @@ namespace OMVIS
                                      Util::LC_LOADER, Util::LL_INFO);
                     }
                 }
+                _joystickInput.start(_joysticks);
             }
         }
 
@@ -135,67 +273,44 @@ namespace OMVIS
             return _fmu.get();
         }
 
-        std::shared_ptr<InputData> VisualizerFMU::getInputData() const
+        size_t VisualizerFMU::getNumMembers() const
         {
-            return _inputData;
+            return _members.size();
         }
 
-        fmi1_value_reference_t VisualizerFMU::getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr)
+        std::shared_ptr<InputData> VisualizerFMU::getInputData() const
         {
-            fmi1_value_reference_t vr = 0;
-            if (!attr->isConst)
-            {
-                fmi1_import_variable_t* var = fmi1_import_get_variable_by_name(_fmu->getFMU(), attr->cref.c_str());
-                vr = fmi1_import_get_variable_vr(var);
-            }
-            return vr;
+            return _inputData;
         }
 
         int VisualizerFMU::setVarReferencesInVisAttributes()
         {
             int isOk(0);
+            const auto& visVariables = _baseData->getVisualizationVariables();
+            std::vector<bool> isMissing(visVariables.size(), false);
+            _valueRefs.clear();
+            _valueRefs.reserve(visVariables.size());
 
             try
             {
-                size_t i = 0;
-                for (auto& shape : _baseData->_shapes)
+                for (size_t i = 0; i < visVariables.size(); ++i)
                 {
-                    shape = _baseData->_shapes[i];
-
-                    shape._length.fmuValueRef = getVarReferencesForObjectAttribute(&shape._length);
-                    shape._width.fmuValueRef = getVarReferencesForObjectAttribute(&shape._width);
-                    shape._height.fmuValueRef = getVarReferencesForObjectAttribute(&shape._height);
-
-                    shape._lDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[0]);
-                    shape._lDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[1]);
-                    shape._lDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[2]);
-
-                    shape._wDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[0]);
-                    shape._wDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[1]);
-                    shape._wDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[2]);
-
-                    shape._r[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[0]);
-                    shape._r[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[1]);
-                    shape._r[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[2]);
-
-                    shape._rShape[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[0]);
-                    shape._rShape[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[1]);
-                    shape._rShape[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[2]);
-
-                    shape._T[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[0]);
-                    shape._T[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[1]);
-                    shape._T[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[2]);
-                    shape._T[3].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[3]);
-                    shape._T[4].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[4]);
-                    shape._T[5].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[5]);
-                    shape._T[6].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[6]);
-                    shape._T[7].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[7]);
-                    shape._T[8].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[8]);
-
-                    //shape.dumpVisAttributes();
-                    _baseData->_shapes.at(i) = shape;
-                    ++i;
-                }  //end for
+                    fmi1_import_variable_t* var = fmi1_import_get_variable_by_name(_fmu->getFMU(),
+                                                                                   visVariables[i].c_str());
+                    if (nullptr == var)
+                    {
+                        LOGGER_WRITE("Did not get variable from FMU. Variable name is " + visVariables[i] + ".",
+                                     Util::LC_LOADER, Util::LL_ERROR);
+                        isMissing[i] = true;
+                    }
+                    else
+                    {
+                        _valueRefs.push_back(fmi1_import_get_variable_vr(var));
+                    }
+                }
+                // Thereby, the value of each variable in _values is at its index in the variable table.
+                _baseData->removeVisVariables(isMissing);
+                _values.assign(_valueRefs.size() * _members.size(), 0.0);
             }  // end try
 
             catch (std::exception& e)
@@ -209,6 +324,7 @@ namespace OMVIS
 
         void VisualizerFMU::setSimulationSettings(const UserSimSettingsFMU& simSetFMU)
         {
+            stopSimulationThread();
             if (Solver::NONE == simSetFMU.solver)
             {
                 throw std::runtime_error("Solver: NONE is not a valid solver.");
@@ -236,12 +352,48 @@ namespace OMVIS
             {
                 _timeManager->setEndTime(simSetFMU.simEndTime);
             }
+
+            if (0.0 >= simSetFMU.visStepSize)
+            {
+                throw std::runtime_error(
+                        "Visualization step size of " + std::to_string(simSetFMU.visStepSize) + " is not valid.");
+            }
+            else
+            {
+                _timeManager->setHVisual(simSetFMU.visStepSize / 1000.0);
+            }
+
+            if (0.0 >= simSetFMU.realTimeFactor)
+            {
+                throw std::runtime_error("Real time factor <= 0.0 is not valid.");
+            }
+            else
+            {
+                _pacing.setTargetRealTimeFactor(simSetFMU.realTimeFactor);
+            }
+        }
+
+        bool VisualizerFMU::isRecording() const
+        {
+            return _isRecording;
+        }
+
+        void VisualizerFMU::setPaced(const bool isPaced)
+        {
+            stopSimulationThread();
+            _isPaced = isPaced;
+        }
+
+        size_t VisualizerFMU::getNumSolverSteps() const
+        {
+            return _numSolverSteps.load(std::memory_order_relaxed);
         }
 
         UserSimSettingsFMU VisualizerFMU::getCurrentSimSettings() const
         {
             return
-            {   _simSettings->getSolver(), _simSettings->getHdef(), 99, _timeManager->getEndTime()};
+            {   _simSettings->getSolver(), _simSettings->getHdef(), _timeManager->getHVisual() * 1000.0,
+                _timeManager->getEndTime(), _pacing.getTargetRealTimeFactor()};
         }
 
         /*-----------------------------------------
@@ -253,39 +405,51 @@ namespace OMVIS
         {
             while (omvm.getSimTime() < omvm.getRealTime() + omvm.getHVisual() && omvm.getSimTime() < omvm.getEndTime())
             {
-                omvm.setSimTime(simulateStep(omvm.getSimTime()));
+                omvm.setSimTime(simulateStep(*_fmu, omvm.getSimTime()));
             }
         }
 
-        double VisualizerFMU::simulateStep(const double time)
+        double VisualizerFMU::simulateStep(FMUWrapper& fmu, const double time)
         {
-            _fmu->prepareSimulationStep(time);
+            const bool isSteered = (&fmu == _fmu.get());
+            fmu.prepareSimulationStep(time);
 
             /* Check if an event indicator has triggered */
-            bool zeroCrossingEvent = _fmu->checkForTriggeredEvent();
+            bool zeroCrossingEvent = fmu.checkForTriggeredEvent();
 
             /* Handle any events */
-            if ((nullptr != _simSettings->getCallEventUpdate()) || zeroCrossingEvent || _fmu->itsEventTime())
+            if ((nullptr != _simSettings->getCallEventUpdate()) || zeroCrossingEvent || fmu.itsEventTime())
             {
-                _fmu->handleEvents(_simSettings->getIntermediateResults());
+                fmu.handleEvents(_simSettings->getIntermediateResults());
             }
 
-            /* Updated next time step */
-            _fmu->updateNextTimeStep(_simSettings->getHdef());
+            /* Updated next time step. The adaptive solver proposes the step size, limited by the simulation one. */
+            if (Solver::DORMAND_PRINCE == _simSettings->getSolver())
+            {
+                fmu.updateNextTimeStep(std::min(fmu.getFMUData()->_hnext, _simSettings->getHdef()));
+            }
+            else
+            {
+                fmu.updateNextTimeStep(_simSettings->getHdef());
+            }
 
             /* last step */
-            _fmu->updateTimes(_simSettings->getTend());
+            fmu.updateTimes(_simSettings->getTend());
 
             // Set inputs.
-            for (auto& joystick : _joysticks)
+            if (isSteered)
             {
-                joystick->detectContinuousInputEvents(_inputData);
+                std::lock_guard<std::mutex> lock(_inputData->getMutex());
+                for (auto& joystick : _joysticks)
+                {
+                    joystick->applyInputs(_inputData);
+                }
+                _inputData->setInputsInFMU(_fmu->getFMU());
+                //_inputData->printValues();
             }
-            _inputData->setInputsInFMU(_fmu->getFMU());
-            //_inputData->printValues();
 
             /* Solve system */
-            _fmu->solveSystem();
+            fmu.solveSystem();
 
             //print out some values for debugging:
             //std::cout<<"DO EULER at "<< _fmu->getFMUData()->_tcur<<std::endl;
@@ -295,26 +459,84 @@ namespace OMVIS
             //fmi1_import_get_real(_fmul._fmu, &vr, 1, &value);
             //std::cout<<"value "<<value<<std::endl;
 
-            // integrate a step with euler
-            _fmu->doEulerStep();
+            // Integrate a step with the selected solver.
+            switch (_simSettings->getSolver())
+            {
+                case Solver::RUNGE_KUTTA_4:
+                    fmu.doRungeKuttaStep();
+                    break;
+                case Solver::DORMAND_PRINCE:
+                    fmu.doDormandPrinceStep(_simSettings->getRelativeTolerance());
+                    break;
+                case Solver::BACKWARD_EULER:
+                    fmu.doBackwardEulerStep(_simSettings->getRelativeTolerance());
+                    break;
+                default:
+                    fmu.doEulerStep();
+                    break;
+            }
+
+            /* Shorten the step to the first state event inside of it */
+            fmu.locateStateEvent();
 
             /* Set states */
-            _fmu->setContinuousStates();
+            fmu.setContinuousStates();
 
             /* Step is complete */
-            _fmu->completedIntegratorStep(_simSettings->getCallEventUpdate());
+            fmu.completedIntegratorStep(_simSettings->getCallEventUpdate());
 
             //vw: since we are detecting changing inputs, we have to keep the values during the steps. do not reset it
-            _inputData->resetDiscreteInputValues();
-            return _fmu->getFMUData()->_tcur;
+            if (isSteered)
+            {
+                std::lock_guard<std::mutex> lock(_inputData->getMutex());
+                _inputData->resetDiscreteInputValues();
+            }
+            return fmu.getFMUData()->_tcur;
+        }
+
+        double VisualizerFMU::simulateMembers(const double nextTime, std::vector<fmi1_real_t>& values)
+        {
+            double simTime = _fmu->getTcur();
+            auto simulateMember = [this, nextTime, &values, &simTime](size_t member)
+            {
+                // The states of a member belong to its own time, which may be after the last visualization time.
+                double memberTime = _members[member]->getTcur();
+                size_t numSteps = 0;
+                while (memberTime < nextTime)
+                {
+                    memberTime = simulateStep(*_members[member], memberTime);
+                    ++numSteps;
+                }
+                fetchVisVariables(member, values);
+                if (0 == member)
+                {
+                    simTime = memberTime;
+                    _numSolverSteps.fetch_add(numSteps, std::memory_order_relaxed);
+                }
+            };
+
+            if (nullptr == _memberPool)
+            {
+                simulateMember(0);
+            }
+            else
+            {
+                _memberPool->parallelFor(_members.size(), simulateMember);
+            }
+            return simTime;
         }
 
         void VisualizerFMU::initializeVisAttributes(const double /*time*/)
         {
-            _fmu->initialize(_simSettings);
+            stopSimulationThread();
+            stopRecording();
+            initializeMembers();
             _timeManager->setVisTime(_timeManager->getStartTime());
             _timeManager->setSimTime(_timeManager->getStartTime());
             setVarReferencesInVisAttributes();
+            fetchVisVariables(_values);
+            resetFrames(_timeManager->getVisTime());
+            resetHistory(_timeManager->getVisTime());
             updateVisAttributes(_timeManager->getVisTime());
         }
 
@@ -325,40 +547,44 @@ namespace OMVIS
             osg::ref_ptr<osg::Node> child = nullptr;
             try
             {
-                fmi1_import_t* fmu = _fmu->getFMU();
                 size_t i = 0;
                 for (auto& shape : _baseData->_shapes)
                 {
+                    const double transformStart = profilingTick();
+                    // The shapes of member m use the values of member m and are translated by m offsets.
+                    const size_t member = (0 < _numShapes) ? i / _numShapes : 0;
+                    const size_t offset = member * _valueRefs.size();
+
                     // Get the values for the scene graph objects
-                    updateObjectAttributeFMU(&shape._length, fmu);
-                    updateObjectAttributeFMU(&shape._width, fmu);
-                    updateObjectAttributeFMU(&shape._height, fmu);
-
-                    updateObjectAttributeFMU(&shape._lDir[0], fmu);
-                    updateObjectAttributeFMU(&shape._lDir[1], fmu);
-                    updateObjectAttributeFMU(&shape._lDir[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._wDir[0], fmu);
-                    updateObjectAttributeFMU(&shape._wDir[1], fmu);
-                    updateObjectAttributeFMU(&shape._wDir[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._r[0], fmu);
-                    updateObjectAttributeFMU(&shape._r[1], fmu);
-                    updateObjectAttributeFMU(&shape._r[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._rShape[0], fmu);
-                    updateObjectAttributeFMU(&shape._rShape[1], fmu);
-                    updateObjectAttributeFMU(&shape._rShape[2], fmu);
-
-                    updateObjectAttributeFMU(&shape._T[0], fmu);
-                    updateObjectAttributeFMU(&shape._T[1], fmu);
-                    updateObjectAttributeFMU(&shape._T[2], fmu);
-                    updateObjectAttributeFMU(&shape._T[3], fmu);
-                    updateObjectAttributeFMU(&shape._T[4], fmu);
-                    updateObjectAttributeFMU(&shape._T[5], fmu);
-                    updateObjectAttributeFMU(&shape._T[6], fmu);
-                    updateObjectAttributeFMU(&shape._T[7], fmu);
-                    updateObjectAttributeFMU(&shape._T[8], fmu);
+                    updateObjectAttributeFMU(&shape._length, offset);
+                    updateObjectAttributeFMU(&shape._width, offset);
+                    updateObjectAttributeFMU(&shape._height, offset);
+
+                    updateObjectAttributeFMU(&shape._lDir[0], offset);
+                    updateObjectAttributeFMU(&shape._lDir[1], offset);
+                    updateObjectAttributeFMU(&shape._lDir[2], offset);
+
+                    updateObjectAttributeFMU(&shape._wDir[0], offset);
+                    updateObjectAttributeFMU(&shape._wDir[1], offset);
+                    updateObjectAttributeFMU(&shape._wDir[2], offset);
+
+                    updateObjectAttributeFMU(&shape._r[0], offset);
+                    updateObjectAttributeFMU(&shape._r[1], offset);
+                    updateObjectAttributeFMU(&shape._r[2], offset);
+
+                    updateObjectAttributeFMU(&shape._rShape[0], offset);
+                    updateObjectAttributeFMU(&shape._rShape[1], offset);
+                    updateObjectAttributeFMU(&shape._rShape[2], offset);
+
+                    updateObjectAttributeFMU(&shape._T[0], offset);
+                    updateObjectAttributeFMU(&shape._T[1], offset);
+                    updateObjectAttributeFMU(&shape._T[2], offset);
+                    updateObjectAttributeFMU(&shape._T[3], offset);
+                    updateObjectAttributeFMU(&shape._T[4], offset);
+                    updateObjectAttributeFMU(&shape._T[5], offset);
+                    updateObjectAttributeFMU(&shape._T[6], offset);
+                    updateObjectAttributeFMU(&shape._T[7], offset);
+                    updateObjectAttributeFMU(&shape._T[8], offset);
                     rT = Util::rotation(
                             osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
                             osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
@@ -368,8 +594,10 @@ namespace OMVIS
                             osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
                             osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
                             shape._type);
+                    rT._r[0] += member * s_memberOffset;
 
                     Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
+                    const double sceneUpdateStart = profilingTick();
 
                     // Update the shapes.
                     _nodeUpdater->_shape = shape;
@@ -378,6 +606,9 @@ namespace OMVIS
                     //_viewerStuff->dumpOSGTreeDebug();
                     child = _viewerStuff->getScene()->getRootNode()->getChild(i);  // the transformation
                     child->accept(*_nodeUpdater);
+                    const double sceneUpdateEnd = profilingTick();
+                    _frameTimings.transform += sceneUpdateStart - transformStart;
+                    _frameTimings.sceneUpdate += sceneUpdateEnd - sceneUpdateStart;
                     ++i;
                 }  //end for
             }  // end try
@@ -390,33 +621,368 @@ namespace OMVIS
             }
         }
 
-        void VisualizerFMU::updateScene(const double /*time*/)
+        void VisualizerFMU::updateScene(const double time)
+        {
+            const double hVisual = _timeManager->getHVisual();
+            if (hVisual != _simHVisual || _timeManager->getEndTime() != _simEndTime)
+            {
+                stopSimulationThread();
+            }
+            if (_isRewound)
+            {
+                try
+                {
+                    resumeFromHistory();
+                }
+                catch (std::exception& ex)
+                {
+                    LOGGER_WRITE("Could not resume the simulation at time point " + std::to_string(time) + ": "
+                                 + std::string(ex.what()), Util::LC_SOLVER, Util::LL_ERROR);
+                    _timeManager->setPause(true);
+                    return;
+                }
+            }
+            if (!_simulationThread.joinable())
+            {
+                startSimulationThread();
+            }
+
+            // VisualizerAbstract::sceneUpdate advances the visualization time by one step afterwards.
+            FMUFrame* frame = _frames.getReadSlot();
+            if (nullptr == frame)
+            {
+                // The simulation thread lags behind, thus, the scene and the visualization time are kept.
+                _timeManager->setVisTime(time - hVisual);
+                return;
+            }
+
+            // Exchange the buffers instead of copying the values.
+            std::swap(_values, frame->values);
+            const double visTime = frame->visTime;
+            _timeManager->setSimTime(frame->simTime);
+            _timeManager->setRealTimeFactor(frame->realTimeFactor);
+            _timeManager->setLag(frame->lag);
+            _timeManager->setNumDroppedFrames(frame->numDroppedFrames);
+            if (frame->hasCheckpoint)
+            {
+                _checkpoints.emplace_back();
+                std::swap(_checkpoints.back(), frame->checkpoint);
+            }
+            _frames.commitRead();
+
+            recordFrame(visTime);
+            _timeManager->setVisTime(visTime - hVisual);
+            updateVisAttributes(visTime);
+        }
+
+        void VisualizerFMU::pauseVisualization()
+        {
+            VisualizerAbstract::pauseVisualization();
+            stopSimulationThread();
+        }
+
+        void VisualizerFMU::setVisTime(const double visTime)
+        {
+            stopSimulationThread();
+            if (_history.empty())
+            {
+                VisualizerAbstract::setVisTime(visTime);
+                return;
+            }
+
+            // The recorded frames after the shown one would be simulated again.
+            stopRecording();
+            const double frameTime = _history.read(visTime, _values);
+            VisualizerAbstract::setVisTime(frameTime);
+            updateVisAttributes(frameTime);
+            _isRewound = true;
+        }
+
+        void VisualizerFMU::startRecording(const std::string& fileName, const bool withOutputs)
         {
-            _timeManager->updateTick();  //for real-time measurement
+            stopRecording();
+            const std::string suffix = "_res.mat";
+            if (fileName.size() <= suffix.size() || 0 != fileName.compare(fileName.size() - suffix.size(),
+                                                                           suffix.size(), suffix))
+            {
+                throw std::runtime_error("The name of the result file " + fileName + " has to end with " + suffix
+                                         + ".");
+            }
 
-            _timeManager->setSimTime(_timeManager->getVisTime());
-            double nextStep = _timeManager->getVisTime() + _timeManager->getHVisual();
+            const auto& visVariables = _baseData->getVisualizationVariables();
+            std::vector<std::string> names(1, "time");
+            names.insert(names.end(), visVariables.begin(), visVariables.end());
 
-            double vis1 = _timeManager->getRealTime();
-            while (_timeManager->getSimTime() < nextStep)
+            // The outputs that are visualization variables are recorded only once.
+            _recordOutputRefs.clear();
+            if (withOutputs)
             {
-                //std::cout<<"simulate "<<omvManager->_simTime<<" to "<<nextStep<<std::endl;
-                //_inputData.printValues();
-                _timeManager->setSimTime(simulateStep(_timeManager->getSimTime()));
+                auto allVariables = fmi1_import_get_variable_list(_fmu->getFMU());
+                for (size_t i = 0; i < fmi1_import_get_variable_list_size(allVariables); ++i)
+                {
+                    auto var = fmi1_import_get_variable(allVariables, i);
+                    std::string name = fmi1_import_get_variable_name(var);
+                    if (fmi1_causality_enu_output == fmi1_import_get_causality(var)
+                            && fmi1_base_type_real == fmi1_import_get_variable_base_type(var)
+                            && names.end() == std::find(names.begin(), names.end(), name))
+                    {
+                        names.push_back(name);
+                        _recordOutputRefs.push_back(fmi1_import_get_variable_vr(var));
+                    }
+                }
+                fmi1_import_free_variable_list(allVariables);
+            }
+
+            // VisualizerMAT expects the visual XML file next to the result file.
+            try
+            {
+                boost::filesystem::path xmlFile(_baseData->getXMLFileName());
+                boost::filesystem::path recordXMLFile(
+                        Util::getXMLFileName(Util::getFileName(fileName), Util::getPath(fileName)));
+                if (!boost::filesystem::exists(recordXMLFile) || !boost::filesystem::equivalent(xmlFile, recordXMLFile))
+                {
+                    boost::filesystem::copy_file(xmlFile, recordXMLFile,
+                                                 boost::filesystem::copy_option::overwrite_if_exists);
+                }
+            }
+            catch (boost::filesystem::filesystem_error& ex)
+            {
+                throw std::runtime_error("Could not copy the visual XML file: " + std::string(ex.what()));
+            }
+
+            stopSimulationThread();
+            _recorder.open(fileName, names);
+            _recordRow.assign(names.size(), 0.0);
+            _isRecording = true;
+            LOGGER_WRITE("Record " + std::to_string(names.size()) + " variables to " + fileName + ".", Util::LC_SOLVER,
+                         Util::LL_INFO);
+        }
+
+        void VisualizerFMU::stopRecording()
+        {
+            if (!_isRecording)
+            {
+                return;
+            }
+            stopSimulationThread();
+            _recorder.close();
+            _isRecording = false;
+            LOGGER_WRITE("Recorded " + std::to_string(_recorder.getNumRows()) + " frames to " + _recorder.getFileName()
+                         + ".", Util::LC_SOLVER, Util::LL_INFO);
+        }
+
+        void VisualizerFMU::startSimulationThread()
+        {
+            _simHVisual = _timeManager->getHVisual();
+            _simEndTime = _timeManager->getEndTime();
+            _pacing.reset(_simVisTime, getWallTime());
+            _isSimulating.store(true, std::memory_order_release);
+            _simulationThread = std::thread(&VisualizerFMU::runSimulation, this);
+        }
+
+        void VisualizerFMU::stopSimulationThread()
+        {
+            _isSimulating.store(false, std::memory_order_release);
+            if (_simulationThread.joinable())
+            {
+                _simulationThread.join();
+            }
+        }
+
+        void VisualizerFMU::resetFrames(const double visTime)
+        {
+            _frames.clear();
+            for (size_t i = 0; i < _frames.getNumSlots(); ++i)
+            {
+                _frames.getSlot(i).values.assign(_values.size(), 0.0);
+                _frames.getSlot(i).hasCheckpoint = false;
+            }
+            _simVisTime = visTime;
+            _simNextCheckpointTime = visTime + s_checkpointInterval;
+        }
+
+        void VisualizerFMU::resetHistory(const double visTime)
+        {
+            _history.clear();
+            _checkpoints.clear();
+            _checkpoints.emplace_back();
+            saveCheckpoints(visTime, _checkpoints.back());
+            _history.push(visTime, _values);
+            _isRewound = false;
+        }
+
+        void VisualizerFMU::recordFrame(const double visTime)
+        {
+            _history.push(visTime, _values);
+
+            // The latest checkpoint before the first frame is needed to resume from it.
+            while (1 < _checkpoints.size() && _checkpoints[1].visTime <= _history.getFirstTime())
+            {
+                _checkpoints.pop_front();
+            }
+        }
+
+        void VisualizerFMU::saveCheckpoints(const double visTime, EnsembleCheckpoint& checkpoint) const
+        {
+            checkpoint.visTime = visTime;
+            checkpoint.members.resize(_members.size());
+            for (size_t i = 0; i < _members.size(); ++i)
+            {
+                _members[i]->saveCheckpoint(checkpoint.members[i]);
+            }
+        }
+
+        void VisualizerFMU::resumeFromHistory()
+        {
+            const double visTime = _timeManager->getVisTime();
+            auto it = std::upper_bound(_checkpoints.begin(), _checkpoints.end(), visTime,
+                                       [](const double t, const EnsembleCheckpoint& checkpoint)
+                                       {
+                                           return t < checkpoint.visTime;
+                                       });
+
+            double startTime = _timeManager->getStartTime();
+            if (_checkpoints.begin() == it)
+            {
+                LOGGER_WRITE("No checkpoint before time point " + std::to_string(visTime) + ". Simulate from start.",
+                             Util::LC_SOLVER, Util::LL_WARNING);
+                initializeMembers();
+            }
+            else
+            {
+                --it;
+                for (size_t i = 0; i < _members.size(); ++i)
+                {
+                    _members[i]->restoreCheckpoint(it->members[i]);
+                }
+                startTime = _fmu->getTcur();
+            }
+            simulateMembers(visTime, _values);
+            LOGGER_WRITE("Resumed the simulation at time point " + std::to_string(visTime) + " from the checkpoint at "
+                         + std::to_string(startTime) + ".", Util::LC_SOLVER, Util::LL_INFO);
+
+            // The frames after the resumed one are simulated again.
+            _history.truncate(visTime);
+            while (!_checkpoints.empty() && visTime < _checkpoints.back().visTime)
+            {
+                _checkpoints.pop_back();
+            }
+            resetFrames(visTime);
+            _timeManager->setSimTime(_fmu->getTcur());
+            _isRewound = false;
+        }
+
+        void VisualizerFMU::runSimulation()
+        {
+            double lastWallTime = getWallTime();
+            size_t lastNumDroppedFrames = _pacing.getNumDroppedFrames();
+            while (_isSimulating.load(std::memory_order_acquire))
+            {
+                // Nothing to do, if the buffer is full, the end time is reached or the next frame is not yet due.
+                FMUFrame* frame = nullptr;
+                const double start = getWallTime();
+                double nextTime = _simVisTime;
+                if (_simVisTime < _simEndTime - 1.e-6)
+                {
+                    frame = _frames.getWriteSlot();
+                }
+                if (nullptr != frame)
+                {
+                    // Without pacing, each frame advances by one visualization step as fast as possible.
+                    nextTime = _isPaced ? _pacing.planFrame(_simVisTime, start, _simHVisual)
+                                        : _simVisTime + _simHVisual;
+                    nextTime = std::min(nextTime, _simEndTime);
+                }
+                if (nullptr == frame || nextTime <= _simVisTime)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+
+                const size_t numDroppedFrames = _pacing.getNumDroppedFrames();
+                if (numDroppedFrames != lastNumDroppedFrames)
+                {
+                    LOGGER_WRITE("The simulation cannot keep up with the real time factor at time point "
+                                 + std::to_string(_simVisTime) + ". Dropped " + std::to_string(numDroppedFrames)
+                                 + " frames so far.", Util::LC_SOLVER, Util::LL_WARNING);
+                    lastNumDroppedFrames = numDroppedFrames;
+                }
+                double simTime = _simVisTime;
+                try
+                {
+                    simTime = simulateMembers(nextTime, frame->values);
+                    if (_isRecording)
+                    {
+                        recordRow(simTime, frame->values);
+                    }
+                }
+                catch (std::exception& ex)
+                {
+                    LOGGER_WRITE("Simulation stopped at time point " + std::to_string(simTime) + ": "
+                                 + std::string(ex.what()), Util::LC_SOLVER, Util::LL_ERROR);
+                    _isSimulating.store(false, std::memory_order_release);
+                    return;
+                }
+                frame->hasCheckpoint = (_simNextCheckpointTime <= nextTime);
+                if (frame->hasCheckpoint)
+                {
+                    saveCheckpoints(nextTime, frame->checkpoint);
+                    _simNextCheckpointTime = nextTime + s_checkpointInterval;
+                }
+                const double end = getWallTime();
+                _pacing.finishFrame(nextTime - _simVisTime, end - start);
+                frame->visTime = nextTime;
+                frame->simTime = simTime;
+                frame->realTimeFactor = (end > lastWallTime) ? (nextTime - _simVisTime) / (end - lastWallTime) : 0.0;
+                frame->lag = _pacing.getLag();
+                frame->numDroppedFrames = numDroppedFrames;
+                lastWallTime = end;
+                _simVisTime = nextTime;
+                _frames.commitWrite();
+            }
+        }
+
+        void VisualizerFMU::recordRow(const double simTime, const std::vector<fmi1_real_t>& values)
+        {
+            // The values of the first member come first.
+            _recordRow[0] = simTime;
+            std::copy(values.begin(), values.begin() + _valueRefs.size(), _recordRow.begin() + 1);
+            if (!_recordOutputRefs.empty()
+                    && fmi1_status_ok != fmi1_import_get_real(_fmu->getFMU(), _recordOutputRefs.data(),
+                                                              _recordOutputRefs.size(),
+                                                              _recordRow.data() + 1 + _valueRefs.size()))
+            {
+                throw std::runtime_error("Could not get the values of the recorded outputs from the FMU.");
+            }
+            _recorder.writeRow(_recordRow.data());
+        }
+
+        void VisualizerFMU::fetchVisVariables(std::vector<fmi1_real_t>& values)
+        {
+            for (size_t i = 0; i < _members.size(); ++i)
+            {
+                fetchVisVariables(i, values);
+            }
+        }
+
+        void VisualizerFMU::fetchVisVariables(const size_t member, std::vector<fmi1_real_t>& values)
+        {
+            // Fetch the values of all shapes at once.
+            if (!_valueRefs.empty()
+                    && fmi1_status_ok != fmi1_import_get_real(_members[member]->getFMU(), _valueRefs.data(),
+                                                              _valueRefs.size(),
+                                                              values.data() + member * _valueRefs.size()))
+            {
+                throw std::runtime_error("Could not get the values of the visualization variables from the FMU.");
             }
-            _timeManager->updateTick();                     //for real-time measurement
-            _timeManager->setRealTimeFactor(_timeManager->getHVisual() / (_timeManager->getRealTime() - vis1));
-            updateVisAttributes(_timeManager->getVisTime());
         }
 
         // Todo pass by const ref
-        void VisualizerFMU::updateObjectAttributeFMU(Model::ShapeObjectAttribute* attr, fmi1_import_t* fmu)
+        void VisualizerFMU::updateObjectAttributeFMU(Model::ShapeObjectAttribute* attr, const size_t valueOffset)
         {
             if (!attr->isConst)
             {
-                fmi1_real_t a = attr->exp;
-                fmi1_import_get_real(fmu, &attr->fmuValueRef, 1, &a);
-                attr->exp = static_cast<float>(a);
+                attr->exp = static_cast<float>(_values[valueOffset + attr->varIdx]);
             }
         }
 
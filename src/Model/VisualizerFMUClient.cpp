@@ -35,8 +35,11 @@ namespace OMVIS
                   _simID(-1),
                   _simSettings(std::make_shared<SimSettingsFMU>()),
                   _outputVars(),
+                  _outputIndices(),
+                  _values(),
                   _inputData(std::make_shared<InputData>()),
                   _joysticks(),
+                  _joystickInput(),
                   _remotePathToModelFile(cP->path)
         {
             LOGGER_WRITE("Initialize joysticks", Util::LC_LOADER, Util::LL_INFO);
@@ -116,7 +119,12 @@ namespace OMVIS
 
         void VisualizerFMUClient::resetInputs()
         {
+            std::lock_guard<std::mutex> lock(_inputData->getMutex());
             _inputData->resetInputValues();
+            for (auto& joystick : _joysticks)
+            {
+                joystick->invalidateAppliedInputs();
+            }
         }
 
         void VisualizerFMUClient::initJoySticks()
@@ -152,6 +160,7 @@ namespace OMVIS
                                      Util::LC_LOADER, Util::LL_INFO);
                     }
                 }
+                _joystickInput.start(_joysticks);
             }
         }
 
@@ -213,7 +222,7 @@ namespace OMVIS
         UserSimSettingsFMU VisualizerFMUClient::getCurrentSimSettings() const
         {
             return
-            {   _simSettings->getSolver(), _simSettings->getHdef(), 99, _timeManager->getEndTime()};
+            {   _simSettings->getSolver(), _simSettings->getHdef(), 99, _timeManager->getEndTime(), 1.0};
         }
 
         /*-----------------------------------------
@@ -238,10 +247,7 @@ namespace OMVIS
             // Set inputs in inputData
             for (auto& joystick : _joysticks)
             {
-                joystick->detectContinuousInputEvents(_inputData);
-
-                //_inputData->setInputsInFMU(_fmu->getFMU()); //todo aus der schleife raus???
-                //std::cout << "JOY" << i << " XDir " <<_joysticks[i]->getXDir() <<" YDir "<< _joysticks[i]->getYDir() << std::endl;
+                joystick->applyInputs(_inputData);
             }
 
             // Set inputs for network communication.
@@ -264,54 +270,19 @@ namespace OMVIS
             updateVisAttributes(_timeManager->getVisTime());
         }
 
-        fmi1_value_reference_t VisualizerFMUClient::getVarReferencesForObjectAttribute(ShapeObjectAttribute* attr)
-        {
-            fmi1_value_reference_t vr = 0;
-            if (!attr->isConst)
-            {
-                vr = _outputVars.findRealVariableNameIndex(attr->cref);
-            }
-            return vr;
-        }
-
         int VisualizerFMUClient::setVarReferencesInVisAttributes()
         {
             int isOk(0);
+            const auto& visVariables = _baseData->getVisualizationVariables();
 
             try
             {
-                for (auto& shape : _baseData->_shapes)
+                _outputIndices.resize(visVariables.size());
+                for (size_t i = 0; i < visVariables.size(); ++i)
                 {
-                    shape._length.fmuValueRef = getVarReferencesForObjectAttribute(&shape._length);
-                    shape._width.fmuValueRef = getVarReferencesForObjectAttribute(&shape._width);
-                    shape._height.fmuValueRef = getVarReferencesForObjectAttribute(&shape._height);
-
-                    shape._lDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[0]);
-                    shape._lDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[1]);
-                    shape._lDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._lDir[2]);
-
-                    shape._wDir[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[0]);
-                    shape._wDir[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[1]);
-                    shape._wDir[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._wDir[2]);
-
-                    shape._r[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[0]);
-                    shape._r[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[1]);
-                    shape._r[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._r[2]);
-
-                    shape._rShape[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[0]);
-                    shape._rShape[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[1]);
-                    shape._rShape[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._rShape[2]);
-
-                    shape._T[0].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[0]);
-                    shape._T[1].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[1]);
-                    shape._T[2].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[2]);
-                    shape._T[3].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[3]);
-                    shape._T[4].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[4]);
-                    shape._T[5].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[5]);
-                    shape._T[6].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[6]);
-                    shape._T[7].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[7]);
-                    shape._T[8].fmuValueRef = getVarReferencesForObjectAttribute(&shape._T[8]);
-                }  //end for
+                    _outputIndices[i] = _outputVars.findRealVariableNameIndex(visVariables[i]);
+                }
+                _values.assign(visVariables.size(), 0.0);
             }  // end try
 
             catch (std::exception& e)
@@ -331,39 +302,47 @@ namespace OMVIS
             osg::ref_ptr<osg::Node> child = nullptr;
             try
             {
+                // Fetch each variable once per frame.
+                const auto& realValues = outputCont.getRealValues();
+                for (size_t j = 0; j < _outputIndices.size(); ++j)
+                {
+                    _values[j] = realValues[_outputIndices[j]];
+                }
+
                 size_t i = 0;
                 for (auto& shape : _baseData->_shapes)
                 {
+                    const double transformStart = profilingTick();
                     // get the values for the scene graph objects
-                    Util::updateObjectAttributeFMUClient(shape._length, outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._width, outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._height, outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._lDir[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._lDir[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._lDir[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._wDir[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._wDir[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._wDir[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._r[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._r[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._r[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._rShape[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._rShape[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._rShape[2], outputCont);
-
-                    Util::updateObjectAttributeFMUClient(shape._T[0], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[1], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[2], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[3], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[4], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[5], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[6], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[7], outputCont);
-                    Util::updateObjectAttributeFMUClient(shape._T[8], outputCont);
+                    Util::updateObjectAttributeFMUClient(shape._length, _values);
+                    Util::updateObjectAttributeFMUClient(shape._width, _values);
+                    Util::updateObjectAttributeFMUClient(shape._height, _values);
+
+                    Util::updateObjectAttributeFMUClient(shape._lDir[0], _values);
+                    Util::updateObjectAttributeFMUClient(shape._lDir[1], _values);
+                    Util::updateObjectAttributeFMUClient(shape._lDir[2], _values);
+
+                    Util::updateObjectAttributeFMUClient(shape._wDir[0], _values);
+                    Util::updateObjectAttributeFMUClient(shape._wDir[1], _values);
+                    Util::updateObjectAttributeFMUClient(shape._wDir[2], _values);
+
+                    Util::updateObjectAttributeFMUClient(shape._r[0], _values);
+                    Util::updateObjectAttributeFMUClient(shape._r[1], _values);
+                    Util::updateObjectAttributeFMUClient(shape._r[2], _values);
+
+                    Util::updateObjectAttributeFMUClient(shape._rShape[0], _values);
+                    Util::updateObjectAttributeFMUClient(shape._rShape[1], _values);
+                    Util::updateObjectAttributeFMUClient(shape._rShape[2], _values);
+
+                    Util::updateObjectAttributeFMUClient(shape._T[0], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[1], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[2], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[3], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[4], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[5], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[6], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[7], _values);
+                    Util::updateObjectAttributeFMUClient(shape._T[8], _values);
                     rT = Util::rotation(
                             osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
                             osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
@@ -375,6 +354,7 @@ namespace OMVIS
                             shape._type);
 
                     Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
+                    const double sceneUpdateStart = profilingTick();
 
                     // Update the shapes.
                     _nodeUpdater->_shape = shape;
@@ -383,6 +363,9 @@ namespace OMVIS
                     //_viewerStuff->dumpOSGTreeDebug();
                     child = _viewerStuff->getScene()->getRootNode()->getChild(i);  // the transformation
                     child->accept(*_nodeUpdater);
+                    const double sceneUpdateEnd = profilingTick();
+                    _frameTimings.transform += sceneUpdateStart - transformStart;
+                    _frameTimings.sceneUpdate += sceneUpdateEnd - sceneUpdateStart;
                     ++i;
                 }  //end for
             }  // end try
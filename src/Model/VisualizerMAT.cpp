@@ -21,33 +21,45 @@
 #include "Util/Logger.hpp"
 #include "Util/Util.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <thread>
+
 namespace OMVIS
 {
     namespace Model
     {
 
-        // [MF: 2016-06-13]: This method is not used. Do we need it?
-        //        double* omc_get_varValue1(ModelicaMatReader* reader, const char* varName, double time)
-        //        {
-        //            double val = 0.0;
-        //            double* res = &val;
-        //            ModelicaMatVariable_t* var = nullptr;
-        //            var = omc_matlab4_find_var(reader, varName);
-        //            if (var == nullptr)
-        //                LOGGER_WRITE(std::string("Could not get variable ") + varName + std::string(" from result file."), Util::LC_CTR, Util::LL_ERROR);
-        //            else
-        //                omc_matlab4_val(res, reader, var, time);
-        //
-        //            return res;
-        //        }
+        /// Minimum time between two refreshes of a followed result file.
+        static const std::chrono::milliseconds s_followInterval(500);
 
         /*-----------------------------------------
          * CONSTRUCTORS
          *---------------------------------------*/
 
         VisualizerMAT::VisualizerMAT(const std::string& modelFile, const std::string& path)
-                : VisualizerAbstract(modelFile, path, VisType::MAT),
-                  _matReader()
+                : VisualizerMAT(modelFile, path, VisType::MAT)
+        {
+        }
+
+        VisualizerMAT::VisualizerMAT(const std::string& modelFile, const std::string& path, const VisType visType)
+                : VisualizerAbstract(modelFile, path, visType),
+                  _matVarRefs(),
+                  _timeline(),
+                  _matReader(),
+                  _frame(),
+                  _cursor(),
+                  _prefetcher(_timeline, 64),
+                  _decimationTolerance(0.0),
+                  _transformCache(),
+                  _followFile(false),
+                  _fileWatcher(),
+                  _hasPendingChanges(false),
+                  _lastRefresh(),
+                  _numResultRows(0)
         {
         }
 
@@ -58,9 +70,32 @@ namespace OMVIS
         void VisualizerMAT::initData()
         {
             VisualizerAbstract::initData();
-            readMat(_baseData->getModelFile(), _baseData->getPath());
-            _timeManager->setStartTime(omc_matlab4_startTime(&_matReader));
-            _timeManager->setEndTime(omc_matlab4_stopTime(&_matReader));
+            _fileWatcher.stop();
+            _followFile = false;
+
+            // A valid baked cache replaces the MAT file completely.
+            if (openTransformCache())
+            {
+                _timeManager->setStartTime(_transformCache.getStartTime());
+                _timeManager->setEndTime(_transformCache.getStopTime());
+                return;
+            }
+
+            openResultFile();
+            // A result file that is still being written is followed automatically.
+            _followFile = !isResultFileComplete();
+            setVarReferencesInVisAttributes();
+            extractTimeline();
+            _timeManager->setStartTime(_timeline.getStartTime());
+            _timeManager->setEndTime(_timeline.getStopTime());
+
+            if (_followFile)
+            {
+                LOGGER_WRITE("The result file is still being written. New time points are appended while it is "
+                             "followed.", Util::LC_LOADER, Util::LL_INFO);
+                _fileWatcher.watch(_baseData->getPath() + _baseData->getModelFile());
+                _lastRefresh = std::chrono::steady_clock::now();
+            }
         }
 
         void VisualizerMAT::initializeVisAttributes(const double time)
@@ -86,88 +121,430 @@ namespace OMVIS
             }
             else
             {
-                // Read mat file.
-                auto ret = omc_new_matlab4_reader(resFileName.c_str(), &_matReader);
-                // Check return value.
-                if (nullptr != ret)
+                // Map the MAT file. Only the header matrices are parsed, the values are read on demand.
+                try
                 {
-                    std::string msg(ret);
+                    _matReader.open(resFileName);
+                }
+                catch (std::exception& ex)
+                {
+                    std::string msg(ex.what());
                     LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
                     throw std::runtime_error(msg);
                 }
             }
+        }
+
+        bool VisualizerMAT::openTransformCache()
+        {
+            _transformCache.close();
+
+            std::string matFileName = _baseData->getPath() + _baseData->getModelFile();
+            std::string cacheFileName = TransformCache::getCacheFileName(matFileName);
+            if (!Util::fileExists(cacheFileName))
+            {
+                return false;
+            }
+
+            try
+            {
+                auto key = TransformCache::computeKey(matFileName, _baseData->getXMLFileName());
+                if (!_transformCache.open(cacheFileName, key, _baseData->_shapes.size()))
+                {
+                    LOGGER_WRITE("The cache file " + cacheFileName + " is outdated and will be ignored.",
+                                 Util::LC_LOADER, Util::LL_INFO);
+                    return false;
+                }
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE(std::string(ex.what()), Util::LC_LOADER, Util::LL_WARNING);
+                return false;
+            }
+
+            LOGGER_WRITE("Using baked cache file " + cacheFileName + " with " + std::to_string(
+                                 _transformCache.getNumFrames()) + " time points.", Util::LC_LOADER, Util::LL_INFO);
+            return true;
+        }
+
+        void VisualizerMAT::bakeTransforms()
+        {
+            if (_transformCache.isOpen())
+            {
+                LOGGER_WRITE("The shapes are already baked.", Util::LC_LOADER, Util::LL_INFO);
+                return;
+            }
+            if (_followFile)
+            {
+                LOGGER_WRITE("Cannot bake the shapes of a result file that is still being followed.", Util::LC_LOADER,
+                             Util::LL_WARNING);
+                return;
+            }
+            if (0.0 < _decimationTolerance)
+            {
+                LOGGER_WRITE("Cannot bake the shapes of a decimated timeline. Set the decimation tolerance to 0.0.",
+                             Util::LC_LOADER, Util::LL_WARNING);
+                return;
+            }
+
+            std::string matFileName = _baseData->getPath() + _baseData->getModelFile();
+            std::string cacheFileName = TransformCache::getCacheFileName(matFileName);
+            try
+            {
+                auto key = TransformCache::computeKey(matFileName, _baseData->getXMLFileName());
+                const size_t numShapes = _baseData->_shapes.size();
+                std::vector<double> times(_timeline.getTimes(), _timeline.getTimes() + _timeline.getNumRows());
+                std::vector<BakedShape> baked(numShapes);
+                TimelineCursor cursor;
+
+                _transformCache.beginWrite(cacheFileName, key, numShapes, times);
+                for (auto time : times)
+                {
+                    _timeline.interpolate(time, _frame, cursor);
+                    for (size_t i = 0; i < numShapes; ++i)
+                    {
+                        updateShapeFromFrame(_baseData->_shapes[i]);
+                        bakeShape(_baseData->_shapes[i], baked[i]);
+                    }
+                    _transformCache.writeFrame(baked.data());
+                }
+                _transformCache.endWrite();
+
+                if (!_transformCache.open(cacheFileName, key, numShapes))
+                {
+                    throw std::runtime_error("Could not open cache file " + cacheFileName + ".");
+                }
+                // The frames are taken from the cache from now on.
+                _prefetcher.stop();
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE("Baking the shapes failed: " + std::string(ex.what()), Util::LC_LOADER, Util::LL_ERROR);
+                return;
+            }
+
+            LOGGER_WRITE("Baked " + std::to_string(_baseData->_shapes.size()) + " shapes at "
+                         + std::to_string(_transformCache.getNumFrames()) + " time points into " + cacheFileName + ".",
+                         Util::LC_LOADER, Util::LL_INFO);
+        }
+
+        void VisualizerMAT::swapTimeline(ResultTimeline& timeline)
+        {
+            // The timeline must not be modified while frames are prefetched.
+            _prefetcher.stop();
+            _timeline.swap(timeline);
+            _timeline.initFrame(_frame);
+            _prefetcher.initialize();
+            _cursor.reset();
+        }
+
+        void VisualizerMAT::setFollowFile(const bool followFile)
+        {
+            if (followFile == _followFile)
+            {
+                return;
+            }
+            if (followFile && _transformCache.isOpen())
+            {
+                LOGGER_WRITE("Cannot follow a baked result file.", Util::LC_LOADER, Util::LL_WARNING);
+                return;
+            }
+
+            std::string resFileName = _baseData->getPath() + _baseData->getModelFile();
+            if (followFile)
+            {
+                // The result file has been closed after the extraction. Open it again and pick up the time points that
+                // have been appended in the meantime with the next scene update.
+                openResultFile();
+                _fileWatcher.watch(resFileName);
+                _hasPendingChanges = true;
+                _lastRefresh = std::chrono::steady_clock::time_point();
+                LOGGER_WRITE("Following result file " + resFileName + ".", Util::LC_LOADER, Util::LL_INFO);
+            }
+            else
+            {
+                _fileWatcher.stop();
+                closeResultFile();
+                LOGGER_WRITE("Stopped following result file " + resFileName + ".", Util::LC_LOADER, Util::LL_INFO);
+            }
+            _followFile = followFile;
+        }
+
+        void VisualizerMAT::setVarReferencesInVisAttributes()
+        {
+            const auto& visVariables = _baseData->getVisualizationVariables();
+            std::vector<bool> isMissing(visVariables.size(), false);
+            _matVarRefs.clear();
+            _matVarRefs.reserve(visVariables.size());
+
+            for (size_t i = 0; i < visVariables.size(); ++i)
+            {
+                MatVariableRef ref;
+                if (findResultVariable(visVariables[i], ref))
+                {
+                    _matVarRefs.push_back(ref);
+                }
+                else
+                {
+                    LOGGER_WRITE("Did not get variable from result file. Variable name is " + visVariables[i] + ".",
+                                 Util::LC_LOADER, Util::LL_ERROR);
+                    isMissing[i] = true;
+                }
+            }
+            // Thereby, the column of each variable in the timeline is its index in the variable table.
+            _baseData->removeVisVariables(isMissing);
+
+            LOGGER_WRITE("Resolved " + std::to_string(_matVarRefs.size()) + " visualization variables in MAT file.",
+                         Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void VisualizerMAT::extractTimeline()
+        {
+            const size_t numRows = getNumResultRows();
+            const size_t numVars = _matVarRefs.size();
+
+            // The timeline must not be modified while frames are prefetched.
+            _prefetcher.stop();
+
+            std::vector<bool> constColumns(numVars);
+            for (size_t i = 0; i < numVars; ++i)
+            {
+                constColumns[i] = _matVarRefs[i].isParam;
+            }
+            _timeline.allocate(numRows, constColumns);
+            readResultRows(0, numRows, 0);
+            _numResultRows = numRows;
+
+            if (0.0 < _decimationTolerance)
+            {
+                auto numKept = _timeline.decimate(_decimationTolerance);
+                LOGGER_WRITE("Decimated " + std::to_string(numRows) + " time points to " + std::to_string(numKept)
+                             + " with tolerance " + std::to_string(_decimationTolerance) + ".", Util::LC_LOADER,
+                             Util::LL_INFO);
+            }
+
+            // All further accesses are served by the timeline. A followed result file is kept open for the refreshes.
+            if (!_followFile)
+            {
+                closeResultFile();
+            }
+            _timeline.initFrame(_frame);
+            _prefetcher.initialize();
+
+            LOGGER_WRITE("Extracted " + std::to_string(numVars) + " variables with " + std::to_string(numRows)
+                         + " time points from result file.", Util::LC_LOADER, Util::LL_DEBUG);
+        }
+
+        void VisualizerMAT::followResultFile()
+        {
+            if (_fileWatcher.hasChanged())
+            {
+                _hasPendingChanges = true;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (!_hasPendingChanges || now - _lastRefresh < s_followInterval)
+            {
+                return;
+            }
+            _hasPendingChanges = false;
+            _lastRefresh = now;
+
+            try
+            {
+                const size_t numRows = refreshResultFile();
+                if (numRows > _numResultRows)
+                {
+                    const size_t numNewRows = numRows - _numResultRows;
+                    const size_t timelineRow = _timeline.getNumRows();
+                    const bool isAtEnd = _timeManager->getVisTime() >= _timeline.getStopTime() - 1.e-6;
+
+                    // The time points are appended behind the (possibly decimated) time points of the timeline.
+                    _prefetcher.stop();
+                    _timeline.resize(timelineRow + numNewRows);
+                    readResultRows(_numResultRows, numNewRows, timelineRow);
+                    _numResultRows = numRows;
+                    _prefetcher.initialize();
+
+                    _timeManager->setEndTime(_timeline.getStopTime());
+                    if (isAtEnd)
+                    {
+                        setVisTime(_timeline.getStopTime());
+                    }
+                    LOGGER_WRITE("Appended " + std::to_string(numNewRows) + " time points from followed result file.",
+                                 Util::LC_LOADER, Util::LL_DEBUG);
+                }
+
+                if (isResultFileComplete())
+                {
+                    LOGGER_WRITE("The result file has been written completely.", Util::LC_LOADER, Util::LL_INFO);
+                    setFollowFile(false);
+                }
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE("Following the result file failed: " + std::string(ex.what()), Util::LC_LOADER,
+                             Util::LL_WARNING);
+                setFollowFile(false);
+            }
+        }
+
+        /*-----------------------------------------
+         * RESULT FILE METHODS
+         *---------------------------------------*/
 
-            /*
-             FILE * fileA = fopen("allVArs.txt", "w+");
-             omc_matlab4_print_all_vars(fileA, &matReader);
-             fclose(fileA);
-             */
+        void VisualizerMAT::openResultFile()
+        {
+            readMat(_baseData->getModelFile(), _baseData->getPath());
+        }
+
+        void VisualizerMAT::closeResultFile()
+        {
+            _matReader.close();
+        }
+
+        size_t VisualizerMAT::refreshResultFile()
+        {
+            return _matReader.refresh();
+        }
+
+        bool VisualizerMAT::isResultFileComplete() const
+        {
+            return _matReader.isComplete();
+        }
+
+        bool VisualizerMAT::findResultVariable(const std::string& name, MatVariableRef& ref) const
+        {
+            const MatVariable* var = _matReader.findVariable(name);
+            if (nullptr == var)
+            {
+                return false;
+            }
+
+            // Negative aliases are stored with a negative index. Map them to the aliased column and keep the sign.
+            ref.isParam = var->isParam;
+            ref.index = std::abs(var->index) - 1;
+            ref.sign = (0 > var->index) ? -1.0 : 1.0;
+            return true;
+        }
+
+        size_t VisualizerMAT::getNumResultRows() const
+        {
+            return _matReader.getNumRows();
+        }
+
+        void VisualizerMAT::readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow)
+        {
+            const size_t numVars = _matVarRefs.size();
+
+            // Time is always the first variable in data_2.
+            _matReader.readColumn(0, firstRow, numRows, _timeline.getTimes() + timelineRow);
+
+            // Each worker transposes whole columns. The next column to process is shared by all workers.
+            std::atomic<size_t> nextColumn(0);
+            auto worker = [this, firstRow, numRows, timelineRow, numVars, &nextColumn]()
+            {
+                for (size_t i = nextColumn++; i < numVars; i = nextColumn++)
+                {
+                    const auto& ref = _matVarRefs[i];
+                    float* column = _timeline.getColumn(i);
+                    size_t numValues = 0;
+                    if (ref.isParam)
+                    {
+                        if (0 == firstRow)
+                        {
+                            column[0] = static_cast<float>(_matReader.getParameters().at(ref.index));
+                            numValues = 1;
+                        }
+                    }
+                    else
+                    {
+                        column += timelineRow;
+                        _matReader.readColumn(ref.index, firstRow, numRows, column);
+                        numValues = numRows;
+                    }
+
+                    if (0.0 > ref.sign)
+                    {
+                        for (size_t j = 0; j < numValues; ++j)
+                        {
+                            column[j] = -column[j];
+                        }
+                    }
+                }
+            };
+
+            size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+            numThreads = std::max<size_t>(1, std::min(numThreads, numVars));
+            std::vector<std::future<void>> workers;
+            for (size_t i = 0; i < numThreads; ++i)
+            {
+                workers.push_back(std::async(std::launch::async, worker));
+            }
+            // Rethrows the exceptions of the workers.
+            for (auto& w : workers)
+            {
+                w.get();
+            }
+        }
+
+        void VisualizerMAT::updateTimelineWindow(const double time)
+        {
         }
 
         /*-----------------------------------------
          * SIMULATION METHODS
          *---------------------------------------*/
 
+        void VisualizerMAT::setVisTime(const double visTime)
+        {
+            VisualizerAbstract::setVisTime(visTime);
+            _cursor.reset();
+        }
+
+        bool VisualizerMAT::waitsAtEndTime() const
+        {
+            return _followFile;
+        }
+
+        void VisualizerMAT::fetchFrame(const double time)
+        {
+            if (!_prefetcher.popFrame(time, _timeManager->getHVisual(), _frame))
+            {
+                _timeline.interpolate(time, _frame, _cursor);
+            }
+        }
+
         void VisualizerMAT::updateVisAttributes(const double time)
         {
+            // Baked shapes are copied from the cache, otherwise they are computed from the interpolated variables.
+            const BakedShape* baked = nullptr;
+            if (_transformCache.isOpen())
+            {
+                baked = _transformCache.getFrame(_transformCache.findFrame(time));
+            }
+            else
+            {
+                updateTimelineWindow(time);
+                fetchFrame(time);
+            }
+
             // Update all shapes.
             unsigned int shapeIdx = 0;
-            OMVIS::Util::rAndT rT;
             osg::ref_ptr<osg::Node> child = nullptr;
-            ModelicaMatReader* tmpReaderPtr = &_matReader;
             try
             {
                 for (auto& shape : _baseData->_shapes)
                 {
-                    // Get the values for the scene graph objects
-                    updateObjectAttributeMAT(&shape._length, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._width, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._height, time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._lDir[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._lDir[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._lDir[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._wDir[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._wDir[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._wDir[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._r[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._r[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._r[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._rShape[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._rShape[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._rShape[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._T[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[2], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[3], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[4], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[5], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[6], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[7], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._T[8], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._color[0], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._color[1], time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._color[2], time, tmpReaderPtr);
-
-                    updateObjectAttributeMAT(&shape._specCoeff, time, tmpReaderPtr);
-                    updateObjectAttributeMAT(&shape._extra, time, tmpReaderPtr);
-
-                    rT = Util::rotation(
-                            osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
-                            osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
-                            osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp,
-                                         shape._T[4].exp, shape._T[5].exp, shape._T[6].exp, shape._T[7].exp,
-                                         shape._T[8].exp),
-                            osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
-                            osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
-                            shape._type);
-
-                    Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
+                    const double transformStart = profilingTick();
+                    if (nullptr != baked)
+                    {
+                        restoreShape(baked[shapeIdx], shape);
+                    }
+                    else
+                    {
+                        updateShapeFromFrame(shape);
+                    }
+                    const double sceneUpdateStart = profilingTick();
 
                     // Update the shapes.
                     _nodeUpdater->_shape = shape;
@@ -176,6 +553,9 @@ namespace OMVIS
                     // Get the scene graph nodes and stuff.
                     child = _viewerStuff->getScene()->getRootNode()->getChild(shapeIdx);  // the transformation
                     child->accept(*_nodeUpdater);
+                    const double sceneUpdateEnd = profilingTick();
+                    _frameTimings.transform += sceneUpdateStart - transformStart;
+                    _frameTimings.sceneUpdate += sceneUpdateEnd - sceneUpdateStart;
                     ++shapeIdx;
                 }
             }
@@ -188,6 +568,85 @@ namespace OMVIS
             }
         }
 
+        void VisualizerMAT::updateShapeFromFrame(ShapeObject& shape)
+        {
+            // Get the values for the scene graph objects
+            updateObjectAttributeMAT(&shape._length);
+            updateObjectAttributeMAT(&shape._width);
+            updateObjectAttributeMAT(&shape._height);
+
+            updateObjectAttributeMAT(&shape._lDir[0]);
+            updateObjectAttributeMAT(&shape._lDir[1]);
+            updateObjectAttributeMAT(&shape._lDir[2]);
+
+            updateObjectAttributeMAT(&shape._wDir[0]);
+            updateObjectAttributeMAT(&shape._wDir[1]);
+            updateObjectAttributeMAT(&shape._wDir[2]);
+
+            updateObjectAttributeMAT(&shape._r[0]);
+            updateObjectAttributeMAT(&shape._r[1]);
+            updateObjectAttributeMAT(&shape._r[2]);
+
+            updateObjectAttributeMAT(&shape._rShape[0]);
+            updateObjectAttributeMAT(&shape._rShape[1]);
+            updateObjectAttributeMAT(&shape._rShape[2]);
+
+            updateObjectAttributeMAT(&shape._T[0]);
+            updateObjectAttributeMAT(&shape._T[1]);
+            updateObjectAttributeMAT(&shape._T[2]);
+            updateObjectAttributeMAT(&shape._T[3]);
+            updateObjectAttributeMAT(&shape._T[4]);
+            updateObjectAttributeMAT(&shape._T[5]);
+            updateObjectAttributeMAT(&shape._T[6]);
+            updateObjectAttributeMAT(&shape._T[7]);
+            updateObjectAttributeMAT(&shape._T[8]);
+
+            updateObjectAttributeMAT(&shape._color[0]);
+            updateObjectAttributeMAT(&shape._color[1]);
+            updateObjectAttributeMAT(&shape._color[2]);
+
+            updateObjectAttributeMAT(&shape._specCoeff);
+            updateObjectAttributeMAT(&shape._extra);
+
+            OMVIS::Util::rAndT rT = Util::rotation(
+                    osg::Vec3f(shape._r[0].exp, shape._r[1].exp, shape._r[2].exp),
+                    osg::Vec3f(shape._rShape[0].exp, shape._rShape[1].exp, shape._rShape[2].exp),
+                    osg::Matrix3(shape._T[0].exp, shape._T[1].exp, shape._T[2].exp, shape._T[3].exp, shape._T[4].exp,
+                                 shape._T[5].exp, shape._T[6].exp, shape._T[7].exp, shape._T[8].exp),
+                    osg::Vec3f(shape._lDir[0].exp, shape._lDir[1].exp, shape._lDir[2].exp),
+                    osg::Vec3f(shape._wDir[0].exp, shape._wDir[1].exp, shape._wDir[2].exp), shape._length.exp,
+                    shape._type);
+
+            Util::assemblePokeMatrix(shape._mat, rT._T, rT._r);
+        }
+
+        void VisualizerMAT::bakeShape(const ShapeObject& shape, BakedShape& baked) const
+        {
+            const osg::Matrix::value_type* mat = shape._mat.ptr();
+            std::copy(mat, mat + 16, baked.mat);
+            baked.length = shape._length.exp;
+            baked.width = shape._width.exp;
+            baked.height = shape._height.exp;
+            baked.extra = shape._extra.exp;
+            baked.color[0] = shape._color[0].exp;
+            baked.color[1] = shape._color[1].exp;
+            baked.color[2] = shape._color[2].exp;
+            baked.specCoeff = shape._specCoeff.exp;
+        }
+
+        void VisualizerMAT::restoreShape(const BakedShape& baked, ShapeObject& shape) const
+        {
+            shape._mat.set(baked.mat);
+            shape._length.exp = baked.length;
+            shape._width.exp = baked.width;
+            shape._height.exp = baked.height;
+            shape._extra.exp = baked.extra;
+            shape._color[0].exp = baked.color[0];
+            shape._color[1].exp = baked.color[1];
+            shape._color[2].exp = baked.color[2];
+            shape._specCoeff.exp = baked.specCoeff;
+        }
+
         void VisualizerMAT::updateScene(const double time)
         {
             if (0.0 > time)
@@ -196,6 +655,11 @@ namespace OMVIS
                              Util::LL_ERROR);
             }
 
+            if (_followFile)
+            {
+                followResultFile();
+            }
+
             _timeManager->updateTick();  //for real-time measurement
             double visTime = _timeManager->getRealTime();
 
@@ -206,37 +670,46 @@ namespace OMVIS
             _timeManager->setRealTimeFactor(_timeManager->getHVisual() / visTime);
         }
 
-        void VisualizerMAT::updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr, double time,
-                                                     ModelicaMatReader* reader)
+        void VisualizerMAT::updateObjectAttributeMAT(Model::ShapeObjectAttribute* attr)
         {
             if (!attr->isConst)
             {
-                attr->exp = omcGetVarValue(reader, attr->cref.c_str(), time);
+                attr->exp = _frame.values[attr->varIdx];
             }
         }
 
-        double VisualizerMAT::omcGetVarValue(ModelicaMatReader* reader, const char* varName, double time)
+        void VisualizerMAT::setSimulationSettings(const Model::UserSimSettingsMAT& simSetMAT)
         {
-            double val = 0.0;
-            ModelicaMatVariable_t* var = nullptr;
-            var = omc_matlab4_find_var(reader, varName);
-            if (var == nullptr)
+            auto newVal = simSetMAT.speedup * _timeManager->getHVisual();
+            _timeManager->setHVisual(newVal);
+
+            setFollowFile(simSetMAT.followFile);
+
+            // The decimation always starts from all time points of the MAT file.
+            if (simSetMAT.decimationTolerance != _decimationTolerance)
             {
-                LOGGER_WRITE("Did not get variable from result file. Variable name is " + std::string(varName) + ".",
-                             Util::LC_SOLVER, Util::LL_ERROR);
+                _decimationTolerance = simSetMAT.decimationTolerance;
+                if (!_transformCache.isOpen())
+                {
+                    // A followed result file is still open.
+                    if (!_followFile)
+                    {
+                        openResultFile();
+                    }
+                    extractTimeline();
+                    _cursor.reset();
+                }
             }
-            else
+
+            if (simSetMAT.bakeTransforms)
             {
-                omc_matlab4_val(&val, reader, var, time);
+                bakeTransforms();
             }
-
-            return val;
         }
 
-        void VisualizerMAT::setSimulationSettings(const Model::UserSimSettingsMAT& simSetMAT)
+        UserSimSettingsMAT VisualizerMAT::getCurrentSimSettings() const
         {
-            auto newVal = simSetMAT.speedup * _timeManager->getHVisual();
-            _timeManager->setHVisual(newVal);
+            return {1.0, _transformCache.isOpen(), _decimationTolerance, _followFile};
         }
 
     }  // namespace Model
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Model/VisualizerMATClient.hpp"
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace OMVIS
+{
+    namespace Model
+    {
+
+        /// Number of time points of a window.
+        static const size_t s_windowRows = 4096;
+        /// Number of time points that consecutive windows share, thus, the time bracket at the end of a window is
+        /// contained in the following window.
+        static const size_t s_windowOverlap = 2;
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        VisualizerMATClient::VisualizerMATClient(const Initialization::RemoteVisualizationConstructionPlan* cP)
+                : VisualizerMAT(cP->modelFile, cP->wDir, VisType::MAT_REMOTE),
+                  _remoteFile(),
+                  _hostAddress(cP->hostAddress),
+                  _port(cP->port),
+                  _remotePathToModelFile(cP->path),
+                  _windowFirstRow(0),
+                  _windowNumRows(0),
+                  _nextWindow(),
+                  _nextWindowFirstRow(0),
+                  _nextWindowNumRows(0),
+                  _pendingWindow()
+        {
+        }
+
+        VisualizerMATClient::~VisualizerMATClient()
+        {
+            if (_pendingWindow.valid())
+            {
+                _pendingWindow.wait();
+            }
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void VisualizerMATClient::initData()
+        {
+            VisualizerMAT::initData();
+
+            // The timeline contains only the first window.
+            const auto& times = _remoteFile.getTimes();
+            if (!times.empty())
+            {
+                _timeManager->setStartTime(times.front());
+                _timeManager->setEndTime(times.back());
+            }
+        }
+
+        /*-----------------------------------------
+         * RESULT FILE METHODS
+         *---------------------------------------*/
+
+        void VisualizerMATClient::openResultFile()
+        {
+            discardNextWindow();
+            if (_remoteFile.isOpen())
+            {
+                return;
+            }
+
+            std::string resFileName = _remotePathToModelFile + _baseData->getModelFile();
+            try
+            {
+                _remoteFile.open(_hostAddress, _port, resFileName);
+            }
+            catch (std::exception& ex)
+            {
+                auto msg = "Could not open MAT file " + resFileName + " on " + _hostAddress + ":"
+                        + std::to_string(_port) + ". " + std::string(ex.what());
+                LOGGER_WRITE(msg, Util::LC_LOADER, Util::LL_ERROR);
+                throw std::runtime_error(msg);
+            }
+
+            _windowFirstRow = 0;
+            _windowNumRows = getWindowSize(0);
+            LOGGER_WRITE("Opened remote MAT file " + resFileName + " with " + std::to_string(_remoteFile.getNumRows())
+                         + " time points.", Util::LC_LOADER, Util::LL_INFO);
+        }
+
+        void VisualizerMATClient::closeResultFile()
+        {
+        }
+
+        size_t VisualizerMATClient::refreshResultFile()
+        {
+            return _windowNumRows;
+        }
+
+        bool VisualizerMATClient::isResultFileComplete() const
+        {
+            return true;
+        }
+
+        bool VisualizerMATClient::findResultVariable(const std::string& name, MatVariableRef& ref) const
+        {
+            const MatVariable* var = _remoteFile.findVariable(name);
+            if (nullptr == var)
+            {
+                return false;
+            }
+
+            // Negative aliases are stored with a negative index. Map them to the aliased column and keep the sign.
+            ref.isParam = var->isParam;
+            ref.index = std::abs(var->index) - 1;
+            ref.sign = (0 > var->index) ? -1.0 : 1.0;
+            return true;
+        }
+
+        size_t VisualizerMATClient::getNumResultRows() const
+        {
+            return _windowNumRows;
+        }
+
+        void VisualizerMATClient::readResultRows(const size_t firstRow, const size_t numRows, const size_t timelineRow)
+        {
+            // The connection must not be used by the background request at the same time.
+            discardNextWindow();
+            fetchRows(_windowFirstRow + firstRow, numRows, _timeline, timelineRow);
+        }
+
+        void VisualizerMATClient::updateTimelineWindow(const double time)
+        {
+            const size_t row = _remoteFile.findRow(time);
+            try
+            {
+                if (!isInWindow(row, _windowFirstRow, _windowNumRows))
+                {
+                    // Take the requested window, if it contains the time. Otherwise, the user jumped in time.
+                    bool isNextWindow = false;
+                    if (_pendingWindow.valid())
+                    {
+                        _pendingWindow.get();
+                        isNextWindow = isInWindow(row, _nextWindowFirstRow, _nextWindowNumRows);
+                    }
+                    if (!isNextWindow)
+                    {
+                        _nextWindowFirstRow = row - std::min(row, s_windowOverlap);
+                        _nextWindowNumRows = getWindowSize(_nextWindowFirstRow);
+                        allocateWindow(_nextWindow, _nextWindowNumRows);
+                        fetchRows(_nextWindowFirstRow, _nextWindowNumRows, _nextWindow, 0);
+                    }
+                    swapTimeline(_nextWindow);
+                    _windowFirstRow = _nextWindowFirstRow;
+                    _windowNumRows = _nextWindowNumRows;
+                }
+
+                // Request the following window as soon as the playback passed the middle of the current one.
+                const size_t windowEnd = _windowFirstRow + _windowNumRows;
+                if (!_pendingWindow.valid() && row >= _windowFirstRow + _windowNumRows / 2
+                        && windowEnd < _remoteFile.getNumRows())
+                {
+                    requestNextWindow(windowEnd - s_windowOverlap);
+                }
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE("Could not request the time points at " + std::to_string(time) + " from the server. "
+                             + std::string(ex.what()), Util::LC_LOADER, Util::LL_ERROR);
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        bool VisualizerMATClient::isInWindow(const size_t row, const size_t firstRow, const size_t numRows) const
+        {
+            return firstRow <= row && (row + 1 < firstRow + numRows || firstRow + numRows == _remoteFile.getNumRows());
+        }
+
+        size_t VisualizerMATClient::getWindowSize(const size_t firstRow) const
+        {
+            return std::min(s_windowRows, _remoteFile.getNumRows() - firstRow);
+        }
+
+        void VisualizerMATClient::allocateWindow(ResultTimeline& timeline, const size_t numRows) const
+        {
+            std::vector<bool> constColumns(_matVarRefs.size());
+            for (size_t i = 0; i < _matVarRefs.size(); ++i)
+            {
+                constColumns[i] = _matVarRefs[i].isParam;
+            }
+            timeline.allocate(numRows, constColumns);
+        }
+
+        void VisualizerMATClient::requestNextWindow(const size_t firstRow)
+        {
+            _nextWindowFirstRow = firstRow;
+            _nextWindowNumRows = getWindowSize(firstRow);
+            allocateWindow(_nextWindow, _nextWindowNumRows);
+            _pendingWindow = std::async(std::launch::async, [this]()
+            {
+                fetchRows(_nextWindowFirstRow, _nextWindowNumRows, _nextWindow, 0);
+            });
+        }
+
+        void VisualizerMATClient::discardNextWindow()
+        {
+            if (!_pendingWindow.valid())
+            {
+                return;
+            }
+
+            try
+            {
+                _pendingWindow.get();
+            }
+            catch (std::exception& ex)
+            {
+                LOGGER_WRITE("Discarded a failed window request. " + std::string(ex.what()), Util::LC_LOADER,
+                             Util::LL_WARNING);
+            }
+        }
+
+        void VisualizerMATClient::fetchRows(const size_t firstRow, const size_t numRows, ResultTimeline& timeline,
+                                            const size_t timelineRow)
+        {
+            // The time points and parameters are known locally.
+            const auto& times = _remoteFile.getTimes();
+            std::copy(times.begin() + firstRow, times.begin() + firstRow + numRows, timeline.getTimes() + timelineRow);
+
+            std::vector<size_t> columns;
+            std::vector<float*> out;
+            for (size_t i = 0; i < _matVarRefs.size(); ++i)
+            {
+                const auto& ref = _matVarRefs[i];
+                float* column = timeline.getColumn(i);
+                if (ref.isParam)
+                {
+                    if (0 == timelineRow)
+                    {
+                        column[0] = static_cast<float>(ref.sign * _remoteFile.getParameters().at(ref.index));
+                    }
+                }
+                else
+                {
+                    columns.push_back(ref.index);
+                    out.push_back(column + timelineRow);
+                }
+            }
+            _remoteFile.readRows(columns, firstRow, numRows, out);
+
+            // Negative aliases are transferred as stored in the file.
+            for (size_t i = 0, j = 0; i < _matVarRefs.size(); ++i)
+            {
+                if (_matVarRefs[i].isParam)
+                {
+                    continue;
+                }
+                if (0.0 > _matVarRefs[i].sign)
+                {
+                    std::transform(out[j], out[j] + numRows, out[j], [](const float value) {return -value;});
+                }
+                ++j;
+            }
+        }
+
+    }  // namespace Model
+}  // namespace OMVIS
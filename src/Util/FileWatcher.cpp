@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/FileWatcher.hpp"
+
+#include <boost/filesystem.hpp>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        FileWatcher::FileWatcher()
+                : _fileName(),
+                  _inotifyFd(-1),
+                  _watchFd(-1),
+                  _size(0),
+                  _modTime(0)
+        {
+        }
+
+        FileWatcher::~FileWatcher()
+        {
+            stop();
+        }
+
+        /*-----------------------------------------
+         * INITIALIZATION METHODS
+         *---------------------------------------*/
+
+        void FileWatcher::watch(const std::string& fileName)
+        {
+            stop();
+            _fileName = fileName;
+            hasChangedStat();
+
+#ifdef __linux__
+            _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (0 <= _inotifyFd)
+            {
+                _watchFd = inotify_add_watch(_inotifyFd, fileName.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB);
+                if (0 > _watchFd)
+                {
+                    close(_inotifyFd);
+                    _inotifyFd = -1;
+                }
+            }
+#endif
+        }
+
+        void FileWatcher::stop()
+        {
+#ifdef __linux__
+            if (0 <= _inotifyFd)
+            {
+                close(_inotifyFd);
+            }
+#endif
+            _inotifyFd = -1;
+            _watchFd = -1;
+            _fileName.clear();
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        bool FileWatcher::isWatching() const
+        {
+            return !_fileName.empty();
+        }
+
+        bool FileWatcher::hasChanged()
+        {
+            if (!isWatching())
+            {
+                return false;
+            }
+
+#ifdef __linux__
+            if (0 <= _inotifyFd)
+            {
+                // Drain all pending events. Any event means that the file has been modified.
+                bool hasEvents = false;
+                alignas(struct inotify_event) char buffer[4096];
+                while (0 < read(_inotifyFd, buffer, sizeof(buffer)))
+                {
+                    hasEvents = true;
+                }
+                return hasEvents;
+            }
+#endif
+            return hasChangedStat();
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        bool FileWatcher::hasChangedStat()
+        {
+            boost::system::error_code ec;
+            uintmax_t size = boost::filesystem::file_size(_fileName, ec);
+            std::time_t modTime = ec ? 0 : boost::filesystem::last_write_time(_fileName, ec);
+            if (ec)
+            {
+                return false;
+            }
+
+            bool changed = (size != _size || modTime != _modTime);
+            _size = size;
+            _modTime = modTime;
+            return changed;
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
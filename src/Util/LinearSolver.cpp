@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/LinearSolver.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        bool luFactorize(std::vector<double>& a, const size_t n, std::vector<size_t>& pivots)
+        {
+            pivots.resize(n);
+            for (size_t k = 0; k < n; ++k)
+            {
+                // Select the row with the largest entry in column k.
+                size_t pivot = k;
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    if (std::abs(a[i * n + k]) > std::abs(a[pivot * n + k]))
+                    {
+                        pivot = i;
+                    }
+                }
+                pivots[k] = pivot;
+                if (0.0 == a[pivot * n + k])
+                {
+                    return false;
+                }
+                if (pivot != k)
+                {
+                    for (size_t j = 0; j < n; ++j)
+                    {
+                        std::swap(a[k * n + j], a[pivot * n + j]);
+                    }
+                }
+
+                // Eliminate column k below the diagonal.
+                const double diag = a[k * n + k];
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    const double l = a[i * n + k] / diag;
+                    a[i * n + k] = l;
+                    if (0.0 != l)
+                    {
+                        for (size_t j = k + 1; j < n; ++j)
+                        {
+                            a[i * n + j] -= l * a[k * n + j];
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        void luSolve(const std::vector<double>& lu, const size_t n, const std::vector<size_t>& pivots, double* b)
+        {
+            // Forward substitution with the row swaps applied in order.
+            for (size_t k = 0; k < n; ++k)
+            {
+                std::swap(b[k], b[pivots[k]]);
+                for (size_t j = 0; j < k; ++j)
+                {
+                    b[k] -= lu[k * n + j] * b[j];
+                }
+            }
+            // Backward substitution.
+            for (size_t k = n; 0 < k--;)
+            {
+                for (size_t j = k + 1; j < n; ++j)
+                {
+                    b[k] -= lu[k * n + j] * b[j];
+                }
+                b[k] /= lu[k * n + k];
+            }
+        }
+
+        std::vector<size_t> colorColumns(const std::vector<bool>& pattern, const size_t n)
+        {
+            std::vector<size_t> colors(n, 0);
+            // For each color, the rows that are already covered by one of its columns.
+            std::vector<std::vector<bool>> coveredRows;
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                size_t color = 0;
+                for (; color < coveredRows.size(); ++color)
+                {
+                    bool isDisjoint = true;
+                    for (size_t i = 0; i < n && isDisjoint; ++i)
+                    {
+                        isDisjoint = !(pattern[i * n + j] && coveredRows[color][i]);
+                    }
+                    if (isDisjoint)
+                    {
+                        break;
+                    }
+                }
+                if (color == coveredRows.size())
+                {
+                    coveredRows.push_back(std::vector<bool>(n, false));
+                }
+                for (size_t i = 0; i < n; ++i)
+                {
+                    if (pattern[i * n + j])
+                    {
+                        coveredRows[color][i] = true;
+                    }
+                }
+                colors[j] = color;
+            }
+            return colors;
+        }
+
+        size_t approximateJacobian(const std::function<void(const double*, double*)>& f, const double* x,
+                                   const double* fx, const size_t n, const std::vector<bool>& pattern,
+                                   const std::vector<size_t>& colors, std::vector<double>& jacobian)
+        {
+            const bool isPatternKnown = !pattern.empty();
+            size_t numColors = isPatternKnown ? 0 : n;
+            if (isPatternKnown)
+            {
+                for (auto color : colors)
+                {
+                    numColors = std::max(numColors, color + 1);
+                }
+            }
+
+            std::vector<double> xPerturbed(n);
+            std::vector<double> fxPerturbed(n);
+            jacobian.assign(n * n, 0.0);
+            for (size_t color = 0; color < numColors; ++color)
+            {
+                // Without a pattern, each column has its own color.
+                std::copy(x, x + n, xPerturbed.begin());
+                for (size_t j = 0; j < n; ++j)
+                {
+                    if (isPatternKnown ? color == colors[j] : color == j)
+                    {
+                        xPerturbed[j] += std::sqrt(DBL_EPSILON) * std::max(std::abs(x[j]), 1.0);
+                    }
+                }
+                f(xPerturbed.data(), fxPerturbed.data());
+
+                for (size_t j = 0; j < n; ++j)
+                {
+                    if (isPatternKnown ? color != colors[j] : color != j)
+                    {
+                        continue;
+                    }
+                    const double delta = xPerturbed[j] - x[j];
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        if (!isPatternKnown || pattern[i * n + j])
+                        {
+                            jacobian[i * n + j] = (fxPerturbed[i] - fx[i]) / delta;
+                        }
+                    }
+                }
+            }
+            return numColors;
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Util/ThreadPool.hpp"
+
+namespace OMVIS
+{
+    namespace Util
+    {
+
+        /*-----------------------------------------
+         * CONSTRUCTORS
+         *---------------------------------------*/
+
+        ThreadPool::ThreadPool(const size_t numWorkers)
+                : _workers(),
+                  _mutex(),
+                  _taskCondition(),
+                  _doneCondition(),
+                  _task(nullptr),
+                  _numTasks(0),
+                  _nextTask(0),
+                  _numDoneTasks(0),
+                  _exception(),
+                  _isStopping(false)
+        {
+            _workers.reserve(numWorkers);
+            for (size_t i = 0; i < numWorkers; ++i)
+            {
+                _workers.emplace_back(&ThreadPool::work, this);
+            }
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _isStopping = true;
+            }
+            _taskCondition.notify_all();
+            for (auto& worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        /*-----------------------------------------
+         * GETTERS
+         *---------------------------------------*/
+
+        size_t ThreadPool::getNumWorkers() const
+        {
+            return _workers.size();
+        }
+
+        /*-----------------------------------------
+         * PARALLEL METHODS
+         *---------------------------------------*/
+
+        void ThreadPool::parallelFor(const size_t numTasks, const std::function<void(size_t)>& task)
+        {
+            if (0 == numTasks)
+            {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _task = &task;
+            _numTasks = numTasks;
+            _nextTask = 0;
+            _numDoneTasks = 0;
+            _exception = nullptr;
+            _taskCondition.notify_all();
+
+            processTasks(lock);
+            _doneCondition.wait(lock, [this]()
+            {
+                return _numDoneTasks == _numTasks;
+            });
+            _task = nullptr;
+
+            if (_exception)
+            {
+                std::exception_ptr exception = _exception;
+                _exception = nullptr;
+                std::rethrow_exception(exception);
+            }
+        }
+
+        /*-----------------------------------------
+         * PRIVATE METHODS
+         *---------------------------------------*/
+
+        void ThreadPool::work()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _taskCondition.wait(lock, [this]()
+                {
+                    return _isStopping || (nullptr != _task && _nextTask < _numTasks);
+                });
+                if (_isStopping)
+                {
+                    return;
+                }
+                processTasks(lock);
+            }
+        }
+
+        void ThreadPool::processTasks(std::unique_lock<std::mutex>& lock)
+        {
+            while (nullptr != _task && _nextTask < _numTasks)
+            {
+                const size_t idx = _nextTask++;
+                const std::function<void(size_t)>& task = *_task;
+                std::exception_ptr exception;
+                lock.unlock();
+                try
+                {
+                    task(idx);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+                lock.lock();
+
+                if (exception && !_exception)
+                {
+                    _exception = exception;
+                }
+                if (++_numDoneTasks == _numTasks)
+                {
+                    _doneCondition.notify_all();
+                }
+            }
+        }
+
+    }  // namespace Util
+}  // namespace OMVIS
@@ -193,11 +193,10 @@ namespace OMVIS
          * Extract Shape information
          *****************************/
 
-        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const NetOff::ValueContainer& _outputCont)
+        void updateObjectAttributeFMUClient(Model::ShapeObjectAttribute& attr, const std::vector<double>& values)
         {
             if (!attr.isConst)
-                attr.exp = (float)(_outputCont.getRealValues()[attr.fmuValueRef]);
-                //attr.exp = reinterpret_cast<float>(_outputCont.getRealValues()[attr.fmuValueRef]);
+                attr.exp = (float)(values[attr.varIdx]);
         }
 
         double getShapeAttrFMU(const char* attr, rapidxml::xml_node<>* node, double time, fmi1_import_t* fmu)
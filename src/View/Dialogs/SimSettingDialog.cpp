@@ -44,6 +44,7 @@ namespace OMVIS
                   _simStepSizeLineEdit(new QLineEdit(QString::number(simSetFMU.simStepSize))),
                   _visStepSizeLineEdit(new QLineEdit(QString::number(simSetFMU.visStepSize))),
                   _simEndTimeLineEdit(new QLineEdit(QString::number(simSetFMU.simEndTime))),
+                  _realTimeFactorLineEdit(new QLineEdit(QString::number(simSetFMU.realTimeFactor))),
                   _simSet()
         {
             // Main layout
@@ -53,7 +54,15 @@ namespace OMVIS
             setWindowTitle(tr("Simulation Settings"));
 
             // Solver method
+            // The order of the items corresponds to Model::Solver shifted by one.
             _solverBox->addItem(QString("Forward Euler"));
+            _solverBox->addItem(QString("Runge-Kutta 4"));
+            _solverBox->addItem(QString("Dormand-Prince 5(4), adaptive"));
+            _solverBox->addItem(QString("Backward Euler, implicit"));
+            if (Model::Solver::NONE != simSetFMU.solver)
+            {
+                _solverBox->setCurrentIndex(static_cast<int>(simSetFMU.solver) - 1);
+            }
             QLabel* solverLabel = new QLabel(tr("Solver Method: "));
             QHBoxLayout* solverLayout = new QHBoxLayout();
             solverLayout->addWidget(solverLabel);
@@ -77,18 +86,32 @@ namespace OMVIS
             endTimeLayout->addWidget(endTimeLabel);
             endTimeLayout->addWidget(_simEndTimeLineEdit.get());
 
+            // Target real time factor, e.g., 0.5 for slow motion or 2 for fast-forward
+            QHBoxLayout* realTimeFactorLayout = new QHBoxLayout();
+            QLabel* realTimeFactorLabel = new QLabel(tr("Real Time Factor: "));
+            realTimeFactorLayout->addWidget(realTimeFactorLabel);
+            realTimeFactorLayout->addWidget(_realTimeFactorLineEdit.get());
+
             mainLayout->addLayout(solverLayout);
             mainLayout->addLayout(simStepSizeLayout);
             mainLayout->addLayout(visStepSizeLayout);
             mainLayout->addLayout(endTimeLayout);
+            mainLayout->addLayout(realTimeFactorLayout);
             mainLayout->addLayout(_okCancelHelpButtonLayout);
         }
 
-        SimSettingDialogMAT::SimSettingDialogMAT(QWidget* parent)
+        SimSettingDialogMAT::SimSettingDialogMAT(QWidget* parent, const Model::UserSimSettingsMAT& simSetMAT)
                 : OkCancelHelpButtonBox(),
                   _speedupLineEdit(new QLineEdit("1.0")),
-                  _simSet()
+                  _bakeCheckBox(new QCheckBox(tr("Bake shapes into cache file"))),
+                  _toleranceLineEdit(new QLineEdit(QString::number(simSetMAT.decimationTolerance))),
+                  _followCheckBox(new QCheckBox(tr("Follow result file while it is written"))),
+                  _simSet(simSetMAT)
         {
+            _simSet.speedup = 1.0;
+            _bakeCheckBox->setChecked(simSetMAT.bakeTransforms);
+            _followCheckBox->setChecked(simSetMAT.followFile);
+
             // Main layout
             QVBoxLayout* mainLayout = new QVBoxLayout();
             mainLayout->addStretch(1);
@@ -118,7 +141,16 @@ namespace OMVIS
             speedUpLayout->addWidget(speedUpLabel);
             speedUpLayout->addWidget(_speedupLineEdit.get());
 
+            // Tolerance for the decimation of the time points
+            QHBoxLayout* toleranceLayout = new QHBoxLayout();
+            QLabel* toleranceLabel = new QLabel(tr("Decimation Tolerance: "));
+            toleranceLayout->addWidget(toleranceLabel);
+            toleranceLayout->addWidget(_toleranceLineEdit.get());
+
             mainLayout->addLayout(speedUpLayout);
+            mainLayout->addLayout(toleranceLayout);
+            mainLayout->addWidget(_bakeCheckBox.get());
+            mainLayout->addWidget(_followCheckBox.get());
 //            mainLayout->addWidget(explanationLabel);
             mainLayout->addLayout(_okCancelHelpButtonLayout);
         }
@@ -134,6 +166,7 @@ namespace OMVIS
             _simSet.simStepSize = _simStepSizeLineEdit->text().toDouble();
             _simSet.visStepSize = _visStepSizeLineEdit->text().toDouble();
             _simSet.simEndTime = _simEndTimeLineEdit->text().toDouble();
+            _simSet.realTimeFactor = _realTimeFactorLineEdit->text().toDouble();
             QDialog::accept();
         }
 
@@ -141,10 +174,18 @@ namespace OMVIS
         {
           QString information("For a FMU visualization, the user can select several settings:"
                               "<ul>"
-                              "<li><b>Solver:</b> The integration algorithm (a.k.a. solver) can be chosen. </li>"
-                              "<li><b>Simulation Step Size:</b> </li>"
+                              "<li><b>Solver:</b> The integration algorithm (a.k.a. solver) can be chosen. "
+                              "Runge-Kutta 4 allows much larger step sizes than Forward Euler. Dormand-Prince "
+                              "adapts the step size to the relative tolerance of the FMU. Backward Euler is stable "
+                              "for stiff models even with large step sizes.</li>"
+                              "<li><b>Simulation Step Size:</b> The step size of the fixed step solvers and the "
+                              "maximum step size of the adaptive solver.</li>"
                               "<li><b>Visualization Step Size (aka render frequency):</b> </li>"
                               "<li><b>Simulation End Time:</b> Set the simulation end time.</li>"
+                              "<li><b>Real Time Factor:</b> The simulation time is locked to the wall clock time "
+                              "multiplied with this factor. A factor less than 1.0 is a slow motion, a factor greater "
+                              "than 1.0 a fast-forward. If the model cannot keep up, the lag and the dropped frames are "
+                              "shown next to the achieved real time factor.</li>"
                               "</ul>"
           );
           QMessageBox msgBox(QMessageBox::Information, tr("Help"), information);
@@ -163,6 +204,17 @@ namespace OMVIS
                     _simSet.speedup = 1.0;
                 }
             }
+            if (_toleranceLineEdit->isModified())
+            {
+                _simSet.decimationTolerance = _toleranceLineEdit->text().toDouble();
+                if (0.0 > _simSet.decimationTolerance)
+                {
+                    QMessageBox::warning(0, QString("Information"), QString("A negative tolerance is not valid."));
+                    _simSet.decimationTolerance = 0.0;
+                }
+            }
+            _simSet.bakeTransforms = _bakeCheckBox->isChecked();
+            _simSet.followFile = _followCheckBox->isChecked();
             QDialog::accept();
         }
 
@@ -173,7 +225,26 @@ namespace OMVIS
                                "rough overview on the model behavior. <br><br>"
                                "[A speedup less than 1.0 is not possible, <br>"
                                "since the result file does not provide <br>"
-                               "enough (intermediate) data.]");
+                               "enough (intermediate) data.]<br><br>"
+                               "Baking the shapes computes the position, <br>"
+                               "orientation, size and color of all shapes <br>"
+                               "at every time point of the result file and <br>"
+                               "stores them in a cache file next to it. <br>"
+                               "The cache file is reused as long as the <br>"
+                               "result file and the visual XML file do <br>"
+                               "not change.<br><br>"
+                               "A decimation tolerance greater than 0.0 <br>"
+                               "removes all time points that can be <br>"
+                               "interpolated from their neighbors with an <br>"
+                               "absolute error less than the tolerance. <br>"
+                               "This reduces the memory consumption for <br>"
+                               "long simulations. Baking requires a <br>"
+                               "tolerance of 0.0.<br><br>"
+                               "Following the result file appends the <br>"
+                               "time points that a running simulation <br>"
+                               "writes to it. It is enabled automatically <br>"
+                               "for incomplete MAT files and cannot be <br>"
+                               "combined with baking.");
           QMessageBox msgBox(QMessageBox::Information, tr("Help"), information);
           msgBox.setStandardButtons(QMessageBox::Close);
           msgBox.exec();
@@ -43,6 +43,7 @@
 #include <QMessageBox>
 #include <QDialog>
 #include <QComboBox>
+#include <QFileDialog>
 #include <QMenuBar>
 
 #include <assert.h>
@@ -74,6 +75,7 @@ namespace OMVIS
                   _openAct(nullptr),
                   _openRCAct(nullptr),
                   _exportAct(nullptr),
+                  _recordAct(nullptr),
                   _exitAct(nullptr),
                   _mapInputAct(nullptr),
                   _dontCareAct(nullptr),
@@ -193,6 +195,10 @@ namespace OMVIS
 
             _exportAct = new QAction(tr("Export Video"), this);
             QObject::connect(_exportAct, SIGNAL(triggered()), this, SLOT(exportVideo()));
+            _recordAct = new QAction(tr("Record Simulation..."), this);
+            _recordAct->setCheckable(true);
+            _recordAct->setEnabled(false);
+            QObject::connect(_recordAct, SIGNAL(triggered()), this, SLOT(recordSimulation()));
             _exitAct = new QAction(tr("Quit"), this);
             _exitAct->setShortcut(tr("Ctrl+Q"));
             QObject::connect(_exitAct, SIGNAL(triggered()), this, SLOT(close()));
@@ -228,6 +234,7 @@ namespace OMVIS
             _fileMenu->addAction(_unloadAct);
 
             _fileMenu->addAction(_exportAct);
+            _fileMenu->addAction(_recordAct);
             _fileMenu->addSeparator();
             _fileMenu->addAction(_exitAct);
 
@@ -387,6 +394,8 @@ namespace OMVIS
         {
             _guiController->sceneUpdate();
             updateTimingElements();
+            // The recording stops if the visualization is rewound or initialized.
+            _recordAct->setChecked(_recordAct->isEnabled() && _guiController->isRecording());
         }
 
         void OMVISViewer::setVisTimeSlotFunction(int val)
@@ -436,9 +445,9 @@ namespace OMVIS
                     Control::KeyboardEventHandler* kbEventHandler = new Control::KeyboardEventHandler(
                             _guiController->getInputData());
                     _sceneView->addEventHandler(kbEventHandler);
-                    disableTimeSlider();
                 }
-                if (_guiController->visTypeIsMAT())
+                // For FMUs, the time slider rewinds through the recorded frames.
+                if (_guiController->visTypeIsFMU() || _guiController->visTypeIsMAT() || _guiController->visTypeIsCSV())
                 {
                     enableTimeSlider();
                 }
@@ -456,6 +465,7 @@ namespace OMVIS
 
             // If a model is loaded, we can enable some buttons
             _simSettingsAct->setEnabled(true);
+            _recordAct->setEnabled(_guiController->modelIsLoaded() && _guiController->visTypeIsFMU());
         }
 
         //MF: Compute on a server, visualize on localhost
@@ -479,6 +489,7 @@ namespace OMVIS
 
                 assert(constructionPlan.visType != Model::VisType::FMU);
                 assert(constructionPlan.visType != Model::VisType::MAT);
+                assert(constructionPlan.visType != Model::VisType::CSV);
 
                 // Now, let the factory create the VisualizerFMUClient object, establish the connection
                 // and initialize the simulation.
@@ -505,6 +516,10 @@ namespace OMVIS
                             _guiController->getInputData());
                     _sceneView->addEventHandler(kbEventHandler);
                 }
+                if (_guiController->visTypeIsMATRemote())
+                {
+                    enableTimeSlider();
+                }
 
                 // Update the slider and the time displays.
                 updateTimingElements();
@@ -532,6 +547,8 @@ namespace OMVIS
 
             // If a model is unloaded, we can disable some buttons
             _simSettingsAct->setEnabled(false);
+            _recordAct->setChecked(false);
+            _recordAct->setEnabled(false);
             disableTimeSlider();
 
             // Show logo
@@ -544,6 +561,41 @@ namespace OMVIS
             QMessageBox::warning(nullptr, QString("Information"), QString("This functionality might come soon."));
         }
 
+        void OMVISViewer::recordSimulation()
+        {
+            if (_guiController->isRecording())
+            {
+                _guiController->stopRecording();
+                _recordAct->setChecked(false);
+                return;
+            }
+
+            // VisualizerMAT expects the suffix _res.mat.
+            std::string modelFile = _guiController->getModelFile();
+            std::string defaultName = modelFile.substr(0, modelFile.find_last_of('.')) + "_rec_res.mat";
+            QString fileName = QFileDialog::getSaveFileName(this, tr("Record Simulation"),
+                                                            QString::fromStdString(defaultName),
+                                                            tr("MAT Result Files (*_res.mat)"));
+            if (fileName.isEmpty())
+            {
+                _recordAct->setChecked(false);
+                return;
+            }
+
+            auto answer = QMessageBox::question(this, tr("Record Simulation"),
+                                                tr("Record the outputs of the FMU as well?"),
+                                                QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+            try
+            {
+                _guiController->startRecording(fileName.toStdString(), QMessageBox::Yes == answer);
+            }
+            catch (std::exception& ex)
+            {
+                QMessageBox::critical(nullptr, QString("Error"), QString(ex.what()));
+            }
+            _recordAct->setChecked(_guiController->isRecording());
+        }
+
         void OMVISViewer::openDialogInputMapper()
         {
             // Proceed, if a model is already loaded. Otherwise give the user a hint to load a model first.
@@ -555,9 +607,10 @@ namespace OMVIS
                 msgBox.exec();
             }
             // If a result file is visualized, we cannot map keys to input variables.
-            else if (_guiController->visTypeIsMAT())
+            else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsCSV()
+                    || _guiController->visTypeIsMATRemote())
             {
-                QString information("Input Mapping is not available for mat file visualization.");
+                QString information("Input Mapping is not available for result file visualization.");
                 QMessageBox msgBox(QMessageBox::Information, tr("Not Available"), information, QMessageBox::NoButton);
                 msgBox.setStandardButtons(QMessageBox::Close);
                 msgBox.exec();
@@ -755,13 +808,13 @@ namespace OMVIS
                         _visTimer.setInterval(simSetFMU.visStepSize);
                     }
                 }
-                else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsMATRemote())
+                else if (_guiController->visTypeIsMAT() || _guiController->visTypeIsMATRemote()
+                        || _guiController->visTypeIsCSV())
                 {
-                    SimSettingDialogMAT dialog(this);
+                    SimSettingDialogMAT dialog(this, _guiController->getCurrentSimSettingsMAT());
                     if (0 != dialog.exec())
                     {
                         Model::UserSimSettingsMAT simSetMAT = dialog.getSimSettings();
-                        // Currently, the user can only specify a speed up and slow down, respectively.
                         _guiController->handleSimulationSettings(simSetMAT);
                     }
                 }
@@ -922,7 +975,15 @@ namespace OMVIS
             double visTime = _guiController->getVisTime();
             double rtf = _guiController->getRealTimeFactor();
             _timeDisplay->setText(QString("Time [s]: ").append(QString::number(visTime)));
-            _RTFactorDisplay->setText(QString("RT-Factor: ").append(QString::number(rtf)));
+            QString rtfText = QString("RT-Factor: ").append(QString::number(rtf));
+            // The pacing of FMU simulations reports whether the simulation keeps up with the real time factor.
+            if (_guiController->visTypeIsFMU())
+            {
+                rtfText.append(QString(" Lag [s]: ")).append(QString::number(_guiController->getLag()));
+                rtfText.append(QString(" Dropped Frames: "))
+                        .append(QString::number(_guiController->getNumDroppedFrames()));
+            }
+            _RTFactorDisplay->setText(rtfText);
         }
 
         void OMVISViewer::updateTimeSliderPosition()
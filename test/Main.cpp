@@ -27,6 +27,17 @@
 #include "TestVisualizationConstructionPlans.hpp"
 #include "TestCommon.hpp"
 #include "TestTimeManager.hpp"
+#include "TestMatFileReader.hpp"
+#include "TestResultTimeline.hpp"
+#include "TestTransformCache.hpp"
+#include "TestCsvFileReader.hpp"
+#include "TestRemoteMatFile.hpp"
+#include "TestLinearSolver.hpp"
+#include "TestPacingGovernor.hpp"
+#include "TestThreadPool.hpp"
+#include "TestFrameHistory.hpp"
+#include "TestMatFileWriter.hpp"
+#include "TestFMUCache.hpp"
 
 
 int main(int argc, char **argv)
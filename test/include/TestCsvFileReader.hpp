@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTCSVFILEREADER_HPP_
+#define TEST_INCLUDE_TESTCSVFILEREADER_HPP_
+
+#include "Model/CsvFileReader.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+/*! \brief Class to test the class \ref Model::CsvFileReader.
+ *
+ * A small CSV file with quoted names, Windows line endings and an empty last line is written to the temporary
+ * directory.
+ */
+class TestCsvFileReader : public ::testing::Test
+{
+ public:
+    std::string _fileName;
+
+    TestCsvFileReader()
+            : _fileName()
+    {
+    }
+
+    void SetUp()
+    {
+        _fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+        std::ofstream file(_fileName, std::ios::binary);
+        file << "\"x\",\"time\",\"body.r[1]\",\"body.r[2]\"\r\n"
+             << "1,0.0,-1.5,2e-3\r\n"
+             << "2,0.5,  0.25,nan\r\n"
+             << "3,1.0,+7,1.0E+2\r\n"
+             << "\r\n";
+    }
+
+    void TearDown()
+    {
+        boost::filesystem::remove(_fileName);
+    }
+
+    ~TestCsvFileReader()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test the header and the number of rows.
+ */
+TEST_F (TestCsvFileReader, Open)
+{
+    OMVIS::Model::CsvFileReader reader;
+    reader.open(_fileName);
+    EXPECT_TRUE(reader.isOpen());
+    EXPECT_EQ(4, reader.getNumColumns());
+    EXPECT_EQ(3, reader.getNumRows());
+    EXPECT_EQ(1, reader.getTimeColumn());
+    EXPECT_EQ(3, reader.findColumn("body.r[2]"));
+    EXPECT_EQ(-1, reader.findColumn("body.r[3]"));
+
+    reader.close();
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_THROW(reader.open(_fileName + ".missing"), std::runtime_error);
+}
+
+/*!
+ * Test fixture to test that delimiters inside of quoted names do not split the column.
+ */
+TEST_F (TestCsvFileReader, QuotedNames)
+{
+    std::ofstream file(_fileName, std::ios::binary | std::ios::trunc);
+    file << "\"time\",\"b.R.T[1,1]\",\"b.r[1]\"\n"
+         << "0.0,1.0,2.0\n";
+    file.close();
+
+    OMVIS::Model::CsvFileReader reader;
+    reader.open(_fileName);
+    EXPECT_EQ(3, reader.getNumColumns());
+    EXPECT_EQ(1, reader.findColumn("b.R.T[1,1]"));
+    EXPECT_EQ(2, reader.findColumn("b.r[1]"));
+
+    std::vector<double> times(1);
+    std::vector<float> r(1);
+    reader.readColumns({ 2 }, times.data(), { r.data() });
+    EXPECT_FLOAT_EQ(2.0f, r[0]);
+}
+
+/*!
+ * Test fixture to test that only the requested columns are parsed correctly.
+ */
+TEST_F (TestCsvFileReader, Values)
+{
+    OMVIS::Model::CsvFileReader reader;
+    reader.open(_fileName);
+
+    std::vector<double> times(3);
+    std::vector<float> r1(3), r2(3);
+    reader.readColumns({ 3, 2 }, times.data(), { r2.data(), r1.data() });
+    EXPECT_EQ(0.5, times[1]);
+    EXPECT_EQ(1.0, times[2]);
+    EXPECT_FLOAT_EQ(-1.5f, r1[0]);
+    EXPECT_FLOAT_EQ(0.25f, r1[1]);
+    EXPECT_FLOAT_EQ(7.0f, r1[2]);
+    EXPECT_FLOAT_EQ(2.0e-3f, r2[0]);
+    EXPECT_TRUE(std::isnan(r2[1]));
+    EXPECT_FLOAT_EQ(100.0f, r2[2]);
+}
+
+/*!
+ * Test fixture to test the number parser against std::strtod.
+ */
+TEST_F (TestCsvFileReader, ParseNumber)
+{
+    for (const char* str : { "0", "-0.0", "123456789", "3.14159265358979", "1e-300", "-2.5E+10", "0.000001",
+            "12345678901234567890123", "4.9e-324", ".5", "7." })
+    {
+        const char* p = str;
+        double value;
+        EXPECT_TRUE(OMVIS::Model::CsvFileReader::parseNumber(p, str + std::strlen(str), value));
+        EXPECT_EQ(std::strtod(str, nullptr), value) << str;
+        EXPECT_EQ(str + std::strlen(str), p);
+    }
+
+    const char* str = "abc";
+    double value;
+    EXPECT_FALSE(OMVIS::Model::CsvFileReader::parseNumber(str, str + 3, value));
+}
+
+#endif /* TEST_INCLUDE_TESTCSVFILEREADER_HPP_ */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTFMUCACHE_HPP_
+#define TEST_INCLUDE_TESTFMUCACHE_HPP_
+
+#include "Model/FMUCache.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <string>
+
+/*! \brief Class to test the class \ref Model::FMUCache.
+ *
+ * The fake FMUs consist of the file data, the central directory and the end of central directory record of a ZIP
+ * archive.
+ */
+class TestFMUCache : public ::testing::Test
+{
+ public:
+    std::string _directory;
+
+    TestFMUCache()
+            : _directory()
+    {
+    }
+
+    void SetUp()
+    {
+        _directory = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string() + "/";
+        boost::filesystem::create_directories(_directory);
+    }
+
+    void TearDown()
+    {
+        boost::filesystem::remove_all(_directory);
+    }
+
+    std::string writeFile(const std::string& name, const std::string& content)
+    {
+        std::ofstream stream(_directory + name, std::ios::binary);
+        stream << content;
+        return _directory + name;
+    }
+
+    std::string writeFMU(const std::string& name, const std::string& data, const std::string& centralDirectory)
+    {
+        std::string eocd("PK\x05\x06", 4);
+        eocd.append(8, '\0');
+        eocd += toUInt32LE(centralDirectory.size());
+        eocd += toUInt32LE(data.size());
+        eocd.append(2, '\0');
+        return writeFile(name, data + centralDirectory + eocd);
+    }
+
+    std::string toUInt32LE(const size_t value)
+    {
+        std::string bytes;
+        for (int i = 0; i < 4; ++i)
+        {
+            bytes.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+        return bytes;
+    }
+
+    ~TestFMUCache()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that the key depends on the central directory of a ZIP archive and on the whole content of
+ * other files.
+ */
+TEST_F (TestFMUCache, Key)
+{
+    using OMVIS::Model::FMUCache;
+    auto key = FMUCache::computeKey(writeFMU("a.fmu", "compressed files", "crc32 of the files"));
+    ASSERT_EQ(key, FMUCache::computeKey(writeFMU("b.fmu", "compressed files", "crc32 of the files")));
+    ASSERT_NE(key, FMUCache::computeKey(writeFMU("c.fmu", "compressed files", "crc32 of other files")));
+
+    // The file data is covered by the checksums of the central directory.
+    ASSERT_EQ(key, FMUCache::computeKey(writeFMU("d.fmu", "compressed filez", "crc32 of the files")));
+
+    auto noZipKey = FMUCache::computeKey(writeFile("e.fmu", "no zip archive"));
+    ASSERT_NE(noZipKey, FMUCache::computeKey(writeFile("f.fmu", "no zip arcHive")));
+    ASSERT_THROW(FMUCache::computeKey(_directory + "missing.fmu"), std::runtime_error);
+}
+
+/*!
+ * Test fixture to test that only complete entries are found and that the least recently used entries are removed.
+ */
+TEST_F (TestFMUCache, Entries)
+{
+    OMVIS::Model::FMUCache cache(_directory + "cache", 1);
+    OMVIS::Model::FMUManifest manifest;
+    ASSERT_FALSE(cache.lookup(1, manifest));
+
+    std::string path = cache.beginEntry(1);
+    ASSERT_TRUE(boost::filesystem::is_directory(path));
+    ASSERT_FALSE(cache.lookup(1, manifest));
+
+    cache.commitEntry(1, {1, "{guid}", "Model"});
+    ASSERT_TRUE(cache.lookup(1, manifest));
+    ASSERT_EQ(1u, manifest.fmiVersion);
+    ASSERT_EQ("{guid}", manifest.guid);
+    ASSERT_EQ("Model", manifest.modelIdentifier);
+
+    // Only one entry is kept.
+    cache.beginEntry(2);
+    cache.commitEntry(2, {1, "{other guid}", "Other"});
+    ASSERT_EQ(1u, cache.getNumEntries());
+    ASSERT_FALSE(cache.lookup(1, manifest));
+    ASSERT_FALSE(boost::filesystem::exists(path));
+    ASSERT_TRUE(cache.lookup(2, manifest));
+
+    cache.removeEntry(2);
+    ASSERT_EQ(0u, cache.getNumEntries());
+}
+
+#endif /* TEST_INCLUDE_TESTFMUCACHE_HPP_ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTFRAMEHISTORY_HPP_
+#define TEST_INCLUDE_TESTFRAMEHISTORY_HPP_
+
+#include "Model/FrameHistory.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+/*! \brief Class to test the class \ref Model::FrameHistory.
+ *
+ * The frames have three values: a constant, the time and the square of the time.
+ */
+class TestFrameHistory : public ::testing::Test
+{
+ public:
+    TestFrameHistory()
+    {
+    }
+
+    std::vector<double> getValues(const double time) const
+    {
+        return {1.5, time, time * time};
+    }
+
+    ~TestFrameHistory()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that frames are read back with float precision and that frames after a time can be removed.
+ */
+TEST_F (TestFrameHistory, ReadAndTruncate)
+{
+    OMVIS::Model::FrameHistory history(1 << 20, 4);
+    for (int i = 0; i < 10; ++i)
+    {
+        history.push(0.1 * i, getValues(0.1 * i));
+    }
+    ASSERT_EQ(10u, history.getNumFrames());
+
+    std::vector<double> values;
+    ASSERT_DOUBLE_EQ(0.1 * 6, history.read(0.65, values));
+    ASSERT_EQ(3u, values.size());
+    ASSERT_EQ(1.5, values[0]);
+    ASSERT_EQ(static_cast<float>(0.6), values[1]);
+    ASSERT_EQ(static_cast<float>(0.36), values[2]);
+    ASSERT_DOUBLE_EQ(0.0, history.read(-1.0, values));
+    ASSERT_DOUBLE_EQ(0.9, history.read(5.0, values));
+
+    // Resume from time 0.35, the frames after it are replaced.
+    history.truncate(0.35);
+    ASSERT_EQ(4u, history.getNumFrames());
+    history.push(0.4, getValues(2.0));
+    ASSERT_DOUBLE_EQ(0.4, history.read(0.45, values));
+    ASSERT_EQ(2.0f, values[1]);
+    ASSERT_EQ(static_cast<float>(0.3), (history.read(0.35, values), values[1]));
+
+    // Frames at or after the time of a pushed frame are replaced as well.
+    history.push(0.2, getValues(3.0));
+    ASSERT_EQ(3u, history.getNumFrames());
+    ASSERT_EQ(3.0f, (history.read(0.2, values), values[1]));
+}
+
+/*!
+ * Test fixture to test that unchanged values take one byte and that the oldest frames are removed if the history is
+ * full.
+ */
+TEST_F (TestFrameHistory, Bounded)
+{
+    OMVIS::Model::FrameHistory history(200, 8);
+    history.push(0.0, getValues(0.5));
+    const size_t keyFrameBytes = history.getNumBytes();
+    history.push(0.1, getValues(0.5));
+    ASSERT_EQ(keyFrameBytes + 3, history.getNumBytes());
+
+    for (int i = 2; i < 100; ++i)
+    {
+        history.push(0.1 * i, getValues(0.1 * i));
+        ASSERT_LE(history.getNumBytes(), 200u);
+    }
+    ASSERT_LT(history.getNumFrames(), 98u);
+    ASSERT_DOUBLE_EQ(9.9, history.getLastTime());
+
+    // The oldest remaining frame can still be decoded.
+    std::vector<double> values;
+    const double firstTime = history.read(0.0, values);
+    ASSERT_DOUBLE_EQ(history.getFirstTime(), firstTime);
+    ASSERT_EQ(static_cast<float>(firstTime), values[1]);
+    ASSERT_EQ(static_cast<float>(9.9), (history.read(10.0, values), values[1]));
+}
+
+#endif /* TEST_INCLUDE_TESTFRAMEHISTORY_HPP_ */
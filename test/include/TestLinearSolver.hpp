@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTLINEARSOLVER_HPP_
+#define TEST_INCLUDE_TESTLINEARSOLVER_HPP_
+
+#include "Util/LinearSolver.hpp"
+#include <gtest/gtest.h>
+
+/*! \brief Class to test the dense LU solver and the column coloring of \ref Util.
+ *
+ * The matrix is tridiagonal with 4 on the diagonal and 1 on the off-diagonals. Its first row is zero on the diagonal
+ * in order to require pivoting.
+ */
+class TestLinearSolver : public ::testing::Test
+{
+ public:
+    size_t _n;
+    std::vector<double> _matrix;
+
+    TestLinearSolver()
+            : _n(5),
+              _matrix()
+    {
+    }
+
+    void SetUp()
+    {
+        _matrix.assign(_n * _n, 0.0);
+        for (size_t i = 0; i < _n; ++i)
+        {
+            _matrix[i * _n + i] = (0 == i) ? 0.0 : 4.0;
+            if (0 < i)
+            {
+                _matrix[i * _n + i - 1] = 1.0;
+            }
+            if (i + 1 < _n)
+            {
+                _matrix[i * _n + i + 1] = 1.0;
+            }
+        }
+    }
+
+    ~TestLinearSolver()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that the solution of the factorized system reproduces the right hand side.
+ */
+TEST_F (TestLinearSolver, Solve)
+{
+    std::vector<double> x = { 1.0, -2.0, 3.0, 0.5, -1.0 };
+    std::vector<double> b(_n, 0.0);
+    for (size_t i = 0; i < _n; ++i)
+    {
+        for (size_t j = 0; j < _n; ++j)
+        {
+            b[i] += _matrix[i * _n + j] * x[j];
+        }
+    }
+
+    std::vector<double> lu(_matrix);
+    std::vector<size_t> pivots;
+    ASSERT_TRUE(OMVIS::Util::luFactorize(lu, _n, pivots));
+    OMVIS::Util::luSolve(lu, _n, pivots, b.data());
+    for (size_t i = 0; i < _n; ++i)
+    {
+        EXPECT_NEAR(x[i], b[i], 1.e-12);
+    }
+}
+
+/*!
+ * Test fixture to test that a singular matrix is detected.
+ */
+TEST_F (TestLinearSolver, Singular)
+{
+    std::vector<double> lu(_matrix);
+    for (size_t j = 0; j < _n; ++j)
+    {
+        lu[2 * _n + j] = 2.0 * lu[1 * _n + j];
+    }
+    std::vector<size_t> pivots;
+    ASSERT_FALSE(OMVIS::Util::luFactorize(lu, _n, pivots));
+}
+
+/*!
+ * Test fixture to test that columns sharing a row get different colors.
+ */
+TEST_F (TestLinearSolver, ColorColumns)
+{
+    std::vector<bool> pattern(_n * _n);
+    for (size_t i = 0; i < _n * _n; ++i)
+    {
+        pattern[i] = (0.0 != _matrix[i]) || (i / _n == i % _n);
+    }
+    auto colors = OMVIS::Util::colorColumns(pattern, _n);
+    std::vector<size_t> expected = { 0, 1, 2, 0, 1 };
+    ASSERT_EQ(expected, colors);
+
+    // A diagonal matrix needs a single color.
+    std::vector<bool> diagonal(_n * _n, false);
+    for (size_t i = 0; i < _n; ++i)
+    {
+        diagonal[i * _n + i] = true;
+    }
+    colors = OMVIS::Util::colorColumns(diagonal, _n);
+    ASSERT_EQ(std::vector<size_t>(_n, 0), colors);
+}
+
+/*!
+ * Test fixture to test that the Jacobian of a banded function is approximated with one evaluation per color once
+ * the sparsity pattern is known.
+ */
+TEST_F (TestLinearSolver, ApproximateJacobian)
+{
+    // Tridiagonal function f_i = x_{i-1} + x_i^2 + 3 * x_{i+1}.
+    const size_t n = 20;
+    size_t numCalls = 0;
+    auto f = [n, &numCalls](const double* x, double* fx)
+    {
+        ++numCalls;
+        for (size_t i = 0; i < n; ++i)
+        {
+            fx[i] = x[i] * x[i] + ((0 < i) ? x[i - 1] : 0.0) + ((i + 1 < n) ? 3.0 * x[i + 1] : 0.0);
+        }
+    };
+    std::vector<double> x(n), fx(n), jacobian;
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = 0.5 * i;
+    }
+    f(x.data(), fx.data());
+    numCalls = 0;
+
+    // Without a pattern, each column needs an evaluation.
+    ASSERT_EQ(n, OMVIS::Util::approximateJacobian(f, x.data(), fx.data(), n, {}, {}, jacobian));
+    ASSERT_EQ(n, numCalls);
+
+    std::vector<bool> pattern(n * n);
+    for (size_t i = 0; i < n * n; ++i)
+    {
+        pattern[i] = (0.0 != jacobian[i]);
+    }
+    auto colors = OMVIS::Util::colorColumns(pattern, n);
+
+    numCalls = 0;
+    ASSERT_EQ(3u, OMVIS::Util::approximateJacobian(f, x.data(), fx.data(), n, pattern, colors, jacobian));
+    ASSERT_EQ(3u, numCalls);
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            const double expected = (i == j) ? 2.0 * x[i] : ((j + 1 == i) ? 1.0 : ((i + 1 == j) ? 3.0 : 0.0));
+            EXPECT_NEAR(expected, jacobian[i * n + j], 1.0e-6) << i << " " << j;
+        }
+    }
+}
+
+#endif /* TEST_INCLUDE_TESTLINEARSOLVER_HPP_ */
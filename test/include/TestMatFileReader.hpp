@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTMATFILEREADER_HPP_
+#define TEST_INCLUDE_TESTMATFILEREADER_HPP_
+
+#include "Model/MatFileReader.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+/*! \brief Class to test the class \ref Model::MatFileReader.
+ */
+class TestMatFileReader : public ::testing::Test
+{
+ public:
+    OMVIS::Model::MatFileReader _reader;
+
+    TestMatFileReader()
+            : _reader()
+    {
+    }
+
+    void SetUp()
+    {
+        _reader.open("examples/pendulum_res.mat");
+    }
+
+    void TearDown()
+    {
+        _reader.close();
+    }
+
+    ~TestMatFileReader()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that the header matrices of a MAT file are parsed correctly.
+ */
+TEST_F (TestMatFileReader, Open)
+{
+    ASSERT_TRUE(_reader.isOpen());
+    EXPECT_EQ(660, _reader.getNumVariables());
+    EXPECT_EQ(502, _reader.getNumRows());
+    EXPECT_EQ(143, _reader.getParameters().size());
+    EXPECT_DOUBLE_EQ(0.0, _reader.getStartTime());
+    EXPECT_DOUBLE_EQ(10.0, _reader.getStopTime());
+    EXPECT_EQ(nullptr, _reader.findVariable("notAVariable"));
+}
+
+/*!
+ * Test fixture to test that variables and parameters are found and their values are read.
+ */
+TEST_F (TestMatFileReader, Values)
+{
+    auto var = _reader.findVariable("time");
+    ASSERT_TRUE(nullptr != var);
+    EXPECT_FALSE(var->isParam);
+    EXPECT_EQ(1, var->index);
+    auto& time = _reader.getColumn(0);
+    EXPECT_DOUBLE_EQ(_reader.getStartTime(), time.front());
+    EXPECT_DOUBLE_EQ(_reader.getStopTime(), time.back());
+
+    var = _reader.findVariable("revolute.phi");
+    ASSERT_TRUE(nullptr != var);
+    auto& phi = _reader.getColumn(std::abs(var->index) - 1);
+    std::vector<float> phiRange(10);
+    _reader.readColumn(std::abs(var->index) - 1, 100, 10, phiRange.data());
+    EXPECT_FLOAT_EQ(phi[105], phiRange[5]);
+
+    var = _reader.findVariable("world.axisDiameter");
+    ASSERT_TRUE(nullptr != var);
+    EXPECT_TRUE(var->isParam);
+    EXPECT_DOUBLE_EQ(0.0125, _reader.getParameters()[std::abs(var->index) - 1]);
+}
+
+/*!
+ * Test fixture to test that rows appended to a MAT file that is still being written are picked up by a refresh.
+ */
+TEST_F (TestMatFileReader, Refresh)
+{
+    std::ifstream in("examples/pendulum_res.mat", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+
+    // Write the first three quarters of the file.
+    std::ofstream out(fileName, std::ios::binary);
+    out.write(content.data(), 3 * content.size() / 4);
+    out.flush();
+
+    OMVIS::Model::MatFileReader reader;
+    reader.open(fileName);
+    auto numRows = reader.getNumRows();
+    EXPECT_LT(0, numRows);
+    EXPECT_GT(502, numRows);
+    EXPECT_FALSE(reader.isComplete());
+
+    // Append the rest.
+    out.write(content.data() + 3 * content.size() / 4, content.size() - 3 * content.size() / 4);
+    out.close();
+    EXPECT_EQ(502, reader.refresh());
+    EXPECT_TRUE(reader.isComplete());
+    EXPECT_DOUBLE_EQ(10.0, reader.getStopTime());
+    EXPECT_DOUBLE_EQ(_reader.getColumn(1)[501], reader.getColumn(1)[501]);
+
+    reader.close();
+    boost::filesystem::remove(fileName);
+}
+
+/*!
+ * Test fixture to test that a MAT file truncated before data_2 is rejected instead of read beyond its end.
+ */
+TEST_F (TestMatFileReader, Truncated)
+{
+    std::ifstream in("examples/pendulum_res.mat", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+
+    // Cut the file inside of Aclass, name, description, dataInfo, data_1 and the header of data_2.
+    for (size_t size : { 30u, 200u, 60000u, 210000u, 220000u, 221740u })
+    {
+        std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), size);
+        out.close();
+
+        OMVIS::Model::MatFileReader reader;
+        EXPECT_THROW(reader.open(fileName), std::runtime_error) << size;
+        EXPECT_FALSE(reader.isOpen());
+    }
+    boost::filesystem::remove(fileName);
+}
+
+#endif /* TEST_INCLUDE_TESTMATFILEREADER_HPP_ */
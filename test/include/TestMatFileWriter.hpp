@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTMATFILEWRITER_HPP_
+#define TEST_INCLUDE_TESTMATFILEWRITER_HPP_
+
+#include "Model/MatFileWriter.hpp"
+#include "Model/MatFileReader.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <thread>
+
+/*! \brief Class to test the class \ref Model::MatFileWriter.
+ *
+ * The file has the variables time, x and y with x = 2 * time and y = -time.
+ */
+class TestMatFileWriter : public ::testing::Test
+{
+ public:
+    std::string _fileName;
+
+    TestMatFileWriter()
+            : _fileName()
+    {
+    }
+
+    void SetUp()
+    {
+        _fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%_res.mat"))
+                .string();
+    }
+
+    void TearDown()
+    {
+        boost::filesystem::remove(_fileName);
+    }
+
+    void writeRows(OMVIS::Model::MatFileWriter& writer, const int first, const int last)
+    {
+        for (int i = first; i < last; ++i)
+        {
+            double row[3] = {0.1 * i, 0.2 * i, -0.1 * i};
+            ASSERT_TRUE(writer.writeRow(row));
+        }
+    }
+
+    ~TestMatFileWriter()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that a closed file is a complete result file.
+ */
+TEST_F (TestMatFileWriter, Complete)
+{
+    OMVIS::Model::MatFileWriter writer;
+    writer.open(_fileName, {"time", "x", "y"}, 4, 8);
+    writeRows(writer, 0, 10);
+    writer.close();
+    ASSERT_FALSE(writer.isOpen());
+    ASSERT_EQ(10u, writer.getNumRows());
+
+    OMVIS::Model::MatFileReader reader;
+    reader.open(_fileName);
+    ASSERT_TRUE(reader.isComplete());
+    ASSERT_EQ(3u, reader.getNumVariables());
+    ASSERT_EQ(10u, reader.getNumRows());
+    ASSERT_DOUBLE_EQ(0.0, reader.getStartTime());
+    ASSERT_DOUBLE_EQ(0.9, reader.getStopTime());
+
+    auto y = reader.findVariable("y");
+    ASSERT_NE(nullptr, y);
+    ASSERT_FALSE(y->isParam);
+    ASSERT_EQ(3, y->index);
+    ASSERT_DOUBLE_EQ(-0.7, reader.getColumn(y->index - 1)[7]);
+    ASSERT_DOUBLE_EQ(1.6, reader.getColumn(1)[8]);
+}
+
+/*!
+ * Test fixture to test that the file can be read while it is written and that rows are dropped if all blocks are
+ * pending.
+ */
+TEST_F (TestMatFileWriter, Streaming)
+{
+    OMVIS::Model::MatFileWriter writer;
+    writer.open(_fileName, {"time", "x", "y"}, 2, 2);
+    writeRows(writer, 0, 4);
+
+    OMVIS::Model::MatFileReader reader;
+    for (int i = 0; i < 100 && !(reader.isOpen() && 4 == reader.getNumRows()); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        try
+        {
+            reader.open(_fileName);
+        }
+        catch (std::exception&)
+        {
+        }
+    }
+    ASSERT_TRUE(reader.isOpen());
+    ASSERT_FALSE(reader.isComplete());
+    ASSERT_EQ(4u, reader.getNumRows());
+    ASSERT_DOUBLE_EQ(0.3, reader.getStopTime());
+
+    // Without a free block the rows are dropped.
+    size_t numDropped = 0;
+    for (int i = 4; i < 1000; ++i)
+    {
+        double row[3] = {0.1 * i, 0.2 * i, -0.1 * i};
+        numDropped += writer.writeRow(row) ? 0 : 1;
+    }
+    writer.close();
+    ASSERT_EQ(numDropped, writer.getNumDroppedRows());
+    ASSERT_EQ(1000u, writer.getNumRows() + writer.getNumDroppedRows());
+
+    reader.open(_fileName);
+    ASSERT_TRUE(reader.isComplete());
+    ASSERT_EQ(writer.getNumRows(), reader.getNumRows());
+}
+
+#endif /* TEST_INCLUDE_TESTMATFILEWRITER_HPP_ */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTPACINGGOVERNOR_HPP_
+#define TEST_INCLUDE_TESTPACINGGOVERNOR_HPP_
+
+#include "Control/PacingGovernor.hpp"
+#include <gtest/gtest.h>
+
+/*! \brief Class to test the class \ref Control::PacingGovernor.
+ *
+ * The governor is anchored at simulation time 1 and wall clock time 10. The frame interval is 0.1.
+ */
+class TestPacingGovernor : public ::testing::Test
+{
+ public:
+    OMVIS::Control::PacingGovernor _governor;
+    double _frameInterval;
+
+    TestPacingGovernor()
+            : _governor(),
+              _frameInterval(0.1)
+    {
+    }
+
+    void SetUp()
+    {
+        _governor.reset(1.0, 10.0);
+    }
+
+    ~TestPacingGovernor()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that the frames follow the wall clock times the target real-time factor.
+ */
+TEST_F (TestPacingGovernor, RealTimeFactor)
+{
+    ASSERT_NEAR(1.2, _governor.planFrame(1.0, 10.1, _frameInterval), 1.0e-12);
+
+    // The previous frame is not yet due.
+    ASSERT_NEAR(1.2, _governor.planFrame(1.2, 10.15, _frameInterval), 1.0e-12);
+
+    _governor.setTargetRealTimeFactor(0.5);
+    _governor.reset(1.2, 10.2);
+    ASSERT_NEAR(1.25, _governor.planFrame(1.2, 10.2, _frameInterval), 1.0e-12);
+    ASSERT_NEAR(0.0, _governor.getLag(), 1.0e-12);
+
+    _governor.setTargetRealTimeFactor(4.0);
+    _governor.reset(1.25, 10.3);
+    ASSERT_NEAR(1.65, _governor.planFrame(1.25, 10.3, _frameInterval), 1.0e-12);
+    ASSERT_EQ(0u, _governor.getNumDroppedFrames());
+}
+
+/*!
+ * Test fixture to test that the frames are limited by the costs of the solver and that frames are dropped as soon as
+ * the lag exceeds the maximum lag.
+ */
+TEST_F (TestPacingGovernor, Lag)
+{
+    // The solver needs 2 seconds of wall clock time per simulated second.
+    _governor.finishFrame(0.1, 0.2);
+    ASSERT_NEAR(2.0, _governor.getCost(), 1.0e-12);
+
+    ASSERT_NEAR(1.05, _governor.planFrame(1.0, 10.0, _frameInterval), 1.0e-12);
+    ASSERT_NEAR(1.1, _governor.planFrame(1.05, 10.3, _frameInterval), 1.0e-12);
+    ASSERT_NEAR(0.25, _governor.getLag(), 1.0e-12);
+    ASSERT_EQ(0u, _governor.getNumDroppedFrames());
+
+    // The lag of 0.95 exceeds the maximum lag, thus, the governor is anchored again. The lag is still reported.
+    ASSERT_NEAR(1.15, _governor.planFrame(1.1, 11.05, _frameInterval), 1.0e-12);
+    ASSERT_EQ(9u, _governor.getNumDroppedFrames());
+    ASSERT_NEAR(0.95, _governor.getLag(), 1.0e-12);
+    ASSERT_NEAR(1.1, _governor.getDueSimTime(11.05), 1.0e-12);
+
+    // On time again after the anchoring.
+    _governor.planFrame(1.15, 11.1, _frameInterval);
+    ASSERT_NEAR(0.0, _governor.getLag(), 1.0e-12);
+}
+
+#endif /* TEST_INCLUDE_TESTPACINGGOVERNOR_HPP_ */
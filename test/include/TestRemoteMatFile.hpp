@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTREMOTEMATFILE_HPP_
+#define TEST_INCLUDE_TESTREMOTEMATFILE_HPP_
+
+#include "Model/MatFileReader.hpp"
+#include "Model/MatFileServer.hpp"
+#include "Model/RemoteMatFile.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/*! \brief Class to test the classes \ref Model::RemoteMatFile and \ref Model::MatFileServer.
+ */
+class TestRemoteMatFile : public ::testing::Test
+{
+ public:
+    OMVIS::Model::MatFileServer _server;
+    std::thread _serverThread;
+    OMVIS::Model::RemoteMatFile _remoteFile;
+
+    TestRemoteMatFile()
+            : _server("examples", 0),
+              _serverThread(),
+              _remoteFile()
+    {
+    }
+
+    void SetUp()
+    {
+        _serverThread = std::thread([this]() {_server.run();});
+    }
+
+    void TearDown()
+    {
+        // The server stops after the client disconnected.
+        _remoteFile.close();
+        _server.stop();
+        _serverThread.join();
+    }
+
+    ~TestRemoteMatFile()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that a remote file provides the same variables and values as the local file.
+ */
+TEST_F (TestRemoteMatFile, Read)
+{
+    OMVIS::Model::MatFileReader reader;
+    reader.open("examples/pendulum_res.mat");
+    _remoteFile.open("localhost", _server.getPort(), "pendulum_res.mat");
+    ASSERT_TRUE(_remoteFile.isOpen());
+    EXPECT_EQ(502, _remoteFile.getNumRows());
+    EXPECT_EQ(143, _remoteFile.getParameters().size());
+    EXPECT_DOUBLE_EQ(10.0, _remoteFile.getTimes().back());
+    EXPECT_EQ(nullptr, _remoteFile.findVariable("notAVariable"));
+
+    auto var = _remoteFile.findVariable("revolute.phi");
+    ASSERT_TRUE(nullptr != var);
+    EXPECT_EQ(reader.findVariable("revolute.phi")->index, var->index);
+    EXPECT_EQ(250, _remoteFile.findRow(_remoteFile.getTimes()[250]));
+
+    // Read a window of two columns.
+    std::vector<size_t> columns = {0, static_cast<size_t>(std::abs(var->index) - 1)};
+    std::vector<float> time(100), phi(100);
+    _remoteFile.readRows(columns, 200, 100, {time.data(), phi.data()});
+    const auto& expected = reader.getColumn(columns[1]);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        EXPECT_FLOAT_EQ(static_cast<float>(_remoteFile.getTimes()[200 + i]), time[i]);
+        EXPECT_FLOAT_EQ(static_cast<float>(expected[200 + i]), phi[i]);
+    }
+}
+
+/*!
+ * Test fixture to test that invalid requests are refused and the connection stays usable.
+ */
+TEST_F (TestRemoteMatFile, Refused)
+{
+    EXPECT_THROW(_remoteFile.open("localhost", _server.getPort(), "../CMakeLists.txt"), std::runtime_error);
+    EXPECT_FALSE(_remoteFile.isOpen());
+
+    _remoteFile.open("localhost", _server.getPort(), "pendulum_res.mat");
+    std::vector<float> values(10);
+    EXPECT_THROW(_remoteFile.readRows({0}, 500, 10, {values.data()}), std::runtime_error);
+    EXPECT_THROW(_remoteFile.readRows({100000}, 0, 10, {values.data()}), std::runtime_error);
+    _remoteFile.readRows({0}, 0, 10, {values.data()});
+    EXPECT_FLOAT_EQ(0.0f, values[0]);
+}
+
+#endif /* TEST_INCLUDE_TESTREMOTEMATFILE_HPP_ */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTRESULTTIMELINE_HPP_
+#define TEST_INCLUDE_TESTRESULTTIMELINE_HPP_
+
+#include "Model/ResultTimeline.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+/*! \brief Class to test the class \ref Model::ResultTimeline.
+ *
+ * The timeline has one time dependent column with value 10 * time and one constant column. The time point 1.0 is
+ * stored twice, i.e., there is an event at time 1.0 where the first column jumps by 100.
+ */
+class TestResultTimeline : public ::testing::Test
+{
+ public:
+    OMVIS::Model::ResultTimeline _timeline;
+    OMVIS::Model::TimelineFrame _frame;
+    OMVIS::Model::TimelineCursor _cursor;
+
+    TestResultTimeline()
+            : _timeline(),
+              _frame(),
+              _cursor()
+    {
+    }
+
+    void SetUp()
+    {
+        std::vector<double> times = { 0.0, 0.5, 1.0, 1.0, 1.5, 2.0 };
+        _timeline.allocate(times.size(), { false, true });
+        for (size_t i = 0; i < times.size(); ++i)
+        {
+            _timeline.getTimes()[i] = times[i];
+            _timeline.getColumn(0)[i] = 10.0 * times[i] + ((2 < i) ? 100.0 : 0.0);
+        }
+        _timeline.getColumn(1)[0] = 7.0;
+        _timeline.initFrame(_frame);
+    }
+
+    void TearDown()
+    {
+    }
+
+    ~TestResultTimeline()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test the layout of the timeline.
+ */
+TEST_F (TestResultTimeline, Layout)
+{
+    EXPECT_EQ(2, _timeline.getNumColumns());
+    EXPECT_EQ(6, _timeline.getNumRows());
+    EXPECT_FALSE(_timeline.isConstColumn(0));
+    EXPECT_TRUE(_timeline.isConstColumn(1));
+    EXPECT_EQ(0.0, _timeline.getStartTime());
+    EXPECT_EQ(2.0, _timeline.getStopTime());
+    EXPECT_EQ(2, _frame.values.size());
+}
+
+/*!
+ * Test fixture to test the interpolation including clamping and events.
+ */
+TEST_F (TestResultTimeline, Interpolate)
+{
+    _timeline.interpolate(0.25, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(2.5, _frame.values[0]);
+    EXPECT_DOUBLE_EQ(7.0, _frame.values[1]);
+
+    // The value after the event is used at the event time.
+    _timeline.interpolate(1.0, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(110.0, _frame.values[0]);
+
+    _timeline.interpolate(1.25, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(112.5, _frame.values[0]);
+
+    // Times outside of the timeline are clamped.
+    _timeline.interpolate(-1.0, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(0.0, _frame.values[0]);
+    _timeline.interpolate(5.0, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(120.0, _frame.values[0]);
+}
+
+/*!
+ * Test fixture to test that the cursor gives the same results as a binary search in both directions.
+ */
+TEST_F (TestResultTimeline, Cursor)
+{
+    OMVIS::Model::TimelineFrame reference;
+    _timeline.initFrame(reference);
+    for (double time = -0.1; time < 2.2; time += 0.05)
+    {
+        OMVIS::Model::TimelineCursor binarySearch;
+        _timeline.interpolate(time, reference, binarySearch);
+        _timeline.interpolate(time, _frame, _cursor);
+        EXPECT_DOUBLE_EQ(reference.values[0], _frame.values[0]);
+        EXPECT_TRUE(_cursor.isValid);
+    }
+    for (double time = 2.2; time > -0.1; time -= 0.05)
+    {
+        OMVIS::Model::TimelineCursor binarySearch;
+        _timeline.interpolate(time, reference, binarySearch);
+        _timeline.interpolate(time, _frame, _cursor);
+        EXPECT_DOUBLE_EQ(reference.values[0], _frame.values[0]);
+    }
+
+    _cursor.reset();
+    EXPECT_FALSE(_cursor.isValid);
+}
+
+/*!
+ * Test fixture to test that resizing keeps the values and appended time points can be interpolated.
+ */
+TEST_F (TestResultTimeline, Resize)
+{
+    _timeline.resize(100);
+    EXPECT_EQ(100, _timeline.getNumRows());
+    EXPECT_EQ(2.0, _timeline.getTimes()[5]);
+    EXPECT_FLOAT_EQ(120.0f, _timeline.getColumn(0)[5]);
+    EXPECT_FLOAT_EQ(7.0f, _timeline.getColumn(1)[0]);
+
+    _timeline.resize(7);
+    _timeline.getTimes()[6] = 3.0;
+    _timeline.getColumn(0)[6] = 130.0f;
+    EXPECT_EQ(3.0, _timeline.getStopTime());
+    _timeline.interpolate(2.5, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(125.0, _frame.values[0]);
+    EXPECT_DOUBLE_EQ(7.0, _frame.values[1]);
+}
+
+/*!
+ * Test fixture to test that the decimation keeps only the bounds of linear segments and both rows of events.
+ */
+TEST_F (TestResultTimeline, DecimateLinear)
+{
+    EXPECT_EQ(4, _timeline.decimate(1.0e-3));
+    EXPECT_EQ(2, _timeline.getNumColumns());
+    EXPECT_EQ(1.0, _timeline.getTimes()[1]);
+    EXPECT_EQ(1.0, _timeline.getTimes()[2]);
+    EXPECT_EQ(2.0, _timeline.getStopTime());
+
+    _timeline.interpolate(0.25, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(2.5, _frame.values[0]);
+    EXPECT_DOUBLE_EQ(7.0, _frame.values[1]);
+    _timeline.interpolate(1.0, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(110.0, _frame.values[0]);
+    _timeline.interpolate(1.25, _frame, _cursor);
+    EXPECT_DOUBLE_EQ(112.5, _frame.values[0]);
+}
+
+/*!
+ * Test fixture to test that the decimated timeline reproduces all removed values within the tolerance.
+ */
+TEST_F (TestResultTimeline, DecimateTolerance)
+{
+    const size_t numRows = 10000;
+    const double tolerance = 1.0e-3;
+    OMVIS::Model::ResultTimeline timeline;
+    timeline.allocate(numRows, { false, false, true });
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        double time = 0.001 * i;
+        timeline.getTimes()[i] = time;
+        timeline.getColumn(0)[i] = std::sin(time);
+        timeline.getColumn(1)[i] = (time < 5.0) ? time : 10.0 - time;
+    }
+    timeline.getColumn(2)[0] = 3.0;
+
+    OMVIS::Model::ResultTimeline reference;
+    reference.allocate(numRows, { false, false, true });
+    std::copy(timeline.getTimes(), timeline.getTimes() + numRows, reference.getTimes());
+    std::copy(timeline.getColumn(0), timeline.getColumn(0) + 2 * numRows + 1, reference.getColumn(0));
+
+    EXPECT_GT(numRows / 10, timeline.decimate(tolerance));
+    timeline.initFrame(_frame);
+    for (size_t i = 0; i < numRows; ++i)
+    {
+        timeline.interpolate(reference.getTimes()[i], _frame, _cursor);
+        EXPECT_NEAR(reference.getColumn(0)[i], _frame.values[0], tolerance + 1.0e-6);
+        EXPECT_NEAR(reference.getColumn(1)[i], _frame.values[1], tolerance + 1.0e-6);
+        EXPECT_DOUBLE_EQ(3.0, _frame.values[2]);
+    }
+}
+
+#endif /* TEST_INCLUDE_TESTRESULTTIMELINE_HPP_ */
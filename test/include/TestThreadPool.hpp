@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTTHREADPOOL_HPP_
+#define TEST_INCLUDE_TESTTHREADPOOL_HPP_
+
+#include "Util/ThreadPool.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+/*! \brief Class to test the class \ref Util::ThreadPool with three worker threads. */
+class TestThreadPool : public ::testing::Test
+{
+ public:
+    OMVIS::Util::ThreadPool _pool;
+
+    TestThreadPool()
+            : _pool(3)
+    {
+    }
+
+    ~TestThreadPool()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that each task of consecutive loops is processed exactly once.
+ */
+TEST_F (TestThreadPool, ParallelFor)
+{
+    ASSERT_EQ(3u, _pool.getNumWorkers());
+
+    for (size_t numTasks = 0; numTasks < 20; ++numTasks)
+    {
+        std::vector<std::atomic<int>> counts(numTasks);
+        for (auto& count : counts)
+        {
+            count = 0;
+        }
+        _pool.parallelFor(numTasks, [&counts](size_t i)
+        {
+            ++counts[i];
+        });
+        for (auto& count : counts)
+        {
+            ASSERT_EQ(1, count.load());
+        }
+    }
+}
+
+/*!
+ * Test fixture to test that an exception of a task is rethrown after the remaining tasks are done.
+ */
+TEST_F (TestThreadPool, Exception)
+{
+    std::atomic<int> numTasks(0);
+    ASSERT_THROW(_pool.parallelFor(8, [&numTasks](size_t i)
+    {
+        ++numTasks;
+        if (3 == i)
+        {
+            throw std::runtime_error("Task failed.");
+        }
+    }), std::runtime_error);
+    ASSERT_EQ(8, numTasks.load());
+
+    // The pool is still usable, also without workers.
+    OMVIS::Util::ThreadPool serialPool(0);
+    numTasks = 0;
+    serialPool.parallelFor(5, [&numTasks](size_t)
+    {
+        ++numTasks;
+    });
+    ASSERT_EQ(5, numTasks.load());
+}
+
+#endif /* TEST_INCLUDE_TESTTHREADPOOL_HPP_ */
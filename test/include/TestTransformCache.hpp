@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2016, Volker Waurich
+ *
+ * This file is part of OMVIS.
+ *
+ * OMVIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OMVIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OMVIS.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_INCLUDE_TESTTRANSFORMCACHE_HPP_
+#define TEST_INCLUDE_TESTTRANSFORMCACHE_HPP_
+
+#include "Model/TransformCache.hpp"
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+
+/*! \brief Class to test the class \ref Model::TransformCache.
+ *
+ * A cache file with two shapes and three time points is written to the temporary directory. The time point 1.0 is
+ * stored twice, i.e., there is an event at time 1.0.
+ */
+class TestTransformCache : public ::testing::Test
+{
+ public:
+    std::string _fileName;
+    std::vector<double> _times;
+
+    TestTransformCache()
+            : _fileName(),
+              _times()
+    {
+    }
+
+    void SetUp()
+    {
+        _fileName = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+        _times = { 0.0, 1.0, 1.0, 2.0 };
+
+        OMVIS::Model::TransformCache cache;
+        std::vector<OMVIS::Model::BakedShape> shapes(2);
+        cache.beginWrite(_fileName, 42, shapes.size(), _times);
+        for (size_t i = 0; i < _times.size(); ++i)
+        {
+            for (size_t j = 0; j < shapes.size(); ++j)
+            {
+                std::fill(shapes[j].mat, shapes[j].mat + 16, 0.0);
+                shapes[j].mat[15] = 10.0 * i + j;
+                shapes[j].length = static_cast<float>(i);
+            }
+            cache.writeFrame(shapes.data());
+        }
+        cache.endWrite();
+    }
+
+    void TearDown()
+    {
+        boost::filesystem::remove(_fileName);
+    }
+
+    ~TestTransformCache()
+    {
+    }
+};
+
+/*!
+ * Test fixture to test that a written cache file can be read again.
+ */
+TEST_F (TestTransformCache, Read)
+{
+    OMVIS::Model::TransformCache cache;
+    ASSERT_TRUE(cache.open(_fileName, 42, 2));
+    EXPECT_EQ(4, cache.getNumFrames());
+    EXPECT_EQ(2, cache.getNumShapes());
+    EXPECT_EQ(0.0, cache.getStartTime());
+    EXPECT_EQ(2.0, cache.getStopTime());
+    EXPECT_EQ(31.0, cache.getFrame(3)[1].mat[15]);
+    EXPECT_EQ(3.0f, cache.getFrame(3)[0].length);
+
+    // The frame after the event is used at the event time. Times outside of the cache are clamped.
+    EXPECT_EQ(0, cache.findFrame(-1.0));
+    EXPECT_EQ(0, cache.findFrame(0.5));
+    EXPECT_EQ(2, cache.findFrame(1.0));
+    EXPECT_EQ(3, cache.findFrame(5.0));
+}
+
+/*!
+ * Test fixture to test that stale cache files are rejected.
+ */
+TEST_F (TestTransformCache, Stale)
+{
+    OMVIS::Model::TransformCache cache;
+    EXPECT_FALSE(cache.open(_fileName, 43, 2));
+    EXPECT_FALSE(cache.open(_fileName, 42, 3));
+    EXPECT_FALSE(cache.open(_fileName + ".missing", 42, 2));
+    EXPECT_FALSE(cache.isOpen());
+
+    // The key changes with the visual XML file.
+    auto key = OMVIS::Model::TransformCache::computeKey("examples/pendulum_res.mat", "examples/pendulum_visual.xml");
+    EXPECT_EQ(key,
+              OMVIS::Model::TransformCache::computeKey("examples/pendulum_res.mat", "examples/pendulum_visual.xml"));
+    EXPECT_NE(key, OMVIS::Model::TransformCache::computeKey("examples/pendulum_res.mat",
+                                                            "examples/shallowWater.test_visual.xml"));
+}
+
+#endif /* TEST_INCLUDE_TESTTRANSFORMCACHE_HPP_ */
@@ -9,6 +9,7 @@
 #define TEST_INCLUDE_TESTVISUALIZATIONCONSTRUCTIONPLANS_HPP_
 
 #include "Initialization/VisualizationConstructionPlans.hpp"
+#include "Util/Util.hpp"
 
 #include <gtest/gtest.h>
 
@@ -117,6 +118,16 @@ TEST (TestVisualizationConstructionPlans, ConstructVisualizationConstructionPlan
     EXPECT_EQ("BouncingBall.fmu", cP.modelFile);
 }
 
+/*!
+ * Test the constructor of \ref OMVIS::Initialization::VisualizationConstructionPlan for CSV result files.
+ */
+TEST (TestVisualizationConstructionPlans, ConstructVisualizationConstructionPlanCSV)
+{
+    OMVIS::Initialization::VisualizationConstructionPlan cP("BouncingBall_res.csv", "/home/");
+    EXPECT_EQ(OMVIS::Model::VisType::CSV, cP.visType);
+    EXPECT_EQ("/home/BouncingBall_visual.xml", OMVIS::Util::getXMLFileName(cP.modelFile, cP.path));
+}
+
 /*!
  * Test the constructor of \ref OMVIS::Initialization::RemoteVisualizationConstructionPlan.
  */